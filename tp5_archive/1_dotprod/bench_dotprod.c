@@ -0,0 +1,756 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "dotprod.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+#include "norms.h"
+#include "thread_pool.h"
+#include "partition.h"
+#include "reduce.h"
+#include "simd_dot.h"
+#include "alloc.h"
+#include "prefetch.h"
+#include "args.h"
+#include "baseline.h"
+#include "timer.h"
+
+// Valeurs par défaut du balayage (toutes modifiables en ligne de commande)
+#define MIN_N (1 << 10)          // 16 Ko de données : L1
+#define MAX_N (1 << 24)          // 256 Mo de données : DRAM
+#define STEP_N 4                 // Facteur entre deux tailles
+#define PAIRS_MAX_N (1 << 16)    // `dotprod_pairs` (une tâche par élément) au-delà est inutilement long
+#define REPS 10                  // Répétitions mesurées
+#define WARMUP 2                 // Répétitions de chauffe (non mesurées)
+#define INNER_ELEMS (1 << 20)    // Éléments traités par répétition au minimum (petites tailles)
+#define MAX_LIST 32              // Taille maximale des listes d'options
+#define MAX_DROP 10.0            // Baisse de débit tolérée par rapport à la référence (%)
+#define SEED 42                  // Graine des données et des tailles aléatoires
+#define PERF_HITM 0x04d2         // Intel MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM (XSNP_FWD depuis Ice Lake)
+#define BATCH_COUNT 64           // Paires du lot de `dotprod_batch`
+#define ALL_KERNELS "ref,pairs,blocks,frobenius,max,norms,batch,sparse,csr"
+
+// ======================== STRUCTURES DU BANC D'ESSAI ============================
+
+/**
+ * Résultat d'une mesure (une ligne du fichier CSV / un objet JSON).
+ */
+typedef struct {
+    const char *kernel;    // Noyau mesuré (voir ALL_KERNELS)
+    size_t n;              // Taille des vecteurs
+    size_t threads;        // Nombre de threads du pool
+    size_t k;              // Taille de bloc (0 : automatique, sans objet pour ref/pairs)
+    size_t prefetch;       // Distance de préchargement logiciel en octets (blocks uniquement)
+    const char *reduce;    // Mode de réduction (`-` pour les noyaux qui n'en dépendent pas)
+    size_t reps;           // Répétitions mesurées
+    size_t inner;          // Appels par répétition
+    double min_s;          // Temps minimal d'un appel (s)
+    double median_s;       // Temps médian d'un appel (s)
+    double gbs;            // Débit mémoire au temps minimal (Go/s)
+    double gflops;         // Débit de calcul au temps minimal (Gflop/s)
+    double stream_gbs;     // Plafond de bande passante STREAM (triad) pour cette taille
+    double rel_err;        // Écart relatif au résultat de référence
+    double err_ulps;       // Écart à la référence en unités de DBL_EPSILON * somme des valeurs absolues des termes
+    double perf_per_call;  // Compteur matériel par appel (option `--perf`)
+} bench_result_t;
+
+/**
+ * Tâche de la mesure STREAM : triad a[i] = b[i] + s * c[i] sur un bloc.
+ */
+typedef struct {
+    size_t start;          // Début du bloc
+    size_t end;            // Fin du bloc
+    double *a, *b, *c;     // Tableaux de la triad
+} TriadData;
+
+/**
+ * Données d'une taille mesurée : les vecteurs, et leurs formes pour les autres noyaux.
+ * Les noyaux de normes lisent `a` comme une matrice `rows` x `cols` presque carrée ; les
+ * noyaux creux lisent `sparse`, copie de `a` dont seuls le premier quart et un élément
+ * sur dix ensuite sont non nuls (éléments stockés répartis irrégulièrement).
+ */
+typedef struct {
+    double *a, *b;         // Vecteurs
+    size_t n;              // Taille des vecteurs
+    size_t rows, cols;     // Forme de la matrice lue dans `a` (rows * cols <= n)
+    double *sparse;        // `a` creusé (vecteur dense de n éléments)
+    sparse_vec_t vec;      // Éléments non nuls de `sparse`
+    csr_t csr;             // Éléments non nuls des `rows * cols` premiers éléments de `sparse`
+    double *batch_a[BATCH_COUNT], *batch_b[BATCH_COUNT]; // Paires du lot, contiguës dans a et b
+    size_t batch_n[BATCH_COUNT];                         // Longueurs des paires
+    double batch_out[BATCH_COUNT];                       // Résultats des paires
+    size_t batch_count;    // Nombre de paires (au plus BATCH_COUNT et n)
+} bench_data_t;
+
+/**
+ * Appel à mesurer : noyau, taille de bloc, données et valeur attendue.
+ */
+typedef struct {
+    const char *kernel;    // Noyau (voir ALL_KERNELS)
+    size_t k;              // Taille de bloc (`dotprod_blocks` uniquement)
+    size_t prefetch;       // Distance de préchargement (`dotprod_blocks` uniquement)
+    reduce_mode_t reduce;  // Mode de réduction (pairs, blocks, frobenius et max)
+    bool by_mode;          // Le noyau dépend du mode de réduction
+    bench_data_t *data;    // Données de la taille mesurée
+    double ref;            // Valeur de référence (calcul séquentiel)
+    double scale;          // Somme des valeurs absolues des termes (échelle de l'erreur)
+    double bytes;          // Octets lus par appel
+    double flops;          // Opérations flottantes par appel
+} call_t;
+
+// ======================= COMPTEURS MATÉRIELS ====================================
+
+static int perf_fd = -1;          // Compteur ouvert par `--perf` (-1 : aucun)
+
+/**
+ * Ouvrir le compteur `name` pour le processus : `hitm` (lectures servies par une ligne
+ * modifiée dans le cache d'un autre cœur, signe du faux partage sur Intel), `cache-misses`,
+ * `stalls` (cycles d'attente du back-end, surtout la mémoire), `dtlb-misses` (défauts de
+ * TLB en lecture, réduits par les grandes pages), ou un événement brut en hexadécimal
+ * (`0x...`). Le compteur est hérité par les threads créés ensuite : il doit être ouvert
+ * avant la création du pool.
+ */
+static int perf_open(const char *name) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    if (strcmp(name, "hitm") == 0) {
+        attr.type = PERF_TYPE_RAW;
+        attr.config = PERF_HITM;
+    } else if (strcmp(name, "cache-misses") == 0) {
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    } else if (strcmp(name, "stalls") == 0) {
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_STALLED_CYCLES_BACKEND;
+    } else if (strcmp(name, "dtlb-misses") == 0) {
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    } else {
+        attr.type = PERF_TYPE_RAW;
+        attr.config = strtoull(name, NULL, 16);
+    }
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_start(void) {
+    if (perf_fd >= 0) {
+        ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/**
+ * Arrêter le compteur et retourner sa valeur (somme sur tous les threads).
+ */
+static double perf_stop(void) {
+    unsigned long long count = 0;
+    if (perf_fd >= 0) {
+        ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) {
+            count = 0;
+        }
+    }
+    return (double)count;
+}
+
+// =========================== MESURES ============================================
+
+/**
+ * Fonction exécutée par chaque thread pour la triad STREAM d'un bloc.
+ */
+void* triad_block(void *arg) {
+    TriadData *data = (TriadData *)arg;
+    const double s = 3.0;
+    for (size_t i = data->start; i < data->end; ++i) {
+        data->a[i] = data->b[i] + s * data->c[i];
+    }
+    return NULL;
+}
+
+/**
+ * Bande passante STREAM (triad, 24 octets par élément comme STREAM) sur `n` éléments,
+ * avec le pool courant. Meilleur débit sur `reps` répétitions.
+ */
+static double stream_triad(size_t n, size_t reps) {
+    double *a = alloc_array(n, sizeof(double));
+    double *b = alloc_array(n, sizeof(double));
+    double *c = alloc_array(n, sizeof(double));
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = 0.;
+        b[i] = 1.;
+        c[i] = 2.;
+    }
+
+    size_t nb_chunks = partition_count(n, 0, pool_size(pool_global()), 3 * sizeof(double));
+    TriadData *tasks = alloc_array(nb_chunks, sizeof(TriadData));
+    for (size_t i = 0; i < nb_chunks; ++i) {
+        partition_bounds(n, nb_chunks, i, &tasks[i].start, &tasks[i].end);
+        tasks[i].a = a;
+        tasks[i].b = b;
+        tasks[i].c = c;
+    }
+
+    size_t inner = n < INNER_ELEMS ? INNER_ELEMS / n : 1;
+    double best = INFINITY;
+    for (size_t r = 0; r < reps + WARMUP; ++r) {
+        double t0 = timer_now();
+        for (size_t i = 0; i < inner; ++i) {
+            pool_run(pool_global(), nb_chunks, triad_block, tasks, sizeof(TriadData));
+        }
+        double t = (timer_now() - t0) / inner;
+        if (r >= WARMUP && t < best) {
+            best = t;
+        }
+    }
+
+    alloc_free(tasks);
+    alloc_free(a);
+    alloc_free(b);
+    alloc_free(c);
+
+    return 3.0 * sizeof(double) * n / best / 1e9;
+}
+
+/**
+ * Exécuter une fois le noyau décrit par `call` et retourner la valeur comparée à `call->ref` :
+ * le produit scalaire, le carré de la norme de Frobenius, la norme max, ou la somme des
+ * normes (Frobenius au carré) pour les noyaux qui en calculent plusieurs.
+ */
+static double call_kernel(const call_t *call) {
+    bench_data_t *d = call->data;
+    matrix_view_t A = matrix_row_major(d->rows, d->cols, d->cols, d->a);
+    if (strcmp(call->kernel, "ref") == 0) {
+        return dotprod_ref(d->n, d->a, d->b);
+    }
+    reduce_set_mode(call->reduce);
+    if (strcmp(call->kernel, "pairs") == 0) {
+        return dotprod_pairs(d->n, d->a, d->b);
+    }
+    if (strcmp(call->kernel, "frobenius") == 0) {
+        return frobenius_sq_view(A);
+    }
+    if (strcmp(call->kernel, "max") == 0) {
+        return max_view(A);
+    }
+    if (strcmp(call->kernel, "norms") == 0) {
+        norms_t r = norms_view(A);
+        return r.frobenius * r.frobenius + r.max + r.one + r.inf;
+    }
+    if (strcmp(call->kernel, "batch") == 0) {
+        dotprod_batch(d->batch_count, d->batch_a, d->batch_b, d->batch_n, d->batch_out);
+        double sum = 0.;
+        for (size_t i = 0; i < d->batch_count; ++i) {
+            sum += d->batch_out[i];
+        }
+        return sum;
+    }
+    if (strcmp(call->kernel, "sparse") == 0) {
+        return dotprod_sparse_dense(&d->vec, d->b);
+    }
+    if (strcmp(call->kernel, "csr") == 0) {
+        csr_norms_t r = norms_csr(&d->csr);
+        return r.frobenius * r.frobenius + r.max + r.inf;
+    }
+    prefetch_set_distance(call->prefetch);
+    return dotprod_blocks(d->n, call->k, d->a, d->b);
+}
+
+/**
+ * Préparer les formes de `a` lues par les noyaux de normes, du lot et creux.
+ */
+static void data_init(bench_data_t *d) {
+    d->cols = (size_t)sqrt((double)d->n);
+    d->cols = d->cols ? d->cols : 1;
+    d->rows = d->n / d->cols;
+
+    d->sparse = alloc_array(d->n, sizeof(double));
+    for (size_t i = 0; i < d->n; ++i) {
+        d->sparse[i] = i < d->n / 4 || i % 10 == 0 ? d->a[i] : 0.;
+    }
+    d->vec = sparse_vec_from_dense(d->n, d->sparse);
+    d->csr = csr_from_dense(d->rows, d->cols, d->sparse);
+
+    // Paires de longueurs irrégulières (1 à 4 parts), contiguës dans `a` et `b`
+    d->batch_count = d->n < BATCH_COUNT ? d->n : BATCH_COUNT;
+    size_t parts = 0;
+    for (size_t i = 0; i < d->batch_count; ++i) {
+        parts += 1 + i % 4;
+    }
+    for (size_t i = 0, start = 0, seen = 0; i < d->batch_count; ++i) {
+        seen += 1 + i % 4;
+        size_t end = i + 1 == d->batch_count ? d->n : d->n / parts * seen;
+        d->batch_a[i] = d->a + start;
+        d->batch_b[i] = d->b + start;
+        d->batch_n[i] = end - start;
+        start = end;
+    }
+}
+
+static void data_free(bench_data_t *d) {
+    csr_free(&d->csr);
+    sparse_vec_free(&d->vec);
+    alloc_free(d->sparse);
+}
+
+/**
+ * Appel du noyau `kernel` sur `d` : valeur de référence, échelle de l'erreur, octets lus
+ * et opérations par appel.
+ */
+static call_t make_call(const char *kernel, size_t k, size_t prefetch, reduce_mode_t reduce, bench_data_t *d) {
+    call_t call = { kernel, k, prefetch, reduce, false, d, 0., 0., 0., 0. };
+    size_t elems = d->rows * d->cols;
+    if (strcmp(kernel, "frobenius") == 0 || strcmp(kernel, "max") == 0 || strcmp(kernel, "norms") == 0) {
+        norms_t r = norms_ref(d->rows, d->cols, (double (*)[d->cols])d->a);
+        double sq = dotprod_ref(elems, d->a, d->a);
+        call.by_mode = strcmp(kernel, "norms") != 0;
+        call.ref = strcmp(kernel, "frobenius") == 0 ? sq : strcmp(kernel, "max") == 0 ? r.max
+                                                       : r.frobenius * r.frobenius + r.max + r.one + r.inf;
+        call.scale = call.ref;
+        call.bytes = sizeof(double) * (double)elems;
+        call.flops = strcmp(kernel, "max") == 0 ? (double)elems : strcmp(kernel, "frobenius") == 0 ? 2. * elems
+                                                                                                  : 4. * elems;
+    } else if (strcmp(kernel, "sparse") == 0) {
+        call.ref = dotprod_ref(d->n, d->sparse, d->b);
+        for (size_t i = 0; i < d->vec.nnz; ++i) {
+            call.scale += fabs(d->vec.value[i] * d->b[d->vec.index[i]]);
+        }
+        call.bytes = (2. * sizeof(double) + sizeof(size_t)) * (double)d->vec.nnz;
+        call.flops = 2. * d->vec.nnz;
+    } else if (strcmp(kernel, "csr") == 0) {
+        norms_t r = norms_ref(d->rows, d->cols, (double (*)[d->cols])d->sparse);
+        call.ref = r.frobenius * r.frobenius + r.max + r.inf;
+        call.scale = call.ref;
+        call.bytes = (sizeof(double) + sizeof(size_t)) * (double)d->csr.nnz + sizeof(size_t) * (d->rows + 1.);
+        call.flops = 4. * d->csr.nnz;
+    } else {
+        // Produits scalaires denses : ref, pairs, blocks et batch
+        call.by_mode = strcmp(kernel, "pairs") == 0 || strcmp(kernel, "blocks") == 0;
+        call.ref = dotprod_ref(d->n, d->a, d->b);
+        for (size_t i = 0; i < d->n; ++i) {
+            call.scale += fabs(d->a[i] * d->b[i]);
+        }
+        call.bytes = 2. * sizeof(double) * (double)d->n;
+        call.flops = 2. * d->n;
+    }
+    return call;
+}
+
+static int compare_double(const void *x, const void *y) {
+    double a = *(const double *)x, b = *(const double *)y;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Mesurer un noyau : `warmup` appels de chauffe puis `reps` répétitions de `inner` appels.
+ * L'écart à `call->ref` est exprimé en unités de DBL_EPSILON * `call->scale`.
+ */
+static void measure(const call_t *call, size_t reps, size_t warmup, bench_result_t *res) {
+    size_t n = call->data->n;
+    size_t inner = n < INNER_ELEMS ? INNER_ELEMS / (n ? n : 1) : 1;
+    if (strcmp(call->kernel, "pairs") == 0) {
+        inner = 1;  // Une tâche par élément : déjà assez long
+    }
+
+    double *times = alloc_array(reps, sizeof(double));
+    volatile double sink = 0.;  // Empêche l'élimination des appels
+    for (size_t r = 0; r < warmup; ++r) {
+        sink += call_kernel(call);
+    }
+    double value = 0.;
+    perf_start();
+    for (size_t r = 0; r < reps; ++r) {
+        double t0 = timer_now();
+        for (size_t i = 0; i < inner; ++i) {
+            value = call_kernel(call);
+            sink += value;
+        }
+        times[r] = (timer_now() - t0) / inner;
+    }
+    res->perf_per_call = perf_stop() / (reps * inner);
+    (void)sink;
+
+    qsort(times, reps, sizeof(double), compare_double);
+    res->kernel = call->kernel;
+    res->n = n;
+    res->k = call->k;
+    res->prefetch = call->prefetch;
+    res->reduce = call->by_mode ? reduce_mode_name(call->reduce) : "-";
+    res->reps = reps;
+    res->inner = inner;
+    res->min_s = times[0];
+    res->median_s = times[reps / 2];
+    res->gbs = call->bytes / res->min_s / 1e9;
+    res->gflops = call->flops / res->min_s / 1e9;
+    res->rel_err = fabs(value - call->ref) / fmax(fabs(call->ref), 1e-300);
+    res->err_ulps = fabs(value - call->ref) / (DBL_EPSILON * fmax(call->scale, DBL_MIN));
+
+    alloc_free(times);
+}
+
+// ====================== COMPARAISON À UNE RÉFÉRENCE =============================
+
+/**
+ * Repères emboîtés sur l'arène de travail vide, après un premier appel qui lui a donné un
+ * bloc : le repère intérieur découpe plus que ce bloc et le rend, puis `dotprod_blocks`
+ * s'exécute sous le repère extérieur, qui doit rester valide (régression de `arena_release`). Le résultat est comparé à
+ * `dotprod_ref` avec la borne d'erreur des autres mesures, quel que soit le mode de réduction.
+ */
+static bool check_nested_marks(size_t seed) {
+    size_t n = 4096;
+    double *a = alloc_array(n, sizeof(double));
+    double *b = alloc_array(n, sizeof(double));
+    srand48((long)seed);
+    double scale = 0.;
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = 2. * drand48() - 1.;
+        b[i] = 2. * drand48() - 1.;
+        scale += fabs(a[i] * b[i]);
+    }
+    double ref = dotprod_ref(n, a, b);
+    dotprod_blocks(n, 16, a, b);
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t outer = arena_mark(scratch);
+    arena_mark_t inner = arena_mark(scratch);
+    arena_alloc(scratch, 2 * ARENA_BLOCK_MIN, 1);
+    arena_release(scratch, inner);
+    double res = dotprod_blocks(n, 16, a, b);
+    arena_release(scratch, outer);
+
+    bool ok = fabs(res - ref) <= n * DBL_EPSILON * fmax(1., scale);
+    if (!ok) {
+        fprintf(stderr, "repères emboîtés de l'arène : %.17g au lieu de %.17g\n", res, ref);
+    }
+    alloc_free(a);
+    alloc_free(b);
+    return ok;
+}
+
+/**
+ * Le nom `name` figure-t-il dans la liste `list` (`ref,pairs,blocks`) ?
+ */
+static bool in_list(const char *list, const char *name) {
+    size_t len = strlen(name);
+    for (const char *p = list; *p; p += strcspn(p, ",") + (p[strcspn(p, ",")] == ',')) {
+        if (strcspn(p, ",") == len && strncmp(p, name, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Analyser une liste de modes de réduction (`mutex,tree,atomic`). Retourne le nombre de modes lus.
+ */
+static size_t parse_reduce_list(const char *list, reduce_mode_t *modes, size_t max) {
+    static const reduce_mode_t all[] = { REDUCE_MUTEX, REDUCE_TREE, REDUCE_ATOMIC };
+    size_t count = 0;
+    for (const char *p = list; *p && count < max; p += strcspn(p, ",") + (p[strcspn(p, ",")] == ',')) {
+        size_t len = strcspn(p, ",");
+        for (size_t m = 0; m < sizeof(all) / sizeof(all[0]); ++m) {
+            const char *name = reduce_mode_name(all[m]);
+            if (strlen(name) == len && strncmp(p, name, len) == 0) {
+                modes[count++] = all[m];
+            }
+        }
+    }
+    return count;
+}
+
+// ============================ SORTIES ===========================================
+
+static char machine[BASELINE_MACHINE_LEN]; // Machine de mesure (voir `baseline_machine`)
+
+static void print_csv_header(FILE *out) {
+    fprintf(out, "kernel,n,threads,k,prefetch,reduce,reps,inner,min_s,median_s,gbs,gflops,stream_gbs,pct_stream,"
+                 "rel_err,err_ulps,machine%s\n",
+            perf_fd >= 0 ? ",perf_per_call,perf_per_kelem" : "");
+}
+
+static void print_csv(FILE *out, const bench_result_t *r) {
+    fprintf(out, "%s,%zu,%zu,%zu,%zu,%s,%zu,%zu,%.9e,%.9e,%.3f,%.3f,%.3f,%.1f,%.3e,%.3f,%s",
+            r->kernel, r->n, r->threads, r->k, r->prefetch, r->reduce, r->reps, r->inner, r->min_s, r->median_s,
+            r->gbs, r->gflops, r->stream_gbs, 100.0 * r->gbs / r->stream_gbs, r->rel_err, r->err_ulps, machine);
+    if (perf_fd >= 0) {
+        fprintf(out, ",%.1f,%.4f", r->perf_per_call, 1e3 * r->perf_per_call / r->n);
+    }
+    fprintf(out, "\n");
+}
+
+static void print_json(FILE *out, const bench_result_t *r, int first) {
+    fprintf(out, "%s\n  {\"kernel\": \"%s\", \"n\": %zu, \"threads\": %zu, \"k\": %zu, "
+                 "\"prefetch\": %zu, \"reduce\": \"%s\", \"reps\": %zu, \"inner\": %zu, "
+                 "\"min_s\": %.9e, \"median_s\": %.9e, \"gbs\": %.3f, \"gflops\": %.3f, "
+                 "\"stream_gbs\": %.3f, \"rel_err\": %.3e, \"err_ulps\": %.3f, \"machine\": \"%s\"",
+            first ? "" : ",", r->kernel, r->n, r->threads, r->k, r->prefetch, r->reduce, r->reps, r->inner,
+            r->min_s, r->median_s, r->gbs, r->gflops, r->stream_gbs, r->rel_err, r->err_ulps, machine);
+    if (perf_fd >= 0) {
+        fprintf(out, ", \"perf_per_call\": %.1f, \"perf_per_kelem\": %.4f",
+                r->perf_per_call, 1e3 * r->perf_per_call / r->n);
+    }
+    fprintf(out, "}");
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Banc d'essai de `dotprod_ref`, `dotprod_pairs` et `dotprod_blocks`, et des noyaux qui
+ * les réutilisent : normes d'une matrice presque carrée lue dans `a` (frobenius, max et
+ * norms, soit `frobenius_sq_view`, `max_view` et `norms_view`), lot de produits scalaires
+ * (batch, `dotprod_batch`), produit creux-dense et normes CSR de `a` creusé (sparse et csr).
+ * Options : --min-n, --max-n, --step, --threads=1,2,4, --k=0,4096, --kernels=ref,blocks,...
+ * (noms exacts, tous par défaut), --pairs-max-n, --reps, --warmup, --format=csv|json, --output=fichier.
+ * --prefetch=0,512,2048 mesure `dotprod_blocks` pour chaque distance de préchargement
+ * logiciel (octets, voir `prefetch.h`) ; --huge=thp|off choisit les grandes pages des
+ * vecteurs (voir `alloc_get_huge`), dont l'utilisation effective est affichée.
+ * --perf=hitm|cache-misses|stalls|dtlb-misses|0x... ajoute le compteur matériel par appel et pour 1000 éléments ;
+ * avec --perf-max=x, le programme échoue si un noyau parallèle dépasse x événements pour
+ * 1000 éléments (par exemple `--perf=hitm --perf-max=1` pour vérifier l'absence de faux partage).
+ *
+ * Banc de non-régression : --reduce=mutex,tree,atomic mesure les noyaux qui en dépendent
+ * (pairs, blocks, frobenius et max) dans chaque mode de réduction ; --random=x remplace le
+ * balayage par x tailles tirées entre --min-n et --max-n (répartition logarithmique, graine
+ * --seed). Les vecteurs sont tirés dans [-1, 1) (signes mêlés) et le programme échoue si un
+ * résultat s'écarte de sa référence séquentielle de plus de n unités DBL_EPSILON * somme des
+ * valeurs absolues des termes (borne d'erreur de deux sommes quelconques de n termes). Avec
+ * --baseline=fichier.csv (sortie CSV d'une exécution précédente), il échoue aussi si le
+ * débit d'une mesure présente dans la référence baisse de plus de --max-drop pour cent ;
+ * les débits ne sont comparés que si la référence a été mesurée sur la même machine
+ * (modèle du processeur et noyau vectoriel, colonne `machine`), sinon seule l'exactitude
+ * est vérifiée.
+ * Il vérifie aussi, avant les mesures, les repères emboîtés de l'arène de travail.
+ */
+int main(int argc, char **argv) {
+    size_t min_n = arg_size(argc, argv, "min-n", NULL, MIN_N);
+    size_t max_n = arg_size(argc, argv, "max-n", NULL, MAX_N);
+    size_t step = arg_size(argc, argv, "step", NULL, STEP_N);
+    size_t pairs_max_n = arg_size(argc, argv, "pairs-max-n", NULL, PAIRS_MAX_N);
+    size_t reps = arg_size(argc, argv, "reps", NULL, REPS);
+    size_t warmup = arg_size(argc, argv, "warmup", NULL, WARMUP);
+    const char *kernels = arg_string(argc, argv, "kernels", NULL, ALL_KERNELS);
+    const char *format = arg_string(argc, argv, "format", NULL, "csv");
+    const char *output = arg_string(argc, argv, "output", NULL, NULL);
+    const char *perf = arg_string(argc, argv, "perf", NULL, NULL);
+    const char *perf_max = arg_string(argc, argv, "perf-max", NULL, NULL);
+    const char *huge = arg_string(argc, argv, "huge", NULL, NULL);
+    const char *reduce_list = arg_string(argc, argv, "reduce", NULL, reduce_mode_name(reduce_get_mode()));
+    const char *baseline_path = arg_string(argc, argv, "baseline", NULL, NULL);
+    const char *max_drop_arg = arg_string(argc, argv, "max-drop", NULL, NULL);
+    size_t nb_random = arg_size(argc, argv, "random", NULL, 0);
+    size_t seed = arg_size(argc, argv, "seed", NULL, SEED);
+    if (step < 2) {
+        step = 2;
+    }
+    if (reps == 0) {
+        reps = 1;
+    }
+
+    // Nombres de threads : par défaut 1, 2, 4, ... jusqu'au nombre de cœurs
+    char default_threads[256] = "";
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long t = 1; ; t *= 2) {
+        long v = t < ncpu ? t : ncpu;
+        snprintf(default_threads + strlen(default_threads), sizeof(default_threads) - strlen(default_threads),
+                 "%s%ld", t == 1 ? "" : ",", v);
+        if (v >= ncpu) {
+            break;
+        }
+    }
+    size_t threads[MAX_LIST], ks[MAX_LIST];
+    size_t nb_threads = arg_size_list(argc, argv, "threads", NULL, default_threads, threads, MAX_LIST);
+    size_t nb_ks = arg_size_list(argc, argv, "k", NULL, "0,4096,65536", ks, MAX_LIST);
+    size_t prefetches[MAX_LIST];
+    char default_prefetch[32];
+    snprintf(default_prefetch, sizeof(default_prefetch), "%zu", prefetch_get_distance());
+    size_t nb_prefetches = arg_size_list(argc, argv, "prefetch", NULL, default_prefetch, prefetches, MAX_LIST);
+    if (huge) {
+        alloc_set_huge(strcmp(huge, "off") == 0 ? ALLOC_HUGE_OFF : ALLOC_HUGE_THP);
+    }
+    reduce_mode_t modes[MAX_LIST];
+    size_t nb_modes = parse_reduce_list(reduce_list, modes, MAX_LIST);
+    if (nb_modes == 0) {
+        fprintf(stderr, "--reduce=%s : aucun mode reconnu (mutex, tree, atomic)\n", reduce_list);
+        return EXIT_FAILURE;
+    }
+
+    // Tailles mesurées : balayage géométrique, ou tirage logarithmique entre min_n et max_n
+    size_t nb_sizes = 0, capacity = nb_random ? nb_random : 64;
+    size_t *sizes = alloc_array(capacity, sizeof(size_t));
+    if (nb_random) {
+        unsigned short xsubi[3] = { (unsigned short)seed, (unsigned short)(seed >> 16), 0x330e };
+        double span = log((double)(max_n > min_n ? max_n : min_n) / (double)(min_n ? min_n : 1));
+        for (; nb_sizes < nb_random; ++nb_sizes) {
+            sizes[nb_sizes] = (size_t)((double)(min_n ? min_n : 1) * exp(span * erand48(xsubi)));
+        }
+    } else {
+        for (size_t n = min_n; n <= max_n && nb_sizes < capacity; n *= step) {
+            sizes[nb_sizes++] = n;
+            if (n > max_n / step) {
+                break;  // Évite le dépassement de capacité de n * step
+            }
+        }
+    }
+
+    // Mesures de référence pour la détection des régressions de débit
+    static const char *const key_cols[] = { "kernel", "n", "threads", "k", "prefetch", "reduce" };
+    baseline_t baseline = { NULL, 0, "" };
+    double max_drop = max_drop_arg ? strtod(max_drop_arg, NULL) : MAX_DROP;
+    baseline_machine(machine, sizeof(machine), simd_dot_name());
+    if (baseline_path && baseline_load(&baseline, baseline_path, key_cols, 6, "gbs") == 0) {
+        fprintf(stderr, "%s : aucune mesure de référence\n", baseline_path);
+        return EXIT_FAILURE;
+    }
+    if (baseline.count && strcmp(baseline.machine, machine) != 0) {
+        fprintf(stderr, "%s : mesurée sur « %s », machine courante « %s » : débits non comparés\n",
+                baseline_path, baseline.machine[0] ? baseline.machine : "machine inconnue", machine);
+        baseline_free(&baseline);
+    }
+
+    // Compteur matériel, ouvert avant la création du pool pour être hérité par ses threads
+    if (perf) {
+        perf_fd = perf_open(perf);
+        if (perf_fd < 0) {
+            perror("perf_event_open");
+            fprintf(stderr, "compteur '%s' non disponible, mesure sans compteur\n", perf);
+        }
+    }
+    double perf_limit = perf_max ? strtod(perf_max, NULL) : INFINITY;
+    int status = check_nested_marks(seed) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out) {
+        perror(output);
+        return EXIT_FAILURE;
+    }
+    int json = strcmp(format, "json") == 0;
+    int first = 1;
+    if (json) {
+        fprintf(out, "[");
+    } else {
+        print_csv_header(out);
+    }
+    fprintf(stderr, "noyau vectoriel : %s, réduction : %s, sommation : %s, préchargement : %s, grandes pages : %s\n",
+            simd_dot_name(), reduce_mode_name(reduce_get_mode()), sum_mode_name(sum_get_mode()),
+            prefetch_hint_name(prefetch_get_hint()), alloc_huge_name(alloc_get_huge()));
+
+    for (size_t s = 0; s < nb_sizes; ++s) {
+        size_t n = sizes[s];
+        bench_data_t data = { .n = n };
+        double *a = data.a = alloc_array(n, sizeof(double));
+        double *b = data.b = alloc_array(n, sizeof(double));
+        srand48((long)seed);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = 2. * drand48() - 1.;
+            b[i] = 2. * drand48() - 1.;
+        }
+        data_init(&data);
+        if (n * sizeof(double) >= ALIGN_HUGE) {
+            fprintf(stderr, "n=%zu : %zu Ko de `a` en grandes pages sur %zu Ko\n", n, alloc_huge_backed(a) / 1024,
+                    n * sizeof(double) / 1024);
+        }
+
+        // Liste des appels à mesurer pour cette taille (pour chaque nombre de threads) : les
+        // noyaux qui dépendent du mode de réduction sont mesurés dans chacun des modes
+        static const char *const others[] = { "frobenius", "max", "norms", "batch", "sparse", "csr" };
+        size_t nb_others = sizeof(others) / sizeof(others[0]);
+        call_t *calls = alloc_array(1 + nb_modes * (1 + nb_ks * nb_prefetches + nb_others), sizeof(call_t));
+        size_t nb_calls = 0;
+        if (in_list(kernels, "ref")) {
+            calls[nb_calls++] = make_call("ref", 0, 0, modes[0], &data);
+        }
+        for (size_t m = 0; m < nb_modes; ++m) {
+            if (in_list(kernels, "pairs") && n <= pairs_max_n) {
+                calls[nb_calls++] = make_call("pairs", 0, 0, modes[m], &data);
+            }
+            if (in_list(kernels, "blocks")) {
+                for (size_t i = 0; i < nb_ks; ++i) {
+                    for (size_t p = 0; p < nb_prefetches && ks[i] <= n; ++p) {
+                        calls[nb_calls++] = make_call("blocks", ks[i], prefetches[p], modes[m], &data);
+                    }
+                }
+            }
+            for (size_t o = 0; o < nb_others; ++o) {
+                if (in_list(kernels, others[o])) {
+                    call_t call = make_call(others[o], 0, 0, modes[m], &data);
+                    if (m == 0 || call.by_mode) {
+                        calls[nb_calls++] = call;
+                    }
+                }
+            }
+        }
+
+        for (size_t t = 0; t < nb_threads; ++t) {
+            pool_global_resize(threads[t]);
+            pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+            double stream = stream_triad(n, reps);
+
+            for (size_t c = 0; c < nb_calls; ++c) {
+                if (strcmp(calls[c].kernel, "ref") == 0 && t > 0) {
+                    continue;  // Séquentiel : mesuré une seule fois
+                }
+                bench_result_t res;
+                measure(&calls[c], reps, warmup, &res);
+                res.threads = strcmp(calls[c].kernel, "ref") == 0 ? 1 : pool_size(pool_global());
+                res.stream_gbs = stream;
+                if (perf_fd >= 0 && res.threads > 1 && 1e3 * res.perf_per_call / n > perf_limit) {
+                    fprintf(stderr, "%s n=%zu threads=%zu k=%zu prefetch=%zu : %.4f événements '%s' "
+                                    "pour 1000 éléments (max %g)\n",
+                            res.kernel, n, res.threads, res.k, res.prefetch, 1e3 * res.perf_per_call / n, perf,
+                            perf_limit);
+                    status = EXIT_FAILURE;
+                }
+                if (res.err_ulps > (double)n) {
+                    fprintf(stderr, "%s n=%zu threads=%zu k=%zu reduce=%s : écart de %.1f unités (max %zu)\n",
+                            res.kernel, n, res.threads, res.k, res.reduce, res.err_ulps, n);
+                    status = EXIT_FAILURE;
+                }
+                char key[128];
+                snprintf(key, sizeof(key), "%s,%zu,%zu,%zu,%zu,%s", res.kernel, n, res.threads, res.k, res.prefetch,
+                         res.reduce);
+                if (!baseline_check(&baseline, key, res.gbs, max_drop)) {
+                    status = EXIT_FAILURE;
+                }
+                if (json) {
+                    print_json(out, &res, first);
+                } else {
+                    print_csv(out, &res);
+                }
+                first = 0;
+                fflush(out);
+            }
+        }
+
+        alloc_free(calls);
+        data_free(&data);
+        alloc_free(a);
+        alloc_free(b);
+    }
+
+    if (json) {
+        fprintf(out, "\n]\n");
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (perf_fd >= 0) {
+        close(perf_fd);
+    }
+    baseline_free(&baseline);
+    alloc_free(sizes);
+
+    return status;
+}
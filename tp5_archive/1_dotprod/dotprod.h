@@ -0,0 +1,88 @@
+#ifndef DOTPROD_H
+#define DOTPROD_H
+
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "simd_typed.h"
+#include "sparse.h"
+
+// ========================= PRODUIT SCALAIRE =====================================
+
+/**
+ * Fonction de référence (version séquentielle) pour calculer le produit scalaire.
+ * Définie dans `dotprod_ref.c`.
+ */
+double dotprod_ref(size_t n, double a[n], double b[n]);
+
+/**
+ * Produit scalaire parallèle, une tâche par paire d'éléments.
+ * Défini dans `dotprod_pairs.c`.
+ */
+double dotprod_pairs(size_t n, double a[n], double b[n]);
+
+/**
+ * Produit scalaire parallèle par blocs d'au plus `k` éléments (`k == 0` : découpage automatique).
+ * Défini dans `dotprod_blocks.c`.
+ */
+double dotprod_blocks(size_t n, size_t k, double a[n], double b[n]);
+
+/**
+ * Version asynchrone de `dotprod_blocks` sur le pool courant : retourne aussitôt un
+ * futur (voir `pool_async`) ; `a` et `b` doivent rester valides jusqu'au résultat.
+ * Définie dans `dotprod_blocks.c`.
+ */
+pool_future_t *dotprod_blocks_async(size_t n, size_t k, double a[n], double b[n], pool_callback_fn callback,
+                                    void *user);
+
+/**
+ * Produits scalaires d'un lot de paires : out[i] = a[i] . b[i] sur `n[i]` éléments,
+ * pour les `count` paires, en un seul passage du pool (petites paires regroupées,
+ * longues paires découpées). Défini dans `dotprod_batch.c`.
+ */
+void dotprod_batch(size_t count, double *const a[count], double *const b[count], const size_t n[count],
+                   double out[count]);
+
+/**
+ * Produit matrice-vecteur y = A x, pour `A` de m x n stockée par lignes (lignes distantes
+ * de `lda` >= n). Blocs de lignes répartis sur le pool, produits scalaires par `simd_dot`.
+ * Défini dans `dotprod_gemv.c`.
+ */
+void dotprod_gemv(size_t m, size_t n, const double *A, size_t lda, const double *x, double *y);
+
+/**
+ * Produit matrice-matrice C = A B, pour `A` de m x k, `B` de k x n et `C` de m x n
+ * stockées par lignes (dimensions principales `lda`, `ldb`, `ldc`). Blocage pour les
+ * caches, panneaux rangés et micro-noyau vectorisé (voir `simd_gemm.h`).
+ * Défini dans `dotprod_gemm.c`.
+ */
+void dotprod_gemm(size_t m, size_t n, size_t k, const double *A, size_t lda, const double *B, size_t ldb,
+                  double *C, size_t ldc);
+
+/**
+ * Produit scalaire d'un vecteur creux `a` et d'un vecteur dense `b` (a.n éléments).
+ * Les éléments stockés de `a` sont découpés en blocs de taille égale, quelle que soit
+ * leur répartition dans le vecteur. Défini dans `dotprod_sparse.c`.
+ */
+double dotprod_sparse_dense(const sparse_vec_t *a, const double *b);
+
+/**
+ * Produit scalaire de deux vecteurs creux de même dimension, par fusion de leurs
+ * indices triés, découpée en parts égales du chemin de fusion. Défini dans `dotprod_sparse.c`.
+ */
+double dotprod_sparse(const sparse_vec_t *a, const sparse_vec_t *b);
+
+/**
+ * Variantes typées de `dotprod_blocks`, une par ligne de `SIMD_ELEM_TYPES` :
+ *   double  dotprod_blocks_f32 (n, k, const float *a,  const float *b);
+ *   double  dotprod_blocks_bf16(n, k, const bf16_t *a, const bf16_t *b);
+ *   double  dotprod_blocks_f16 (n, k, const f16_t *a,  const f16_t *b);
+ *   int64_t dotprod_blocks_i8  (n, k, const int8_t *a, const int8_t *b);
+ * Les blocs sont réduits dans l'accumulateur du type (voir `simd_typed.h`), puis combinés
+ * dans l'ordre dans le type du résultat. Définies dans `dotprod_typed.c`.
+ */
+#define DECLARE_DOTPROD_TYPED(SUFFIX, ELEM_T, PART_T, TOTAL_T) \
+    TOTAL_T dotprod_blocks_##SUFFIX(size_t n, size_t k, const ELEM_T *a, const ELEM_T *b);
+SIMD_ELEM_TYPES(DECLARE_DOTPROD_TYPED)
+
+#endif // DOTPROD_H
@@ -2,88 +2,18 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <math.h>
-#include <pthread.h>
-#include <assert.h>
+#include <float.h>
 
-// Définir la taille du tableau
-#define N 10
-
-// ========================= STRUCTURE POUR LES THREADS ============================
-
-// Structure utilisée pour transmettre les paramètres nécessaires à chaque thread
-typedef struct {
-    size_t index;          // Index de l'élément du tableau à traiter
-    double *a;             // Pointeur vers le tableau `a`
-    double *b;             // Pointeur vers le tableau `b`
-    double *shared_sum;    // Pointeur vers la somme partagée (variable globale)
-    pthread_mutex_t *mutex; // Pointeur vers le mutex pour la synchronisation
-} ThreadData;
-
-// ======================== FONCTION EXECUTÉE PAR LES THREADS ======================
-
-/**
- * Fonction de calcul exécutée par chaque thread.
- * Elle calcule le produit de deux éléments des tableaux `a` et `b` pour un index donné,
- * et ajoute ce produit à la somme partagée en utilisant un mutex pour la synchronisation.
- */
-void* compute_product(void *arg) {
-    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre reçu en `ThreadData`
-
-    // Calcul du produit de deux éléments des tableaux
-    double product = data->a[data->index] * data->b[data->index];
-
-    // Ajouter le produit à la somme partagée (section critique protégée par un mutex)
-    pthread_mutex_lock(data->mutex);
-    *(data->shared_sum) += product;
-    pthread_mutex_unlock(data->mutex);
-
-    return NULL;  // Les threads renvoient NULL par convention ici
-}
-
-// =========================== FONCTIONS DE CALCUL ================================
-
-/**
- * Fonction de référence (version séquentielle) pour calculer le produit scalaire.
- * La définition est supposée donnée dans un fichier séparé.
- */
-double dotprod_ref(size_t n, double a[n], double b[n]);
+#include "thread_pool.h"
+#include "dotprod.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "args.h"
 
-/**
- * Fonction de calcul parallèle du produit scalaire.
- * Chaque thread calcule une contribution individuelle, qui est ensuite accumulée
- * dans une variable partagée protégée par un mutex.
- */
-double dotprod_pairs(size_t n, double a[n], double b[n]) {
-    double sum = 0.0;  // Somme partagée initialisée à 0
-    pthread_t threads[n];  // Tableau pour stocker les identifiants des threads
-    ThreadData thread_data[n];  // Tableau pour stocker les données des threads
-    pthread_mutex_t mutex;  // Mutex pour protéger l'accès à la somme partagée
-
-    // Initialisation du mutex
-    pthread_mutex_init(&mutex, NULL);
-
-    // Création des threads pour traiter chaque élément du tableau
-    for (size_t i = 0; i < n; ++i) {
-        thread_data[i].index = i;        // Définir l'index du thread
-        thread_data[i].a = a;           // Passer le tableau `a`
-        thread_data[i].b = b;           // Passer le tableau `b`
-        thread_data[i].shared_sum = &sum; // Passer la somme partagée
-        thread_data[i].mutex = &mutex;  // Passer le mutex
-
-        // Création du thread et affectation de la fonction `compute_product`
-        pthread_create(&threads[i], NULL, compute_product, &thread_data[i]);
-    }
-
-    // Attente de la terminaison de tous les threads
-    for (size_t i = 0; i < n; ++i) {
-        pthread_join(threads[i], NULL);
-    }
-
-    // Destruction du mutex (nettoyage)
-    pthread_mutex_destroy(&mutex);
-
-    return sum;  // Retourner la somme calculée
-}
+// Taille par défaut du tableau (modifiable par `--n` ou la variable `SIZE_N`)
+#define N 10
+// Taille maximale des tableaux affichés
+#define PRINT_MAX 16
 
 // ========================= FONCTIONS UTILES =====================================
 
@@ -113,25 +43,28 @@ void printArray(size_t n, double a[n]) {
  * Utile pour comparer les résultats avec une tolérance donnée.
  */
 inline bool isClose(double a, double b, double threshold) {
-    return fabs(a - b) < threshold;
+    return fabs(a - b) <= threshold;
 }
 
 // =============================== MAIN ============================================
 
-int main(void) {
-    size_t n = N;  // Taille des tableaux
+int main(int argc, char **argv) {
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);  // Taille des tableaux
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
 
-    // Déclaration et initialisation des tableaux
-    double a[n];
-    double b[n];
+    // Allocation (sur le tas) et initialisation des tableaux
+    double *a = alloc_array(n, sizeof(double));
+    double *b = alloc_array(n, sizeof(double));
     initArray(n, a);
     initArray(n, b);
 
-    // Affichage des tableaux
-    printf("Tableau a =\n");
-    printArray(n, a);
-    printf("Tableau b =\n");
-    printArray(n, b);
+    // Affichage des tableaux (seulement s'ils sont petits)
+    if (n <= PRINT_MAX) {
+        printf("Tableau a =\n");
+        printArray(n, a);
+        printf("Tableau b =\n");
+        printArray(n, b);
+    }
 
     // Calcul du produit scalaire en version séquentielle (référence)
     double ref = dotprod_ref(n, a, b);
@@ -141,14 +74,20 @@ int main(void) {
 
     // Affichage des résultats
     printf("\nProduit scalaire (référence) = %lf\n", ref);
-    printf("Produit scalaire (parallèle) = %lf\n", res);
+    printf("Produit scalaire (parallèle, %s, %s) = %lf\n", reduce_mode_name(reduce_get_mode()),
+           sum_mode_name(sum_get_mode()), res);
+    printf("Valeur exacte affichée : %.17g\n", res);
 
-    // Vérification de la validité des résultats
-    if (isClose(ref, res, 0.0001)) {
+    // Vérification de la validité des résultats : la somme récursive de référence
+    // a une erreur bornée par n * epsilon * |ref| (données positives)
+    if (isClose(ref, res, n * DBL_EPSILON * fmax(1., fabs(ref)))) {
         printf("Résultat correct : OK\n");
     } else {
         printf("Erreur : différence entre les résultats supérieure au seuil\n");
     }
 
+    alloc_free(a);
+    alloc_free(b);
+
     return 0;  // Terminer le programme
 }
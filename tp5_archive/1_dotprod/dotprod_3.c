@@ -0,0 +1,132 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+
+// Valeurs par défaut (modifiables par `--count`/`--n` ou `BATCH_COUNT`/`SIZE_N`)
+#define COUNT 8       // Nombre de paires du lot
+#define N 10          // Longueur de base d'une paire
+#define PRINT_MAX 16  // Nombre maximal de résultats affichés
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Longueur de la paire `i` : de 1 à 4 fois la longueur de base, plus `i`, pour que
+ * les paires du lot soient de tailles irrégulières.
+ */
+static size_t pairLength(size_t n, size_t i) {
+    return n * (1 + i % 4) + i;
+}
+
+/**
+ * Initialisation d'un tableau avec des valeurs incrémentales (0, 1, 2, ...).
+ */
+void initArray(size_t n, double a[n]) {
+    static double elem = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = elem;
+        elem += 1.;
+    }
+}
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+double absDot(size_t n, double a[n], double b[n]) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Lot de `count` produits scalaires de longueurs variées : calcul en un seul passage
+ * du pool (`dotprod_batch`), comparé à un appel de `dotprod_blocks` par paire
+ * (une attente du pool par paire) et vérifié paire par paire avec `dotprod_ref`.
+ */
+int main(int argc, char **argv) {
+    size_t count = arg_size(argc, argv, "count", "BATCH_COUNT", COUNT);  // Nombre de paires
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);                   // Longueur de base
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    // Paires rangées les unes à la suite des autres dans deux grands tableaux
+    size_t *lengths = alloc_array(count, sizeof(size_t));
+    double **a = alloc_array(count, sizeof(double *));
+    double **b = alloc_array(count, sizeof(double *));
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        lengths[i] = pairLength(n, i);
+        total += lengths[i];
+    }
+    double *storage_a = alloc_array(total, sizeof(double));
+    double *storage_b = alloc_array(total, sizeof(double));
+    for (size_t i = 0, offset = 0; i < count; offset += lengths[i++]) {
+        a[i] = storage_a + offset;
+        b[i] = storage_b + offset;
+    }
+    initArray(total, storage_a);
+    initArray(total, storage_b);
+
+    double *res = alloc_array(count, sizeof(double));
+    double *loop = alloc_array(count, sizeof(double));
+
+    // Lot entier en un seul passage du pool
+    double t0 = timer_now();
+    dotprod_batch(count, a, b, lengths, res);
+    double t_batch = timer_now() - t0;
+
+    // Même calcul, un passage du pool par paire
+    t0 = timer_now();
+    for (size_t i = 0; i < count; ++i) {
+        loop[i] = dotprod_blocks(lengths[i], 0, a[i], b[i]);
+    }
+    double t_loop = timer_now() - t0;
+
+    printf("Lot de %zu paires (%zu éléments au total), %zu threads, %s\n", count, total,
+           pool_size(pool_global()), sum_mode_name(sum_get_mode()));
+    printf("Temps : lot %.6f s, une paire à la fois %.6f s\n", t_batch, t_loop);
+
+    // Vérification de chaque paire ; en sommation compensée, le lot doit donner
+    // exactement les résultats de `dotprod_blocks`
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        double ref = dotprod_ref(lengths[i], a[i], b[i]);
+        double threshold = lengths[i] * DBL_EPSILON * fmax(1., absDot(lengths[i], a[i], b[i]));
+        bool pair_ok = fabs(ref - res[i]) <= threshold;
+        if (sum_get_mode() == SUM_COMPENSATED && res[i] != loop[i]) {
+            pair_ok = false;
+        }
+        if (i < PRINT_MAX || !pair_ok) {
+            printf("Paire %zu (%zu éléments) : référence = %.17g, lot = %.17g%s\n", i, lengths[i], ref, res[i],
+                   pair_ok ? "" : " (ERREUR)");
+        }
+        ok = ok && pair_ok;
+    }
+
+    if (ok) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    alloc_free(loop);
+    alloc_free(res);
+    alloc_free(storage_b);
+    alloc_free(storage_a);
+    alloc_free(b);
+    alloc_free(a);
+    alloc_free(lengths);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "simd_gemm.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+
+// Valeurs par défaut (modifiables par `--m`/`--n`/`--k`/`--reps` ou `SIZE_M`/`SIZE_N`/`SIZE_K`/`REPS`)
+#define M 5           // Lignes de A et de C
+#define N 8           // Colonnes de B et de C
+#define K 10          // Colonnes de A, lignes de B
+#define REPS 3        // Répétitions de chaque mesure (on garde la plus rapide)
+#define CHECK_ROWS 64 // Lignes de C vérifiées (réparties sur toute la matrice)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Valeur pseudo-aléatoire de [-1, 1], multiple de 1/64 (produits exacts).
+ */
+static double elemValue(size_t i, size_t prime) {
+    return ((double)((i * prime) % 129) - 64.0) / 64.0;
+}
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+static double absDot(size_t n, const double *a, const double *b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+/**
+ * Comparer `res[j]` à `dotprod_ref` de la ligne `a` avec la colonne j de `B`,
+ * lue dans sa transposée `Bt` (n x k).
+ */
+static bool rowClose(size_t n, size_t k, const double *a, const double *Bt, const double *res) {
+    for (size_t j = 0; j < n; ++j) {
+        const double *b = Bt + j * k;
+        double ref = dotprod_ref(k, (double *)a, (double *)b);
+        if (fabs(res[j] - ref) > k * DBL_EPSILON * fmax(1., absDot(k, a, b))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Meilleur temps de `reps` exécutions de STMT
+#define TIME_BEST(STMT, reps, best)                 \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            STMT;                                   \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Produits matrice-vecteur et matrice-matrice, comparés à leur assemblage par produits
+ * scalaires : GEMV ligne par ligne avec `dotprod_blocks`, et GEMM ligne de C par ligne
+ * de C avec `dotprod_gemv` sur la transposée de B. Les résultats sont vérifiés avec
+ * `dotprod_ref` (y entier, et CHECK_ROWS lignes de C).
+ */
+int main(int argc, char **argv) {
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t k = arg_size(argc, argv, "k", "SIZE_K", K);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    reps = reps ? reps : 1;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *A = alloc_array(m * k > 0 ? m * k : 1, sizeof(double));
+    double *B = alloc_array(k * n > 0 ? k * n : 1, sizeof(double));
+    double *Bt = alloc_array(k * n > 0 ? k * n : 1, sizeof(double));
+    double *C = alloc_array(m * n > 0 ? m * n : 1, sizeof(double));
+    double *x = alloc_array(k ? k : 1, sizeof(double));
+    double *y = alloc_array(m ? m : 1, sizeof(double));
+    for (size_t i = 0; i < m * k; ++i) {
+        A[i] = elemValue(i, 7919);
+    }
+    for (size_t p = 0; p < k; ++p) {
+        x[p] = elemValue(p, 31);
+        for (size_t j = 0; j < n; ++j) {
+            B[p * n + j] = Bt[j * k + p] = elemValue(p * n + j, 104729);
+        }
+    }
+
+    const gemm_kernel_t *kernel = simd_gemm_kernel();
+    printf("A %zu x %zu, B %zu x %zu, %zu threads, micro-noyau %s %zu x %zu\n\n", m, k, k, n,
+           pool_size(pool_global()), kernel->name, kernel->mr, kernel->nr);
+
+    // GEMV : y = A x (8 octets de A lus par multiplication-addition)
+    double best;
+    bool ok, all_ok = true;
+    TIME_BEST(for (size_t i = 0; i < m; ++i) y[i] = dotprod_blocks(k, 0, A + i * k, x), reps, best);
+    printf("gemv (dotprod_blocks par ligne) %10.6f s  %8.3f Go/s\n", best, m * k * sizeof(double) / best / 1e9);
+    TIME_BEST(dotprod_gemv(m, k, A, k, x, y), reps, best);
+    ok = rowClose(m, k, x, A, y);  // y[i] = ligne i de A . x
+    printf("gemv (dotprod_gemv)             %10.6f s  %8.3f Go/s  %s\n", best, m * k * sizeof(double) / best / 1e9,
+           ok ? "OK" : "ERREUR");
+    all_ok = all_ok && ok;
+
+    // GEMM : C = A B (2 m n k opérations flottantes)
+    double flops = 2.0 * m * n * k;
+    TIME_BEST(for (size_t i = 0; i < m; ++i) dotprod_gemv(n, k, Bt, k, A + i * k, C + i * n), reps, best);
+    printf("gemm (dotprod_gemv par ligne)   %10.6f s  %8.3f Gflop/s\n", best, flops / best / 1e9);
+    TIME_BEST(dotprod_gemm(m, n, k, A, k, B, n, C, n), reps, best);
+    ok = true;
+    size_t step = m > CHECK_ROWS ? m / CHECK_ROWS : 1;
+    for (size_t i = 0; i < m && ok; i += step) {
+        ok = rowClose(n, k, A + i * k, Bt, C + i * n);
+    }
+    printf("gemm (dotprod_gemm)             %10.6f s  %8.3f Gflop/s  %s\n", best, flops / best / 1e9,
+           ok ? "OK" : "ERREUR");
+    all_ok = all_ok && ok;
+
+    if (all_ok) {
+        printf("\nRésultat correct : OK\n");
+    } else {
+        printf("\nErreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    alloc_free(A);
+    alloc_free(B);
+    alloc_free(Bt);
+    alloc_free(C);
+    alloc_free(x);
+    alloc_free(y);
+
+    return 0;
+}
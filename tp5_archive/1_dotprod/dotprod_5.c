@@ -0,0 +1,112 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "sparse.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+
+// Valeurs par défaut (modifiables par `--n`/`--density`/`--reps` ou `SIZE_N`/`DENSITY`/`REPS`)
+#define N 10          // Dimension des vecteurs
+#define DENSITY 10    // Pourcentage d'éléments non nuls hors de la zone dense
+#define REPS 3        // Répétitions de chaque mesure (on garde la plus rapide)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Vecteur creux déséquilibré : le premier huitième est entièrement rempli, le reste
+ * contient environ `density` % d'éléments non nuls. Un découpage par indices
+ * donnerait presque tout le travail aux premiers blocs. Valeurs multiples de 1/64.
+ */
+static void fillSkewed(size_t n, size_t density, size_t prime, double *a) {
+    for (size_t i = 0; i < n; ++i) {
+        bool stored = i < n / 8 || (i * prime) % 100 < density;
+        a[i] = stored ? ((double)((i * prime) % 128) - 63.5) / 64.0 : 0.0;
+    }
+}
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+static double absDot(size_t n, const double *a, const double *b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+// Meilleur temps de `reps` exécutions de STMT
+#define TIME_BEST(STMT, reps, best)                 \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            STMT;                                   \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Produits scalaires creux-dense et creux-creux, comparés au produit dense des mêmes
+ * vecteurs (`dotprod_blocks`), et vérifiés avec `dotprod_ref` sur les vecteurs denses.
+ */
+int main(int argc, char **argv) {
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t density = arg_size(argc, argv, "density", "DENSITY", DENSITY);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    reps = reps ? reps : 1;
+    density = density < 100 ? density : 100;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *a = alloc_array(n, sizeof(double));
+    double *b = alloc_array(n, sizeof(double));
+    fillSkewed(n, density, 7919, a);
+    fillSkewed(n, density, 104729, b);
+    sparse_vec_t sa = sparse_vec_from_dense(n, a);
+    sparse_vec_t sb = sparse_vec_from_dense(n, b);
+
+    printf("n = %zu, %zu et %zu éléments non nuls, %zu threads\n\n", n, sa.nnz, sb.nnz,
+           pool_size(pool_global()));
+
+    double ref = dotprod_ref(n, a, b);
+    double tol = n * DBL_EPSILON * fmax(1., absDot(n, a, b));
+    double best, res;
+    bool ok, all_ok = true;
+
+    TIME_BEST(res = dotprod_blocks(n, 0, a, b), reps, best);
+    printf("dense        (dotprod_blocks)       %10.6f s  %.6f\n", best, res);
+
+    TIME_BEST(res = dotprod_sparse_dense(&sa, b), reps, best);
+    ok = fabs(res - ref) <= tol;
+    printf("creux-dense  (dotprod_sparse_dense) %10.6f s  %.6f  %s\n", best, res, ok ? "OK" : "ERREUR");
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res = dotprod_sparse(&sa, &sb), reps, best);
+    ok = fabs(res - ref) <= tol;
+    printf("creux-creux  (dotprod_sparse)       %10.6f s  %.6f  %s\n", best, res, ok ? "OK" : "ERREUR");
+    all_ok = all_ok && ok;
+
+    printf("référence    (dotprod_ref)                       %.6f\n", ref);
+
+    if (all_ok) {
+        printf("\nRésultat correct : OK\n");
+    } else {
+        printf("\nErreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    sparse_vec_free(&sa);
+    sparse_vec_free(&sb);
+    alloc_free(a);
+    alloc_free(b);
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+
+// Valeurs par défaut (modifiables par `--count`/`--n` ou `BATCH_COUNT`/`SIZE_N`)
+#define COUNT 8       // Nombre de produits scalaires soumis
+#define N 10          // Longueur de chaque paire
+#define PRINT_MAX 16  // Nombre maximal de résultats affichés
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Valeur pseudo-aléatoire de [-1, 1], multiple de 1/64 (produits exacts).
+ */
+static double elemValue(size_t i, size_t prime) {
+    return ((double)((i * prime) % 129) - 64.0) / 64.0;
+}
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+static double absDot(size_t n, const double *a, const double *b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+// Nombre de résultats reçus par la fonction de rappel
+static atomic_size_t callbacks = 0;
+
+/**
+ * Fonction de rappel : ranger le résultat dans la case désignée par `user`.
+ */
+static void storeResult(pool_future_t *future, double value, void *user) {
+    (void)future;
+    *(double *)user = value;
+    atomic_fetch_add_explicit(&callbacks, 1, memory_order_relaxed);
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * `count` produits scalaires indépendants, d'abord l'un après l'autre (`dotprod_blocks`
+ * puis `dotprod_ref` sur le thread appelant), puis soumis d'un coup par
+ * `dotprod_blocks_async` : le thread appelant calcule les références pendant que le pool
+ * traite les futurs. Les résultats des futurs (attente et fonction de rappel) sont
+ * comparés aux références.
+ */
+int main(int argc, char **argv) {
+    size_t count = arg_size(argc, argv, "count", "BATCH_COUNT", COUNT);  // Nombre de paires
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);                   // Longueur d'une paire
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *a = alloc_array(count * n, sizeof(double));
+    double *b = alloc_array(count * n, sizeof(double));
+    for (size_t i = 0; i < count * n; ++i) {
+        a[i] = elemValue(i, 7919);
+        b[i] = elemValue(i, 104729);
+    }
+    double *ref = alloc_array(count, sizeof(double));
+    double *sync = alloc_array(count, sizeof(double));
+    double *called = alloc_array(count, sizeof(double));
+    pool_future_t **futures = alloc_array(count, sizeof(pool_future_t *));
+
+    printf("%zu paires de %zu éléments, %zu threads\n", count, n, pool_size(pool_global()));
+
+    // Un appel bloquant par paire, puis le travail du thread appelant
+    double t0 = timer_now();
+    for (size_t i = 0; i < count; ++i) {
+        sync[i] = dotprod_blocks(n, 0, a + i * n, b + i * n);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ref[i] = dotprod_ref(n, a + i * n, b + i * n);
+    }
+    double t_sync = timer_now() - t0;
+
+    // Toutes les paires soumises, le travail du thread appelant recouvre les calculs
+    t0 = timer_now();
+    for (size_t i = 0; i < count; ++i) {
+        futures[i] = dotprod_blocks_async(n, 0, a + i * n, b + i * n, storeResult, &called[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ref[i] = dotprod_ref(n, a + i * n, b + i * n);
+    }
+    size_t ready = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ready += pool_future_poll(futures[i]);
+    }
+    double *res = alloc_array(count, sizeof(double));
+    for (size_t i = 0; i < count; ++i) {
+        res[i] = pool_future_wait(futures[i]);
+    }
+    double t_async = timer_now() - t0;
+
+    printf("Temps : bloquant %.6f s, asynchrone %.6f s (%zu futurs prêts avant l'attente)\n", t_sync, t_async,
+           ready);
+
+    bool ok = atomic_load(&callbacks) == count;
+    for (size_t i = 0; i < count; ++i) {
+        double threshold = n * DBL_EPSILON * fmax(1., absDot(n, a + i * n, b + i * n));
+        bool pair_ok = fabs(ref[i] - res[i]) <= threshold && fabs(ref[i] - sync[i]) <= threshold &&
+                       res[i] == called[i];
+        if (i < PRINT_MAX || !pair_ok) {
+            printf("Paire %zu : référence = %.17g, futur = %.17g%s\n", i, ref[i], res[i], pair_ok ? "" : " (ERREUR)");
+        }
+        ok = ok && pair_ok;
+        pool_future_free(futures[i]);
+    }
+
+    if (ok) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    alloc_free(res);
+    alloc_free(futures);
+    alloc_free(called);
+    alloc_free(sync);
+    alloc_free(ref);
+    alloc_free(b);
+    alloc_free(a);
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_dot.h"
+#include "alloc.h"
+#include "dotprod.h"
+
+// ========================= DESCRIPTION D'UN LOT =================================
+
+/**
+ * Paires du lot, partagées (en lecture seule) par toutes les tâches.
+ */
+typedef struct {
+    double *const *a;      // Premiers vecteurs de chaque paire
+    double *const *b;      // Seconds vecteurs de chaque paire
+    const size_t *n;       // Longueur de chaque paire
+    double *out;           // Résultat de chaque paire
+    sum_mode_t sum;        // Mode de sommation
+} Batch;
+
+/**
+ * Tâche du lot : soit un groupe de petites paires consécutives [first, last) traitées
+ * entièrement (résultats écrits directement dans `out`), soit un morceau [start, end)
+ * d'une longue paire `first`, dont le résultat partiel va dans la case `partial`.
+ * Chaque structure commence sur sa propre ligne de cache.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) const Batch *batch; // Lot concerné
+    size_t first;          // Première paire du groupe (ou paire du morceau)
+    size_t last;           // Fin du groupe (exclue)
+    size_t start;          // Index de début du morceau
+    size_t end;            // Index de fin du morceau
+    padded_double_t *partial; // Case du morceau (NULL pour un groupe de paires entières)
+} BatchTask;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Produit scalaire d'une paire ou d'un morceau de paire, selon le mode de sommation.
+ */
+static void dot_range(const Batch *batch, size_t p, size_t start, size_t end, padded_double_t *slot) {
+    const double *a = batch->a[p] + start, *b = batch->b[p] + start;
+    slot->error = 0.0;
+    if (batch->sum == SUM_COMPENSATED) {
+        slot->value = simd_dot_compensated(end - start, a, b, &slot->error);
+    } else {
+        slot->value = simd_dot(end - start, a, b);
+    }
+}
+
+static void *compute_batch_task(void *arg) {
+    BatchTask *task = (BatchTask *)arg;
+    const Batch *batch = task->batch;
+
+    if (task->partial) {
+        dot_range(batch, task->first, task->start, task->end, task->partial);
+        return NULL;
+    }
+
+    for (size_t p = task->first; p < task->last; ++p) {
+        padded_double_t r;
+        dot_range(batch, p, 0, batch->n[p], &r);
+        batch->out[p] = r.value + r.error;
+    }
+    return NULL;
+}
+
+// ============================ FONCTIONS DE CALCUL ==============================
+
+/**
+ * Nombre de morceaux d'une paire de `n` éléments (1 si elle est traitée d'un seul tenant).
+ */
+static size_t pair_pieces(size_t n, size_t piece) {
+    return n <= piece ? 1 : partition_count(n, piece, 1, 2 * sizeof(double));
+}
+
+/**
+ * Produits scalaires d'un lot de paires en un seul passage du pool.
+ * La charge totale (somme des longueurs) est découpée comme un seul long vecteur
+ * (voir `partition.h`) : les paires plus longues qu'un bloc sont coupées en morceaux,
+ * les paires plus courtes sont regroupées jusqu'à former un bloc. Toutes les tâches
+ * sont soumises par un unique `pool_run`, donc une seule attente pour tout le lot,
+ * puis les morceaux de chaque paire sont combinés par un arbre.
+ * En sommation compensée, les paires sont coupées en blocs de SUM_REPRO_CHUNK éléments
+ * comme dans `dotprod_blocks` : chaque résultat est identique bit à bit à celui de
+ * `dotprod_blocks(n[i], 0, a[i], b[i])`, quel que soit le nombre de threads.
+ */
+void dotprod_batch(size_t count, double *const a[count], double *const b[count], const size_t n[count],
+                   double out[count]) {
+    Batch batch = { a, b, n, out, sum_get_mode() };
+
+    // Taille de bloc : celle du découpage automatique de la charge totale
+    size_t total = 0;
+    for (size_t p = 0; p < count; ++p) {
+        total += n[p];
+    }
+    size_t piece = SUM_REPRO_CHUNK;
+    if (batch.sum != SUM_COMPENSATED && total > 0) {
+        size_t nb_chunks = partition_count(total, 0, pool_size(pool_current()), 2 * sizeof(double));
+        piece = (total + nb_chunks - 1) / nb_chunks;
+    }
+
+    // Premier passage : nombre de tâches et de cases de morceaux
+    size_t nb_tasks = 0, nb_slots = 0, group = 0;
+    for (size_t p = 0; p < count; ++p) {
+        size_t pieces = pair_pieces(n[p], piece);
+        if (pieces > 1) {
+            nb_tasks += pieces + (group > 0);
+            nb_slots += pieces;
+            group = 0;
+        } else if ((group += n[p] + 1) >= piece) {
+            ++nb_tasks;
+            group = 0;
+        }
+    }
+    nb_tasks += group > 0;
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    BatchTask *tasks = arena_alloc(scratch, nb_tasks, sizeof(BatchTask));
+    padded_double_t *partials = arena_alloc(scratch, nb_slots, sizeof(padded_double_t));
+
+    // Second passage : groupes de petites paires et morceaux des longues paires
+    // (une paire vide compte pour un élément, pour borner la taille des groupes)
+    size_t t = 0, s = 0, first = 0;
+    group = 0;
+    for (size_t p = 0; p < count; ++p) {
+        size_t pieces = pair_pieces(n[p], piece);
+        if (pieces > 1) {
+            if (group > 0) {
+                tasks[t++] = (BatchTask){ &batch, first, p, 0, 0, NULL };
+            }
+            for (size_t i = 0; i < pieces; ++i, ++t) {
+                tasks[t] = (BatchTask){ &batch, p, p + 1, 0, 0, &partials[s++] };
+                partition_bounds(n[p], pieces, i, &tasks[t].start, &tasks[t].end);
+            }
+            group = 0;
+            first = p + 1;
+        } else if ((group += n[p] + 1) >= piece) {
+            tasks[t++] = (BatchTask){ &batch, first, p + 1, 0, 0, NULL };
+            group = 0;
+            first = p + 1;
+        }
+    }
+    if (group > 0) {
+        tasks[t++] = (BatchTask){ &batch, first, count, 0, 0, NULL };
+    }
+
+    // Tout le lot en un seul passage du pool
+    pool_run(pool_current(), nb_tasks, compute_batch_task, tasks, sizeof(BatchTask));
+
+    // Combinaison des morceaux de chaque longue paire, dans l'ordre des cases
+    s = 0;
+    for (size_t p = 0; p < count; ++p) {
+        size_t pieces = pair_pieces(n[p], piece);
+        if (pieces > 1) {
+            out[p] = batch.sum == SUM_COMPENSATED ? reduce_tree_compensated(pieces, &partials[s])
+                                                  : reduce_tree(pieces, &partials[s], REDUCE_SUM);
+            s += pieces;
+        }
+    }
+
+    arena_release(scratch, mark);
+}
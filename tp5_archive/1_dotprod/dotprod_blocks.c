@@ -0,0 +1,200 @@
+#include <stddef.h>
+#include <math.h>
+#include <pthread.h>
+#include <assert.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_dot.h"
+#include "alloc.h"
+#include "prefetch.h"
+#include "cutover.h"
+#include "gpu.h"
+#include "dotprod.h"
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Structure pour transmettre les paramètres nécessaires à chaque thread.
+ * Cette structure contient le contexte de réduction (somme partagée et son mutex,
+ * modes, case privée du résultat partiel), les indices du bloc et les tableaux concernés.
+ * Chaque structure commence sur sa propre ligne de cache (voir `reduce_ctx_t`).
+ */
+typedef struct {
+    reduce_ctx_t ctx;      // Contexte de réduction (aligné sur une ligne de cache)
+    size_t start;          // Index de début du bloc
+    size_t end;            // Index de fin du bloc
+    double *a;             // Pointeur vers le tableau `a`
+    double *b;             // Pointeur vers le tableau `b`
+    size_t prefetch;       // Distance de préchargement en octets (0 : préchargement matériel seul)
+    prefetch_hint_t hint;  // Indication de localité du préchargement
+} ThreadData;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Produit scalaire d'un bloc par pas de PREFETCH_STEP octets : avant chaque pas, les
+ * lignes de `a` et `b` situées `distance` octets plus loin sont demandées (les premières
+ * le sont avant la boucle, le début du bloc n'étant pas encore dans le cache).
+ */
+static double dot_prefetch(size_t n, const double *a, const double *b, size_t distance, prefetch_hint_t hint) {
+    size_t step = PREFETCH_STEP / sizeof(double);
+    size_t ahead = distance / sizeof(double);
+    size_t first = ahead < n ? ahead : n;
+    double sum = 0.0;
+
+    prefetch_segment(a, first, 1, hint);
+    prefetch_segment(b, first, 1, hint);
+    for (size_t i = 0; i < n; i += step) {
+        size_t len = n - i < step ? n - i : step;
+        if (ahead < n - i) {
+            size_t count = n - i - ahead < step ? n - i - ahead : step;
+            prefetch_segment(a + i + ahead, count, 1, hint);
+            prefetch_segment(b + i + ahead, count, 1, hint);
+        }
+        sum += simd_dot(len, a + i, b + i);
+    }
+
+    return sum;
+}
+
+/**
+ * Fonction de calcul exécutée par chaque thread.
+ * Chaque thread calcule le produit scalaire pour un bloc donné avec le noyau
+ * vectorisé le plus rapide disponible (voir `simd_dot.h`), avec un préchargement
+ * logiciel si une distance est fixée (voir `prefetch.h`), et le publie
+ * selon le mode de réduction (section critique protégée par un mutex en mode `mutex`).
+ * En sommation compensée, la somme et sa compensation sont écrites dans la case privée.
+ */
+void* compute_block(void *arg) {
+    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre reçu en `ThreadData`
+
+    size_t len = data->end - data->start;
+
+    // Sommation compensée : somme et compensation du bloc dans la case privée
+    if (data->ctx.sum == SUM_COMPENSATED) {
+        data->ctx.partial->value = simd_dot_compensated(len, data->a + data->start, data->b + data->start,
+                                                        &data->ctx.partial->error);
+        return NULL;
+    }
+
+    // Calcul du produit scalaire pour les éléments du bloc (avec préchargement logiciel si demandé)
+    double *a = data->a + data->start, *b = data->b + data->start;
+    double block_sum = data->prefetch ? dot_prefetch(len, a, b, data->prefetch, data->hint) : simd_dot(len, a, b);
+
+    // Publication de la somme du bloc
+    reduce_publish(&data->ctx, REDUCE_SUM, block_sum);
+
+    return NULL;  // Les threads renvoient NULL ici par convention
+}
+
+// ============================ FONCTIONS DE CALCUL ==============================
+
+/**
+ * Fonction parallèle pour calculer le produit scalaire.
+ * Les tableaux `a` et `b` sont divisés en blocs d'au plus `k` éléments, et chaque bloc
+ * est une tâche exécutée par le pool de threads persistant. Si `k` vaut 0, le nombre
+ * de blocs est choisi selon le nombre de cœurs et la taille du cache (voir `partition.h`).
+ * Le reste de la division de `n` par la taille de bloc n'est jamais perdu.
+ * En sommation compensée, le découpage automatique utilise des blocs de taille fixe
+ * (SUM_REPRO_CHUNK) combinés par un arbre fixe : le résultat est identique bit à bit
+ * quel que soit le nombre de threads.
+ * Avec le découpage automatique, les petits tableaux ne réveillent pas le pool : ils
+ * sont calculés sur le thread appelant par `dotprod_ref` ou `simd_dot`, selon les seuils
+ * de `cutover.h` (sauf en sommation compensée, qui garde ses blocs fixes). Compilé avec
+ * `USE_GPU`, le calcul est déporté sur le GPU pour des tableaux qui y résident (quels que
+ * soient `k` et la sommation), ou, avec le découpage automatique, assez grands pour que le
+ * transfert soit rentable (voir `gpu.h`).
+ */
+double dotprod_blocks(size_t n, size_t k, double a[n], double b[n]) {
+    // Tableaux sur le GPU, que le pool ne peut pas lire, quels que soient `k` et la
+    // sommation ; ou transfert rentable avec le découpage automatique : réduction sur le GPU
+    bool on_device = gpu_memory_kind(a) == GPU_MEM_DEVICE || gpu_memory_kind(b) == GPU_MEM_DEVICE;
+    if (on_device || (k == 0 && gpu_offload_dot(n, a, b))) {
+        return gpu_dot(n, a, b);
+    }
+
+    // Sommation compensée : réduction en arbre et blocs indépendants du nombre de threads
+    sum_mode_t sum_mode = sum_get_mode();
+    if (sum_mode == SUM_COMPENSATED && k == 0) {
+        k = SUM_REPRO_CHUNK;
+    }
+
+    // Petit problème : version séquentielle ou vectorielle sur le thread appelant
+    if (k == 0) {
+        switch (cutover_path(CUTOVER_DOT, n)) {
+        case EXEC_SERIAL: return dotprod_ref(n, a, b);
+        case EXEC_SIMD:   return simd_dot(n, a, b);
+        default:          break;
+        }
+    }
+
+    reduce_shared_t sum;  // Somme partagée et mutex pour en protéger l'accès
+
+    // Initialisation de la somme partagée à 0 et du mutex
+    reduce_shared_init(&sum, 0.0);
+
+    // Calcul du nombre de blocs nécessaires (2 doubles lus par élément)
+    size_t nb_threads = partition_count(n, k, pool_size(pool_current()), 2 * sizeof(double));
+    arena_t *scratch = arena_scratch();     // Données de travail de l'appel, sans allocation
+    arena_mark_t mark = arena_mark(scratch);
+    ThreadData *thread_data = arena_alloc(scratch, nb_threads, sizeof(ThreadData));   // Données de chaque bloc
+    padded_double_t *partials = arena_alloc(scratch, nb_threads, sizeof(padded_double_t)); // Résultats partiels (mode arbre)
+    reduce_mode_t mode = sum_mode == SUM_COMPENSATED ? REDUCE_TREE : reduce_get_mode();
+    size_t distance = prefetch_get_distance();
+    prefetch_hint_t hint = prefetch_get_hint();
+
+    // Préparation des blocs
+    for (size_t i = 0; i < nb_threads; ++i) {
+        // Début et fin du bloc (le reste est réparti sur les derniers blocs)
+        partition_bounds(n, nb_threads, i, &thread_data[i].start, &thread_data[i].end);
+        thread_data[i].a = a;               // Pointeur vers le tableau `a`
+        thread_data[i].b = b;               // Pointeur vers le tableau `b`
+        thread_data[i].prefetch = distance; // Distance de préchargement
+        thread_data[i].hint = hint;         // Indication de localité
+        thread_data[i].ctx.shared = &sum;   // Pointeur vers la somme partagée
+        thread_data[i].ctx.mode = mode;     // Mode de réduction
+        thread_data[i].ctx.partial = &partials[i]; // Case privée du bloc
+        thread_data[i].ctx.sum = sum_mode;  // Mode de sommation
+    }
+
+    // Traitement des blocs par le pool, puis attente de leur fin
+    pool_run(pool_current(), nb_threads, compute_block, thread_data, sizeof(ThreadData));
+
+    // Combinaison des sommes des blocs par un arbre (mode arbre uniquement)
+    if (sum_mode == SUM_COMPENSATED) {
+        sum.value = reduce_tree_compensated(nb_threads, partials);
+    } else if (mode == REDUCE_TREE) {
+        sum.value = reduce_tree(nb_threads, partials, REDUCE_SUM);
+    }
+
+    // Destruction du mutex et libération des données des blocs (nettoyage)
+    reduce_shared_destroy(&sum);
+    arena_release(scratch, mark);
+
+    return sum.value;  // Retourner la somme calculée
+}
+
+// ========================= SOUMISSION ASYNCHRONE ===============================
+
+/**
+ * Arguments de `dotprod_blocks`, copiés dans le futur.
+ */
+typedef struct {
+    size_t n;
+    size_t k;
+    double *a;
+    double *b;
+} DotAsyncArgs;
+
+static double run_dotprod_blocks(void *arg) {
+    DotAsyncArgs *args = (DotAsyncArgs *)arg;
+    return dotprod_blocks(args->n, args->k, args->a, args->b);
+}
+
+pool_future_t *dotprod_blocks_async(size_t n, size_t k, double a[n], double b[n], pool_callback_fn callback,
+                                    void *user) {
+    DotAsyncArgs args = { n, k, a, b };
+    return pool_async(pool_current(), run_dotprod_blocks, &args, sizeof(args), callback, user);
+}
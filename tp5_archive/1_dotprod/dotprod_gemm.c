@@ -0,0 +1,216 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_gemm.h"
+#include "alloc.h"
+#include "dotprod.h"
+
+// Blocage (voir `dotprod_gemm`) : profondeur d'un panneau et largeur d'un panneau de `B`
+#define GEMM_KC 384
+#define GEMM_NC 3072  // Multiple des largeurs de tuile 4, 8 et 24
+
+// ======================== STRUCTURES POUR LES THREADS ==========================
+
+/**
+ * Bloc de `A` rangé par un thread, conservé tant que ses tâches portent sur le même bloc.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) double *packed; // Panneaux de `A` (mc x kc)
+    size_t step;           // Étape (jc, pc) du bloc rangé (0 : aucun)
+    size_t block;          // Bloc de lignes rangé
+} PackedA;
+
+/**
+ * Description d'une étape (jc, pc) : produit du panneau `A[:, pc:pc+kc]` par le
+ * panneau rangé de `B` (kc x nc), ajouté aux colonnes [jc, jc + nc) de `C`.
+ */
+typedef struct {
+    const gemm_kernel_t *kernel; // Micro-noyau et dimensions de sa tuile
+    const double *A;       // Première colonne du panneau de `A`
+    size_t lda;            // Distance entre deux lignes de `A`
+    const double *B;       // Bloc de `B` à ranger (kc x nc)
+    size_t ldb;            // Distance entre deux lignes de `B`
+    double *packed_b;      // Panneau de `B` rangé
+    double *C;             // Première colonne du bloc de `C`
+    size_t ldc;            // Distance entre deux lignes de `C`
+    size_t m;              // Nombre de lignes de `A` et de `C`
+    size_t kc;             // Profondeur du panneau
+    size_t nc;             // Colonnes du panneau de `B`
+    size_t mc;             // Lignes d'un bloc de `A` (multiple de mr)
+    size_t nb_slivers;     // Tranches de `nr` colonnes du panneau de `B`
+    size_t nb_col_chunks;  // Groupes de tranches par bloc de lignes
+    size_t step;           // Numéro de l'étape (à partir de 1)
+    bool add;              // Ajouter à `C` (toutes les étapes sauf la première en profondeur)
+    PackedA *packed_a;     // Blocs de `A` rangés, un par thread
+} GemmStep;
+
+/**
+ * Tâche : une plage de tranches à ranger, ou un bloc de lignes et un groupe de tranches.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) const GemmStep *step; // Étape courante
+    size_t first;          // Première tranche (rangement) ou indice de la tâche (calcul)
+    size_t last;           // Fin de la plage de tranches (rangement)
+} GemmTask;
+
+// ======================= FONCTIONS EXECUTÉES PAR LES THREADS ===================
+
+/**
+ * Ranger les tranches [first, last) du panneau de `B`.
+ */
+static void *pack_slivers(void *arg) {
+    GemmTask *task = (GemmTask *)arg;
+    const GemmStep *s = task->step;
+    size_t nr = s->kernel->nr;
+    size_t j0 = task->first * nr;
+    size_t j1 = task->last * nr < s->nc ? task->last * nr : s->nc;
+
+    gemm_pack_b(s->kc, j1 - j0, s->B + j0, s->ldb, nr, s->packed_b + task->first * nr * s->kc);
+    return NULL;
+}
+
+/**
+ * Bloc de lignes `ib` et groupe de tranches : ranger le bloc de `A` (si ce thread ne
+ * l'a pas déjà fait à cette étape), puis appeler le micro-noyau sur chaque tuile.
+ * Les tuiles du bord de `C` passent par une tuile complète temporaire.
+ */
+static void *compute_panel(void *arg) {
+    GemmTask *task = (GemmTask *)arg;
+    const GemmStep *s = task->step;
+    const gemm_kernel_t *k = s->kernel;
+    size_t ib = task->first / s->nb_col_chunks;
+    size_t chunk = task->first % s->nb_col_chunks;
+
+    size_t i0 = ib * s->mc;
+    size_t mc = s->m - i0 < s->mc ? s->m - i0 : s->mc;
+    PackedA *pa = &s->packed_a[pool_worker_index()];
+    if (pa->step != s->step || pa->block != ib) {
+        gemm_pack_a(mc, s->kc, s->A + i0 * s->lda, s->lda, k->mr, pa->packed);
+        pa->step = s->step;
+        pa->block = ib;
+    }
+
+    size_t first, last;
+    partition_bounds(s->nb_slivers, s->nb_col_chunks, chunk, &first, &last);
+
+    double tile[GEMM_MR_MAX * GEMM_NR_MAX];
+    for (size_t js = first; js < last; ++js) {
+        size_t j0 = js * k->nr;
+        size_t w = s->nc - j0 < k->nr ? s->nc - j0 : k->nr;
+        const double *b = s->packed_b + js * k->nr * s->kc;
+
+        for (size_t ir = 0; ir < mc; ir += k->mr) {
+            size_t h = mc - ir < k->mr ? mc - ir : k->mr;
+            const double *a = pa->packed + ir * s->kc;
+            double *c = s->C + (i0 + ir) * s->ldc + j0;
+
+            if (h == k->mr && w == k->nr) {
+                k->fn(s->kc, a, b, c, s->ldc, s->add);
+                continue;
+            }
+            k->fn(s->kc, a, b, tile, k->nr, false);
+            for (size_t r = 0; r < h; ++r) {
+                for (size_t j = 0; j < w; ++j) {
+                    double v = tile[r * k->nr + j];
+                    c[r * s->ldc + j] = s->add ? c[r * s->ldc + j] + v : v;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// ============================ FONCTION DE CALCUL ===============================
+
+/**
+ * Produit matrice-matrice parallèle par blocs (schéma de Goto) :
+ *  - `B` est parcourue en panneaux de GEMM_KC x GEMM_NC, rangés une fois par étape
+ *    pour être lus de façon contiguë (panneau partagé, dans le cache de dernier niveau) ;
+ *  - les lignes de `A` sont découpées en blocs de mc x GEMM_KC tenant dans la moitié du
+ *    cache L2, rangés par le thread qui les utilise ;
+ *  - le micro-noyau de `simd_gemm.h` garde une tuile mr x nr de `C` en registres.
+ * Les tâches (bloc de lignes, groupe de tranches de colonnes) sont au moins aussi
+ * nombreuses que les threads, même pour une matrice `A` de peu de lignes ; chaque
+ * élément de `C` est calculé dans un ordre fixe, indépendant du nombre de threads.
+ */
+void dotprod_gemm(size_t m, size_t n, size_t k, const double *A, size_t lda, const double *B, size_t ldb,
+                  double *C, size_t ldc) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0) {
+        for (size_t i = 0; i < m; ++i) {
+            memset(C + i * ldc, 0, n * sizeof(double));
+        }
+        return;
+    }
+
+    const gemm_kernel_t *kernel = simd_gemm_kernel();
+    thread_pool_t *pool = pool_current();
+    size_t nb_threads = pool_size(pool);
+
+    // Bloc de `A` dans la moitié du L2, arrondi à un multiple de mr
+    size_t kc_max = k < GEMM_KC ? k : GEMM_KC;
+    size_t mc = cache_l2_size() / 2 / (kc_max * sizeof(double)) / kernel->mr * kernel->mr;
+    mc = mc ? mc : kernel->mr;
+    size_t m_rounded = (m + kernel->mr - 1) / kernel->mr * kernel->mr;
+    mc = mc < m_rounded ? mc : m_rounded;
+    size_t nb_row_blocks = (m + mc - 1) / mc;
+
+    size_t nc_max = n < GEMM_NC ? n : GEMM_NC;
+    size_t slivers_max = (nc_max + kernel->nr - 1) / kernel->nr;
+    double *packed_b = alloc_array(slivers_max * kernel->nr * kc_max, sizeof(double));
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    PackedA *packed_a = arena_alloc(scratch, nb_threads, sizeof(PackedA));
+    for (size_t t = 0; t < nb_threads; ++t) {
+        packed_a[t].packed = alloc_array(mc * kc_max, sizeof(double));
+        packed_a[t].step = 0;
+    }
+    GemmTask *tasks = arena_alloc(scratch, nb_row_blocks * nb_threads + slivers_max, sizeof(GemmTask));
+
+    GemmStep step = { .kernel = kernel, .lda = lda, .ldb = ldb, .ldc = ldc, .m = m, .mc = mc,
+                      .packed_b = packed_b, .packed_a = packed_a };
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        step.nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        step.nb_slivers = (step.nc + kernel->nr - 1) / kernel->nr;
+        step.nb_col_chunks = nb_threads < step.nb_slivers ? nb_threads : step.nb_slivers;
+        step.C = C + jc;
+
+        for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+            step.kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            step.A = A + pc;
+            step.B = B + pc * ldb + jc;
+            step.add = pc > 0;
+            step.step++;
+
+            // Rangement du panneau de `B`, découpé comme un tableau de kc x nc éléments
+            size_t nb_pack = partition_count(step.kc * step.nc, 0, nb_threads, sizeof(double));
+            nb_pack = nb_pack < step.nb_slivers ? nb_pack : step.nb_slivers;
+            for (size_t t = 0; t < nb_pack; ++t) {
+                tasks[t].step = &step;
+                partition_bounds(step.nb_slivers, nb_pack, t, &tasks[t].first, &tasks[t].last);
+            }
+            pool_run(pool, nb_pack, pack_slivers, tasks, sizeof(GemmTask));
+
+            // Produit : une tâche par bloc de lignes et groupe de tranches
+            size_t nb_tasks = nb_row_blocks * step.nb_col_chunks;
+            for (size_t t = 0; t < nb_tasks; ++t) {
+                tasks[t].step = &step;
+                tasks[t].first = t;
+            }
+            pool_run(pool, nb_tasks, compute_panel, tasks, sizeof(GemmTask));
+        }
+    }
+
+    for (size_t t = 0; t < nb_threads; ++t) {
+        alloc_free(packed_a[t].packed);
+    }
+    alloc_free(packed_b);
+    arena_release(scratch, mark);
+}
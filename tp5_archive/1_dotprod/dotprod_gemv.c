@@ -0,0 +1,82 @@
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_dot.h"
+#include "alloc.h"
+#include "dotprod.h"
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Bloc de lignes de `A` traité par une tâche (chaque tâche sur sa ligne de cache).
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) const double *A; // Matrice (lignes distantes de `lda`)
+    const double *x;       // Vecteur multiplié
+    double *y;             // Résultat
+    size_t n;              // Nombre de colonnes
+    size_t lda;            // Distance entre deux lignes de `A`
+    size_t start;          // Première ligne du bloc
+    size_t end;            // Fin du bloc (exclue)
+    size_t panel;          // Largeur d'un panneau de colonnes
+} GemvTask;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Produits scalaires des lignes du bloc avec `x`, par le noyau vectorisé `simd_dot`.
+ * Les colonnes sont parcourues par panneaux : le morceau de `x` d'un panneau est relu
+ * depuis le cache pour toutes les lignes du bloc, seule `A` vient de la mémoire.
+ */
+static void *compute_rows(void *arg) {
+    GemvTask *task = (GemvTask *)arg;
+
+    for (size_t j0 = 0; j0 < task->n; j0 += task->panel) {
+        size_t w = task->n - j0 < task->panel ? task->n - j0 : task->panel;
+        for (size_t i = task->start; i < task->end; ++i) {
+            double part = simd_dot(w, task->A + i * task->lda + j0, task->x + j0);
+            task->y[i] = j0 == 0 ? part : task->y[i] + part;
+        }
+    }
+
+    return NULL;
+}
+
+// ============================ FONCTION DE CALCUL ===============================
+
+/**
+ * Produit matrice-vecteur parallèle. Les lignes sont réparties en blocs par le même
+ * découpage que `dotprod_blocks` (chaque bloc de `A` tient dans la moitié du cache L2) ;
+ * un panneau de `x` occupe au plus un quart du L2. Chaque `y[i]` est calculé par une
+ * seule tâche, dans un ordre fixe : le résultat ne dépend pas du nombre de threads.
+ */
+void dotprod_gemv(size_t m, size_t n, const double *A, size_t lda, const double *x, double *y) {
+    if (m == 0) {
+        return;
+    }
+    if (n == 0) {
+        for (size_t i = 0; i < m; ++i) {
+            y[i] = 0.0;
+        }
+        return;
+    }
+
+    // Découpage sur les éléments de `A`, arrondi à des lignes entières
+    size_t nb_blocks = partition_count(m * n, 0, pool_size(pool_current()), sizeof(double));
+    nb_blocks = nb_blocks < m ? nb_blocks : m;
+    size_t panel = cache_l2_size() / 4 / sizeof(double);
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    GemvTask *tasks = arena_alloc(scratch, nb_blocks, sizeof(GemvTask));
+    for (size_t b = 0; b < nb_blocks; ++b) {
+        tasks[b] = (GemvTask){ A, x, y, n, lda, 0, 0, panel };
+        partition_bounds(m, nb_blocks, b, &tasks[b].start, &tasks[b].end);
+    }
+
+    pool_run(pool_current(), nb_blocks, compute_rows, tasks, sizeof(GemvTask));
+
+    arena_release(scratch, mark);
+}
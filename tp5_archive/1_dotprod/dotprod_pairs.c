@@ -0,0 +1,111 @@
+#include <stddef.h>
+#include <math.h>
+#include <pthread.h>
+#include <assert.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "simd_dot.h"
+#include "cutover.h"
+#include "dotprod.h"
+
+// ========================= STRUCTURE POUR LES THREADS ============================
+
+// Structure utilisée pour transmettre les paramètres nécessaires à chaque thread
+// (chaque structure commence sur sa propre ligne de cache, voir `reduce_ctx_t`)
+typedef struct {
+    reduce_ctx_t ctx;      // Contexte de réduction (somme partagée, modes, case privée)
+    size_t index;          // Index de l'élément du tableau à traiter
+    double *a;             // Pointeur vers le tableau `a`
+    double *b;             // Pointeur vers le tableau `b`
+} ThreadData;
+
+// ======================== FONCTION EXECUTÉE PAR LES THREADS ======================
+
+/**
+ * Fonction de calcul exécutée par chaque thread.
+ * Elle calcule le produit de deux éléments des tableaux `a` et `b` pour un index donné,
+ * et publie ce produit selon le mode de réduction : ajout à la somme partagée sous mutex
+ * (référence), ajout atomique, ou écriture dans sa case privée. En sommation compensée,
+ * l'erreur d'arrondi exacte du produit est aussi conservée dans la case privée.
+ */
+void* compute_product(void *arg) {
+    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre reçu en `ThreadData`
+
+    // Calcul du produit de deux éléments des tableaux
+    double product = data->a[data->index] * data->b[data->index];
+
+    // Sommation compensée : produit et erreur exacte dans la case privée
+    if (data->ctx.sum == SUM_COMPENSATED) {
+        data->ctx.partial->value = product;
+        data->ctx.partial->error = fma(data->a[data->index], data->b[data->index], -product);
+        return NULL;
+    }
+
+    // Publier le produit (section critique protégée par un mutex en mode `mutex`)
+    reduce_publish(&data->ctx, REDUCE_SUM, product);
+
+    return NULL;  // Les threads renvoient NULL par convention ici
+}
+
+// =========================== FONCTIONS DE CALCUL ================================
+
+/**
+ * Fonction de calcul parallèle du produit scalaire.
+ * Chaque tâche calcule une contribution individuelle, qui est ensuite accumulée
+ * selon le mode de réduction courant (voir `reduce.h`). Les tâches sont exécutées
+ * par le pool de threads persistant. En sommation compensée, les produits sont
+ * combinés par un arbre fixe : le résultat ne dépend pas du nombre de threads.
+ * Hors sommation compensée, les petits tableaux ne réveillent pas le pool : ils sont
+ * calculés sur le thread appelant par `dotprod_ref` ou `simd_dot`, selon les seuils de
+ * `cutover.h` (ceux de `dotprod_blocks`).
+ */
+double dotprod_pairs(size_t n, double a[n], double b[n]) {
+    // Petit problème : version séquentielle ou vectorielle sur le thread appelant
+    sum_mode_t sum_mode = sum_get_mode();
+    if (sum_mode != SUM_COMPENSATED) {
+        switch (cutover_path(CUTOVER_DOT, n)) {
+        case EXEC_SERIAL: return dotprod_ref(n, a, b);
+        case EXEC_SIMD:   return simd_dot(n, a, b);
+        default:          break;
+        }
+    }
+
+    reduce_shared_t sum;  // Somme partagée et mutex pour en protéger l'accès
+    arena_t *scratch = arena_scratch();  // Données de travail de l'appel, sans allocation
+    arena_mark_t mark = arena_mark(scratch);
+    ThreadData *thread_data = arena_alloc(scratch, n, sizeof(ThreadData));  // Données des tâches
+    padded_double_t *partials = arena_alloc(scratch, n, sizeof(padded_double_t));  // Résultats partiels (mode arbre)
+    reduce_mode_t mode = sum_mode == SUM_COMPENSATED ? REDUCE_TREE : reduce_get_mode();
+
+    // Initialisation de la somme partagée à 0 et du mutex
+    reduce_shared_init(&sum, 0.0);
+
+    // Préparation d'une tâche par élément du tableau
+    for (size_t i = 0; i < n; ++i) {
+        thread_data[i].index = i;        // Définir l'index de la tâche
+        thread_data[i].a = a;           // Passer le tableau `a`
+        thread_data[i].b = b;           // Passer le tableau `b`
+        thread_data[i].ctx.shared = &sum; // Passer la somme partagée
+        thread_data[i].ctx.mode = mode; // Passer le mode de réduction
+        thread_data[i].ctx.partial = &partials[i]; // Passer la case privée
+        thread_data[i].ctx.sum = sum_mode; // Passer le mode de sommation
+    }
+
+    // Exécution des tâches `compute_product` par le pool, puis attente de leur fin
+    pool_run(pool_current(), n, compute_product, thread_data, sizeof(ThreadData));
+
+    // Combinaison des résultats partiels par un arbre (mode arbre uniquement)
+    if (sum_mode == SUM_COMPENSATED) {
+        sum.value = reduce_tree_compensated(n, partials);
+    } else if (mode == REDUCE_TREE) {
+        sum.value = reduce_tree(n, partials, REDUCE_SUM);
+    }
+
+    // Destruction du mutex et libération des données des tâches (nettoyage)
+    reduce_shared_destroy(&sum);
+    arena_release(scratch, mark);
+
+    return sum.value;  // Retourner la somme calculée
+}
@@ -1,5 +1,7 @@
 #include <stddef.h>
 
+#include "dotprod.h"
+
 double dotprod_ref(size_t n, double a[n], double b[n]) {
   double sum = 0.;
 
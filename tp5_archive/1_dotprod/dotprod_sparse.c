@@ -0,0 +1,168 @@
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "alloc.h"
+#include "sparse.h"
+#include "dotprod.h"
+
+// ======================== STRUCTURES POUR LES THREADS ==========================
+
+/**
+ * Morceau d'un produit scalaire creux : éléments [a_start, a_end) de `a` et, pour le
+ * produit creux-creux, [b_start, b_end) de `b`. Chaque tâche est sur sa ligne de cache
+ * et garde son résultat, les résultats sont combinés dans l'ordre des morceaux.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) const sparse_vec_t *a; // Vecteur creux
+    const sparse_vec_t *b; // Second vecteur creux (produit creux-creux)
+    const double *dense;   // Vecteur dense (produit creux-dense)
+    size_t a_start;        // Premier élément stocké de `a`
+    size_t a_end;          // Fin (exclue)
+    size_t b_start;        // Premier élément stocké de `b`
+    size_t b_end;          // Fin (exclue)
+    double result;         // Produit scalaire du morceau
+} SparseTask;
+
+// ======================= FONCTIONS EXECUTÉES PAR LES THREADS ===================
+
+/**
+ * Somme des a.value[k] * dense[a.index[k]] du morceau, sur quatre accumulateurs.
+ */
+static void *compute_sparse_dense(void *arg) {
+    SparseTask *task = (SparseTask *)arg;
+    const size_t *index = task->a->index;
+    const double *value = task->a->value;
+    const double *x = task->dense;
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t k = task->a_start;
+
+    for (; k + 4 <= task->a_end; k += 4) {
+        s0 += value[k] * x[index[k]];
+        s1 += value[k + 1] * x[index[k + 1]];
+        s2 += value[k + 2] * x[index[k + 2]];
+        s3 += value[k + 3] * x[index[k + 3]];
+    }
+    for (; k < task->a_end; ++k) {
+        s0 += value[k] * x[index[k]];
+    }
+
+    task->result = (s0 + s1) + (s2 + s3);
+    return NULL;
+}
+
+/**
+ * Fusion des indices triés des deux morceaux : seuls les indices communs contribuent.
+ */
+static void *compute_sparse_sparse(void *arg) {
+    SparseTask *task = (SparseTask *)arg;
+    const size_t *ia = task->a->index, *ib = task->b->index;
+    const double *va = task->a->value, *vb = task->b->value;
+    size_t i = task->a_start, j = task->b_start;
+    double sum = 0.0;
+
+    while (i < task->a_end && j < task->b_end) {
+        if (ia[i] < ib[j]) {
+            ++i;
+        } else if (ia[i] > ib[j]) {
+            ++j;
+        } else {
+            sum += va[i++] * vb[j++];
+        }
+    }
+
+    task->result = sum;
+    return NULL;
+}
+
+// ============================ FONCTIONS DE CALCUL ==============================
+
+/**
+ * Combiner les résultats des morceaux dans l'ordre, puis rendre les tâches à l'arène.
+ */
+static double sum_tasks(size_t nb_tasks, SparseTask *tasks, arena_t *scratch, arena_mark_t mark) {
+    double sum = 0.0;
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        sum += tasks[t].result;
+    }
+    arena_release(scratch, mark);
+    return sum;
+}
+
+/**
+ * Produit scalaire d'un vecteur creux et d'un vecteur dense. Les éléments stockés de `a`
+ * sont découpés comme un tableau dense par `partition_count` (un indice, une valeur et
+ * un élément de `b` lus par élément) : la charge ne dépend que du nombre d'éléments
+ * stockés, pas de leur position. Défini dans `dotprod_sparse.c`.
+ */
+double dotprod_sparse_dense(const sparse_vec_t *a, const double *b) {
+    size_t nb_tasks = partition_count(a->nnz, 0, pool_size(pool_current()), sizeof(size_t) + 2 * sizeof(double));
+    if (nb_tasks == 0) {
+        return 0.0;
+    }
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    SparseTask *tasks = arena_alloc(scratch, nb_tasks, sizeof(SparseTask));
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        tasks[t] = (SparseTask){ .a = a, .dense = b };
+        partition_bounds(a->nnz, nb_tasks, t, &tasks[t].a_start, &tasks[t].a_end);
+    }
+
+    pool_run(pool_current(), nb_tasks, compute_sparse_dense, tasks, sizeof(SparseTask));
+    return sum_tasks(nb_tasks, tasks, scratch, mark);
+}
+
+/**
+ * Point de coupure de la fusion de `a` et `b` après `d` éléments (chemin de fusion) :
+ * `*i` éléments de `a` et `*j = d - *i` de `b` précèdent la coupure, les égalités
+ * étant départagées en faveur de `a`. Si la coupure sépare deux indices égaux,
+ * l'élément de `b` est ramené avant elle : une paire n'est jamais coupée en deux.
+ */
+static void merge_split(const sparse_vec_t *a, const sparse_vec_t *b, size_t d, size_t *i, size_t *j) {
+    size_t lo = d > b->nnz ? d - b->nnz : 0;
+    size_t hi = d < a->nnz ? d : a->nnz;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a->index[mid] <= b->index[d - mid - 1]) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *i = lo;
+    *j = d - lo;
+    if (*i > 0 && *j < b->nnz && a->index[*i - 1] == b->index[*j]) {
+        ++*j;
+    }
+}
+
+/**
+ * Produit scalaire de deux vecteurs creux par fusion de leurs indices triés. Le travail
+ * est découpé selon le chemin de fusion : chaque tâche traite la même quantité
+ * d'éléments de `a` et de `b` réunis, où qu'ils se trouvent. Défini dans `dotprod_sparse.c`.
+ */
+double dotprod_sparse(const sparse_vec_t *a, const sparse_vec_t *b) {
+    size_t total = a->nnz + b->nnz;
+    size_t nb_tasks = partition_count(total, 0, pool_size(pool_current()), sizeof(size_t) + sizeof(double));
+    if (a->nnz == 0 || b->nnz == 0) {
+        return 0.0;
+    }
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    SparseTask *tasks = arena_alloc(scratch, nb_tasks, sizeof(SparseTask));
+    size_t i = 0, j = 0;
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        size_t start, end, i_end, j_end;
+        partition_bounds(total, nb_tasks, t, &start, &end);
+        merge_split(a, b, end, &i_end, &j_end);
+        tasks[t] = (SparseTask){ .a = a, .b = b, .a_start = i, .a_end = i_end, .b_start = j, .b_end = j_end };
+        i = i_end;
+        j = j_end;
+    }
+
+    pool_run(pool_current(), nb_tasks, compute_sparse_sparse, tasks, sizeof(SparseTask));
+    return sum_tasks(nb_tasks, tasks, scratch, mark);
+}
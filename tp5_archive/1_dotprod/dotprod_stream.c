@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "args.h"
+#include "mapfile.h"
+#include "stream.h"
+
+// Taille d'un bloc lu par défaut (modifiable par `--chunk` ou `STREAM_CHUNK`) : 8 Mo par fichier
+#define CHUNK (1 << 20)
+
+// ===================== RÉDUCTION D'UN BLOC DU FLUX =============================
+
+/**
+ * Produit scalaire d'un bloc de `a` et `b`, calculé par le pool (découpage automatique).
+ */
+static double dot_chunk(size_t len, double *const bufs[], void *arg) {
+    (void)arg;
+    return dotprod_blocks(len, 0, bufs[0], bufs[1]);
+}
+
+/**
+ * Carré de la norme d'un bloc de `a` (un seul fichier lu : a . a).
+ */
+static double square_chunk(size_t len, double *const bufs[], void *arg) {
+    (void)arg;
+    return dotprod_blocks(len, 0, bufs[0], bufs[0]);
+}
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+double absDot(size_t n, double a[n], double b[n]) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Produit scalaire de deux fichiers float64 (bruts ou .npy) plus grands que la mémoire :
+ * les fichiers sont lus par blocs de `--chunk` éléments, le bloc suivant étant lu pendant
+ * que le pool réduit le bloc courant. Sans `--b`, calcule la norme euclidienne de `a`.
+ * Le résultat est vérifié par une seconde lecture (projection et `dotprod_ref`).
+ */
+int main(int argc, char **argv) {
+    const char *path_a = arg_string(argc, argv, "a", "INPUT_A", NULL);
+    const char *path_b = arg_string(argc, argv, "b", "INPUT_B", NULL);
+    size_t chunk = arg_size(argc, argv, "chunk", "STREAM_CHUNK", CHUNK);
+    if (!path_a) {
+        fprintf(stderr, "usage : %s --a fichier [--b fichier] [--chunk éléments]\n", argv[0]);
+        return 1;
+    }
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    // Réduction en flux
+    const char *paths[2] = { path_a, path_b };
+    size_t nb_files = path_b ? 2 : 1;
+    stream_result_t res = stream_reduce(nb_files, paths, chunk, path_b ? dot_chunk : square_chunk, NULL);
+
+    double bytes = (double)res.count * sizeof(double) * nb_files;
+    printf("%s : %zu éléments, %zu blocs de %zu éléments, %zu threads\n", path_b ? "Produit scalaire" : "Norme",
+           res.count, res.nb_chunks, chunk, pool_size(pool_global()));
+    printf("Temps total %.3f s (%.1f Mo/s), calcul %.3f s, attente des lectures %.3f s\n",
+           res.seconds, bytes / res.seconds / 1e6, res.compute_s, res.wait_s);
+
+    // Vérification : même calcul sur les fichiers projetés en mémoire
+    mapped_array_t map_a = mapfile_open(path_a, MAPFILE_LAZY);
+    mapped_array_t map_b = path_b ? mapfile_open(path_b, MAPFILE_LAZY) : map_a;
+    double ref = dotprod_ref(map_a.count, map_a.data, map_b.data);
+    double threshold = map_a.count * DBL_EPSILON * fmax(1., absDot(map_a.count, map_a.data, map_b.data));
+    bool ok = fabs(ref - res.value) <= threshold;
+
+    if (path_b) {
+        printf("Produit scalaire (référence) = %.17g\nProduit scalaire (flux) = %.17g\n", ref, res.value);
+        mapfile_close(&map_b);
+    } else {
+        printf("Norme (référence) = %.17g\nNorme (flux) = %.17g\n", sqrt(ref), sqrt(res.value));
+    }
+    mapfile_close(&map_a);
+
+    if (ok) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    return 0;
+}
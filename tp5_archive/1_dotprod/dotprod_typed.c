@@ -0,0 +1,57 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_typed.h"
+#include "alloc.h"
+#include "dotprod.h"
+
+// ================== PRODUIT SCALAIRE PAR BLOCS, TOUS LES TYPES ==================
+
+/**
+ * Génère, pour une ligne de `SIMD_ELEM_TYPES`, la tâche et la fonction parallèle
+ * `dotprod_blocks_<suffixe>` : même découpage que `dotprod_blocks` (blocs tenant dans
+ * la moitié du cache L2 pour `2 * sizeof(ELEM_T)` octets lus par élément, donc plus
+ * d'éléments par bloc pour les types étroits). Chaque tâche garde son résultat
+ * dans sa propre structure (une ligne de cache), combinées dans l'ordre des blocs.
+ */
+#define DEFINE_DOTPROD_TYPED(SUFFIX, ELEM_T, PART_T, TOTAL_T)                           \
+    typedef struct {                                                                    \
+        _Alignas(CACHE_LINE) const ELEM_T *a; /* Pointeur vers le tableau `a` */        \
+        const ELEM_T *b;   /* Pointeur vers le tableau `b` */                           \
+        size_t start;      /* Index de début du bloc */                                 \
+        size_t end;        /* Index de fin du bloc */                                   \
+        PART_T result;     /* Produit scalaire du bloc */                               \
+    } DotTask_##SUFFIX;                                                                 \
+                                                                                        \
+    static void *compute_block_##SUFFIX(void *arg) {                                    \
+        DotTask_##SUFFIX *task = (DotTask_##SUFFIX *)arg;                               \
+        task->result = simd_dot_##SUFFIX(task->end - task->start, task->a + task->start, \
+                                         task->b + task->start);                        \
+        return NULL;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    TOTAL_T dotprod_blocks_##SUFFIX(size_t n, size_t k, const ELEM_T *a, const ELEM_T *b) { \
+        size_t nb_blocks = partition_count(n, k, pool_size(pool_current()), 2 * sizeof(ELEM_T)); \
+        arena_t *scratch = arena_scratch();                                             \
+        arena_mark_t mark = arena_mark(scratch);                                        \
+        DotTask_##SUFFIX *tasks = arena_alloc(scratch, nb_blocks, sizeof(DotTask_##SUFFIX)); \
+        for (size_t i = 0; i < nb_blocks; ++i) {                                        \
+            tasks[i].a = a;                                                             \
+            tasks[i].b = b;                                                             \
+            partition_bounds(n, nb_blocks, i, &tasks[i].start, &tasks[i].end);          \
+        }                                                                               \
+                                                                                        \
+        pool_run(pool_current(), nb_blocks, compute_block_##SUFFIX, tasks, sizeof(DotTask_##SUFFIX)); \
+                                                                                        \
+        TOTAL_T sum = 0;                                                                \
+        for (size_t i = 0; i < nb_blocks; ++i) {                                        \
+            sum += (TOTAL_T)tasks[i].result;                                            \
+        }                                                                               \
+        arena_release(scratch, mark);                                                   \
+        return sum;                                                                     \
+    }
+
+SIMD_ELEM_TYPES(DEFINE_DOTPROD_TYPED)
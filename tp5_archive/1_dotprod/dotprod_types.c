@@ -0,0 +1,152 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "dotprod.h"
+#include "thread_pool.h"
+#include "simd_dot.h"
+#include "simd_typed.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+
+// Valeurs par défaut (modifiables par `--n`/`--reps` ou `SIZE_N`/`REPS`)
+#define N 10     // Taille des tableaux
+#define REPS 5   // Répétitions de chaque mesure (on garde la plus rapide)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Entier pseudo-aléatoire de [-127, 127], représentable exactement dans tous les types.
+ */
+static int elemValue(size_t i, size_t prime) {
+    return (int)((i * prime) % 255) - 127;
+}
+
+/**
+ * Somme des |a[i] * b[i]|, qui borne l'erreur d'arrondi du produit scalaire.
+ */
+double absDot(size_t n, double a[n], double b[n]) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += fabs(a[i] * b[i]);
+    }
+    return sum;
+}
+
+/**
+ * Afficher une mesure : meilleur temps, éléments et octets lus par seconde.
+ */
+static void printTiming(const char *type, size_t n, size_t elem_size, double seconds, bool ok) {
+    printf("%-6s %10.6f s  %8.3f Gélém/s  %8.3f Go/s  %s\n", type, seconds, n / seconds / 1e9,
+           2.0 * n * elem_size / seconds / 1e9, ok ? "OK" : "ERREUR");
+}
+
+// Meilleur temps de `reps` appels de EXPR, résultat dans RES
+#define TIME_BEST(RES, EXPR, reps, best)            \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            RES = (EXPR);                           \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Produit scalaire des mêmes données en double, float32, bf16, f16 et int8 : chaque
+ * variante lit ses éléments dans son format d'origine, donc 2, 4 ou 8 fois moins
+ * d'octets qu'en double. Les résultats sont comparés à `dotprod_ref` (exact en int8).
+ */
+int main(int argc, char **argv) {
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    reps = reps ? reps : 1;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *da = alloc_array(n, sizeof(double)), *db = alloc_array(n, sizeof(double));
+    float *fa = alloc_array(n, sizeof(float)), *fb = alloc_array(n, sizeof(float));
+    bf16_t *ba = alloc_array(n, sizeof(bf16_t)), *bb = alloc_array(n, sizeof(bf16_t));
+    f16_t *ha = alloc_array(n, sizeof(f16_t)), *hb = alloc_array(n, sizeof(f16_t));
+    int8_t *ia = alloc_array(n, sizeof(int8_t)), *ib = alloc_array(n, sizeof(int8_t));
+
+    // Mêmes valeurs dans tous les types : v / 16 en flottant, v en entier
+    int64_t ref_i8 = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int va = elemValue(i, 7919), vb = elemValue(i, 104729);
+        da[i] = va / 16.0;
+        db[i] = vb / 16.0;
+        fa[i] = (float)da[i];
+        fb[i] = (float)db[i];
+        ba[i] = float_to_bf16(fa[i]);
+        bb[i] = float_to_bf16(fb[i]);
+        ha[i] = float_to_f16(fa[i]);
+        hb[i] = float_to_f16(fb[i]);
+        ia[i] = (int8_t)va;
+        ib[i] = (int8_t)vb;
+        ref_i8 += (int64_t)va * vb;
+    }
+
+    double ref = dotprod_ref(n, da, db);
+    double abs_dot = fmax(1., absDot(n, da, db));
+    printf("Produit scalaire (référence) = %.17g, %zu éléments, %zu threads, noyau %s\n\n", ref, n,
+           pool_size(pool_global()), simd_dot_name());
+
+    double best, res_d, res_f, res_b, res_h;
+    int64_t res_i;
+    bool ok, all_ok = true;
+
+    TIME_BEST(res_d, dotprod_blocks(n, 0, da, db), reps, best);
+    ok = fabs(res_d - ref) <= n * DBL_EPSILON * abs_dot;
+    printTiming("double", n, sizeof(double), best, ok);
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res_f, dotprod_blocks_f32(n, 0, fa, fb), reps, best);
+    ok = fabs(res_f - ref) <= n * DBL_EPSILON * abs_dot;
+    printTiming("f32", n, sizeof(float), best, ok);
+    all_ok = all_ok && ok;
+
+    // Accumulateur float : erreur bornée par la précision simple
+    TIME_BEST(res_b, dotprod_blocks_bf16(n, 0, ba, bb), reps, best);
+    ok = fabs(res_b - ref) <= n * FLT_EPSILON * abs_dot;
+    printTiming("bf16", n, sizeof(bf16_t), best, ok);
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res_h, dotprod_blocks_f16(n, 0, ha, hb), reps, best);
+    ok = fabs(res_h - ref) <= n * FLT_EPSILON * abs_dot;
+    printTiming("f16", n, sizeof(f16_t), best, ok);
+    all_ok = all_ok && ok;
+
+    // Entiers : résultat exact (les valeurs flottantes sont v / 16, d'où le facteur 256)
+    TIME_BEST(res_i, dotprod_blocks_i8(n, 0, ia, ib), reps, best);
+    ok = res_i == ref_i8;
+    printTiming("i8", n, sizeof(int8_t), best, ok);
+    all_ok = all_ok && ok;
+
+    printf("\nRésultats : double %.17g, f32 %.17g, bf16 %.17g, f16 %.17g, i8 %lld (/256 = %.17g)\n", res_d, res_f,
+           res_b, res_h, (long long)res_i, res_i / 256.0);
+    if (all_ok) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    alloc_free(da);
+    alloc_free(db);
+    alloc_free(fa);
+    alloc_free(fb);
+    alloc_free(ba);
+    alloc_free(bb);
+    alloc_free(ha);
+    alloc_free(hb);
+    alloc_free(ia);
+    alloc_free(ib);
+
+    return 0;
+}
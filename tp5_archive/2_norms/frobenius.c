@@ -2,111 +2,33 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <math.h>
-#include <pthread.h>
-#include <assert.h>
-
+#include <float.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "args.h"
+#include "matrix.h"
+#include "mapfile.h"
+#include "placement.h"
+#include "frobnorm.h"
+
+// Dimensions par défaut (modifiables par `--m`/`--n` ou `SIZE_M`/`SIZE_N`)
 #define M 5  // Nombre de lignes
 #define N 8  // Nombre de colonnes
-
-// ======================== STRUCTURE POUR LES THREADS ===========================
-
-/**
- * Structure pour transmettre les données nécessaires à chaque thread.
- */
-typedef struct {
-    size_t row;            // Index de la ligne
-    size_t n;              // Nombre de colonnes
-    double (*A)[N];        // Pointeur vers la matrice
-    double *shared_sum;    // Pointeur vers la somme partagée
-    pthread_mutex_t *mutex; // Pointeur vers le mutex
-} ThreadData;
-
-// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
-
-/**
- * Fonction exécutée par chaque thread pour calculer la somme des carrés d'une ligne donnée.
- */
-void* compute_row_sum(void *arg) {
-    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre en `ThreadData`
-    double row_sum = 0.0;
-
-    // Calculer la somme des carrés pour la ligne spécifiée
-    for (size_t j = 0; j < data->n; ++j) {
-        row_sum += data->A[data->row][j] * data->A[data->row][j];
-    }
-
-    // Accéder à la somme partagée de manière sûre
-    pthread_mutex_lock(data->mutex);
-    *(data->shared_sum) += row_sum;
-    pthread_mutex_unlock(data->mutex);
-
-    return NULL;
-}
-
-// ============================ FONCTION DE CALCUL ===============================
-
-/**
- * Fonction de référence pour calculer la norme de Frobenius séquentiellement.
- */
-double frobenius_ref(size_t m, size_t n, double A[m][n]) {
-    double frob = 0.;
-    for (size_t i = 0; i < m; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            frob += A[i][j] * A[i][j];
-        }
-    }
-    return sqrt(frob);
-}
-
-/**
- * Fonction parallèle pour calculer la norme de Frobenius en utilisant `pthread`.
- */
-double frobenius(size_t m, size_t n, double A[m][n]) {
-    double frob = 0.0;  // Somme partagée initialisée à 0
-    pthread_mutex_t mutex;  // Mutex pour protéger l'accès à la somme partagée
-
-    // Initialiser le mutex
-    pthread_mutex_init(&mutex, NULL);
-
-    // Créer des threads pour chaque ligne
-    pthread_t threads[m];
-    ThreadData thread_data[m];
-
-    for (size_t i = 0; i < m; ++i) {
-        thread_data[i].row = i;          // Ligne à traiter
-        thread_data[i].n = n;            // Nombre de colonnes
-        thread_data[i].A = A;            // Pointeur vers la matrice
-        thread_data[i].shared_sum = &frob; // Pointeur vers la somme partagée
-        thread_data[i].mutex = &mutex;   // Pointeur vers le mutex
-
-        // Créer un thread pour traiter la ligne
-        pthread_create(&threads[i], NULL, compute_row_sum, &thread_data[i]);
-    }
-
-    // Attendre la fin de tous les threads
-    for (size_t i = 0; i < m; ++i) {
-        pthread_join(threads[i], NULL);
-    }
-
-    // Détruire le mutex
-    pthread_mutex_destroy(&mutex);
-
-    return sqrt(frob);  // Retourner la racine carrée de la somme
-}
+#define PRINT_MAX 16  // Dimension maximale des matrices affichées
 
 // =========================== FONCTIONS UTILES ==================================
 
 /**
  * Initialiser une matrice avec des valeurs incrémentales.
+ * Le remplissage est fait en parallèle, tuile par tuile comme le calcul des normes :
+ * chaque page est allouée sur le nœud NUMA du thread qui la lira.
  */
 void initMatrix(size_t m, size_t n, double A[m][n]) {
     static double elem = 0.;
-    for (size_t i = 0; i < m; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            A[i][j] = elem;
-            elem += 1.;
-        }
-    }
+    first_touch_fill_matrix(matrix_row_major(m, n, n, &A[0][0]), elem);
+    elem += (double)(m * n);
 }
 
 /**
@@ -125,22 +47,37 @@ void printMatrix(size_t m, size_t n, double A[m][n]) {
  * Vérifier si deux nombres flottants sont proches (à une tolérance donnée).
  */
 inline bool isClose(double a, double b, double threshold) {
-    return fabs(a - b) < threshold;
+    return fabs(a - b) <= threshold;
 }
 
 // =============================== MAIN ===========================================
 
-int main(void) {
-    size_t m = M;  // Nombre de lignes
-    size_t n = N;  // Nombre de colonnes
-
-    // Déclaration et initialisation de la matrice
-    double A[m][n];
-    initMatrix(m, n, A);
+int main(int argc, char **argv) {
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);  // Nombre de lignes
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);  // Nombre de colonnes
+    const char *path = arg_string(argc, argv, "input", "INPUT", NULL);  // Fichier de la matrice (brut ou .npy)
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *data;
+    mapped_array_t map = { 0 };
+    if (path) {
+        // Matrice lue sur disque : projetée en mémoire et passée telle quelle aux noyaux
+        // (un fichier en ordre Fortran est lu comme sa transposée, de même norme)
+        map = mapfile_open(path, mapfile_get_mode());
+        mapfile_matrix_shape(&map, n, &m, &n);
+        data = map.data;
+    } else {
+        // Allocation (sur le tas) et initialisation de la matrice
+        data = alloc_array(m, n * sizeof(double));
+        initMatrix(m, n, (double (*)[n])data);
+    }
+    double (*A)[n] = (double (*)[n])data;
 
-    // Affichage de la matrice
-    printf("Matrice A =\n");
-    printMatrix(m, n, A);
+    // Affichage de la matrice (seulement si elle est petite)
+    if (m <= PRINT_MAX && n <= PRINT_MAX) {
+        printf("Matrice A =\n");
+        printMatrix(m, n, A);
+    }
 
     // Calcul de la norme de Frobenius en version séquentielle
     double ref = frobenius_ref(m, n, A);
@@ -148,16 +85,30 @@ int main(void) {
     // Calcul de la norme de Frobenius en version parallèle
     double res = frobenius(m, n, A);
 
+    // Même calcul sur la transposée, vue par colonnes sans copie
+    double res_t = frobenius_view(matrix_col_major(n, m, n, &A[0][0]));
+
     // Affichage des résultats
     printf("\nNorme de Frobenius (référence) = %lf\n", ref);
-    printf("Norme de Frobenius (parallèle) = %lf\n", res);
-
-    // Vérification de la validité des résultats
-    if (isClose(ref, res, 0.0001)) {
+    printf("Norme de Frobenius (parallèle, %s, %s) = %lf\n", reduce_mode_name(reduce_get_mode()),
+           sum_mode_name(sum_get_mode()), res);
+    printf("Norme de Frobenius (transposée, vue par colonnes) = %lf\n", res_t);
+    printf("Valeur exacte affichée : %.17g\n", res);
+
+    // Vérification de la validité des résultats : la somme récursive de référence a une
+    // erreur relative bornée par m * n * epsilon (données positives, divisée par 2 par la racine)
+    double threshold = m * n * DBL_EPSILON * fmax(1., ref);
+    if (isClose(ref, res, threshold) && isClose(ref, res_t, threshold)) {
         printf("Résultat correct : OK\n");
     } else {
         printf("Erreur : différence entre les résultats supérieure au seuil\n");
     }
 
+    if (path) {
+        mapfile_close(&map);
+    } else {
+        alloc_free(A);
+    }
+
     return 0;
 }
@@ -0,0 +1,92 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "thread_pool.h"
+#include "args.h"
+#include "matrix.h"
+#include "mapfile.h"
+#include "stream.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+#include "norms.h"
+
+// Valeurs par défaut (modifiables par `--n`/`--chunk` ou `SIZE_N`/`STREAM_CHUNK`)
+#define N 8              // Longueur d'une ligne d'un fichier brut
+#define CHUNK (1 << 20)  // Éléments lus par bloc (arrondi à un nombre entier de lignes)
+
+// ===================== RÉDUCTION D'UN BLOC DU FLUX =============================
+
+/**
+ * Résultats accumulés d'un bloc à l'autre (autres que la somme des carrés).
+ */
+typedef struct {
+    size_t n;              // Longueur d'une ligne
+    double max;            // Plus grande valeur absolue vue jusqu'ici
+} StreamNorms;
+
+/**
+ * Normes d'un bloc de lignes entières, calculées par le pool avec les noyaux vectoriels
+ * de `frobenius_sq_view` et `max_view` (sans les sommes de lignes et de colonnes de
+ * `norms_view`). Retourne la somme des carrés du bloc, sans racine, et met à jour le maximum.
+ */
+static double norms_chunk(size_t len, double *const bufs[], void *arg) {
+    StreamNorms *acc = (StreamNorms *)arg;
+    matrix_view_t A = matrix_row_major(len / acc->n, acc->n, acc->n, bufs[0]);
+    double max = max_view(A);
+    if (max > acc->max) {
+        acc->max = max;
+    }
+    return frobenius_sq_view(A);
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Norme de Frobenius et norme max d'une matrice float64 (fichier brut ou .npy) plus grande
+ * que la mémoire : le fichier est lu par blocs de lignes, le bloc suivant étant lu pendant
+ * que le pool réduit le bloc courant. Vérification par projection et `norms_ref`.
+ */
+int main(int argc, char **argv) {
+    size_t m, n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t chunk = arg_size(argc, argv, "chunk", "STREAM_CHUNK", CHUNK);
+    const char *path = arg_string(argc, argv, "input", "INPUT", NULL);
+    if (!path) {
+        fprintf(stderr, "usage : %s --input fichier [--n colonnes] [--chunk éléments]\n", argv[0]);
+        return 1;
+    }
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    // Dimensions du rangement (un fichier en ordre Fortran est lu comme sa transposée, de mêmes normes)
+    mapped_array_t map = mapfile_open(path, MAPFILE_LAZY);
+    mapfile_matrix_shape(&map, n, &m, &n);
+
+    // Réduction en flux, par blocs de lignes entières
+    StreamNorms acc = { n, 0.0 };
+    chunk = chunk < n ? n : chunk / n * n;
+    const char *paths[1] = { path };
+    stream_result_t res = stream_reduce(1, paths, chunk, norms_chunk, &acc);
+    double frob = sqrt(res.value);
+
+    printf("Matrice %zu x %zu, %zu blocs de %zu lignes, %zu threads\n", m, n, res.nb_chunks, chunk / n,
+           pool_size(pool_global()));
+    printf("Temps total %.3f s (%.1f Mo/s), calcul %.3f s, attente des lectures %.3f s\n",
+           res.seconds, res.count * sizeof(double) / res.seconds / 1e6, res.compute_s, res.wait_s);
+
+    // Vérification : mêmes normes sur le fichier projeté en mémoire
+    norms_t ref = norms_ref(m, n, (double (*)[n])map.data);
+    mapfile_close(&map);
+
+    printf("Norme de Frobenius (référence) = %.17g\nNorme de Frobenius (flux) = %.17g\n", ref.frobenius, frob);
+    printf("Norme max (référence) = %.17g\nNorme max (flux) = %.17g\n", ref.max, acc.max);
+
+    if (fabs(ref.frobenius - frob) <= m * n * DBL_EPSILON * fmax(1., ref.frobenius) && ref.max == acc.max) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    return 0;
+}
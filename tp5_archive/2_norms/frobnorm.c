@@ -0,0 +1,233 @@
+#include <stddef.h>
+#include <math.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "matrix.h"
+#include "tile.h"
+#include "prefetch.h"
+#include "simd_dot.h"
+#include "cutover.h"
+#include "gpu.h"
+#include "frobnorm.h"
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Structure pour transmettre les données nécessaires à chaque thread
+ * (chaque structure commence sur sa propre ligne de cache, voir `reduce_ctx_t`).
+ */
+typedef struct {
+    reduce_ctx_t ctx;      // Contexte de réduction (somme partagée, modes, case privée)
+    tile_t tile;           // Tuile de la matrice à traiter
+    matrix_view_t A;       // Vue sur la matrice (base, dimensions et pas)
+    size_t prefetch;       // Distance de préchargement en octets (0 : préchargement matériel seul)
+    prefetch_hint_t hint;  // Indication de localité du préchargement
+} ThreadData;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Fonction exécutée par chaque thread pour calculer la somme des carrés d'une tuile donnée.
+ * La somme des carrés d'un segment de ligne est son produit scalaire avec lui-même : on
+ * utilise donc le noyau vectorisé de `simd_dot.h`. Avec une distance de préchargement
+ * (voir `prefetch.h`), le segment de la ligne située à cette distance est demandé avant
+ * chaque ligne : le préchargeur matériel ne suit pas les sauts d'une ligne à l'autre.
+ */
+void* compute_tile_sum(void *arg) {
+    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre en `ThreadData`
+    ptrdiff_t stride = data->A.col_stride;
+    double tile_sum = 0.0;
+    double *first = matrix_at(data->A, data->tile.i0, data->tile.j0);
+    size_t ahead = prefetch_rows_ahead(data->prefetch, data->tile.cols);
+
+    // Sommation compensée : somme et compensation de la tuile dans la case privée
+    if (data->ctx.sum == SUM_COMPENSATED) {
+        double error = 0.0;
+        for (size_t i = 0; i < data->tile.rows; ++i) {
+            double *row = matrix_at(data->A, data->tile.i0 + i, data->tile.j0);
+            prefetch_tile_row(first, data->tile.rows, data->tile.cols, data->A.row_stride, stride, i, ahead,
+                              data->hint);
+            double row_sum = 0.0, row_error = 0.0, e;
+            if (stride == 1) {
+                row_sum = simd_dot_compensated(data->tile.cols, row, row, &row_error);
+            } else {
+                for (size_t j = 0; j < data->tile.cols; ++j) {
+                    double x = row[(ptrdiff_t)j * stride];
+                    double p = x * x;
+                    two_sum(row_sum, p, &row_sum, &e);
+                    row_error += e + fma(x, x, -p);
+                }
+            }
+            two_sum(tile_sum, row_sum, &tile_sum, &e);
+            error += row_error + e;
+        }
+        data->ctx.partial->value = tile_sum;
+        data->ctx.partial->error = error;
+        return NULL;
+    }
+
+    // Calculer la somme des carrés, segment de ligne par segment de ligne
+    for (size_t i = 0; i < data->tile.rows; ++i) {
+        double *row = matrix_at(data->A, data->tile.i0 + i, data->tile.j0);
+        prefetch_tile_row(first, data->tile.rows, data->tile.cols, data->A.row_stride, stride, i, ahead, data->hint);
+        if (stride == 1) {
+            tile_sum += simd_dot(data->tile.cols, row, row);  // Segment contigu : noyau vectorisé
+        } else {
+            for (size_t j = 0; j < data->tile.cols; ++j) {
+                double x = row[(ptrdiff_t)j * stride];
+                tile_sum += x * x;
+            }
+        }
+    }
+
+    // Publier la somme de la tuile de manière sûre (selon le mode de réduction)
+    reduce_publish(&data->ctx, REDUCE_SUM, tile_sum);
+
+    return NULL;
+}
+
+// ====================== VERSIONS SUR LE THREAD APPELANT ========================
+
+/**
+ * Somme des carrés d'une vue, élément par élément (version séquentielle).
+ */
+static double view_sum_sq_serial(matrix_view_t A) {
+    double sum = 0.0;
+    for (size_t i = 0; i < A.m; ++i) {
+        for (size_t j = 0; j < A.n; ++j) {
+            double x = *matrix_at(A, i, j);
+            sum += x * x;
+        }
+    }
+    return sum;
+}
+
+/**
+ * Somme des carrés d'une vue, ligne par ligne avec le noyau vectorisé si les lignes
+ * sont contiguës.
+ */
+static double view_sum_sq_simd(matrix_view_t A) {
+    if (A.col_stride != 1) {
+        return view_sum_sq_serial(A);
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < A.m; ++i) {
+        double *row = matrix_at(A, i, 0);
+        sum += simd_dot(A.n, row, row);
+    }
+    return sum;
+}
+
+// ============================ FONCTION DE CALCUL ===============================
+
+/**
+ * Fonction de référence pour calculer la norme de Frobenius séquentiellement.
+ */
+double frobenius_ref(size_t m, size_t n, double A[m][n]) {
+    double frob = 0.;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            frob += A[i][j] * A[i][j];
+        }
+    }
+    return sqrt(frob);
+}
+
+/**
+ * Fonction parallèle pour calculer la somme des carrés (norme de Frobenius au carré) d'une vue quelconque
+ * (stockage par lignes, par colonnes ou sous-matrice) en utilisant le pool de threads persistant.
+ * La norme étant invariante par transposition, une vue stockée par colonnes est
+ * parcourue comme sa transposée pour que chaque tâche lise des éléments contigus.
+ * La matrice est découpée en tuiles tenant dans le cache L2 (voir `tile.h`),
+ * réparties sur les threads du pool quelle que soit sa forme. En sommation compensée,
+ * le découpage ne dépend pas du nombre de threads et les tuiles sont combinées par
+ * un arbre fixe : le résultat est identique bit à bit quel que soit le nombre de threads.
+ * Hors sommation compensée, une petite matrice est traitée sur le thread appelant,
+ * selon les seuils de `cutover.h`. Compilé avec `USE_GPU`, le calcul peut être
+ * déporté sur le GPU (voir `gpu.h`).
+ */
+double frobenius_sq_view(matrix_view_t A) {
+    if (A.col_stride != 1 && A.row_stride == 1) {
+        A = matrix_transpose(A);
+    }
+    if (gpu_offload_view(A, true)) {
+        return gpu_sum_sq(A);
+    }
+
+    // Petite matrice : version séquentielle ou vectorielle sur le thread appelant
+    sum_mode_t sum_mode = sum_get_mode();
+    if (sum_mode != SUM_COMPENSATED) {
+        switch (cutover_path(CUTOVER_FROBENIUS, A.m * A.n)) {
+        case EXEC_SERIAL: return view_sum_sq_serial(A);
+        case EXEC_SIMD:   return view_sum_sq_simd(A);
+        default:          break;
+        }
+    }
+
+    reduce_shared_t frob;  // Somme partagée et mutex pour en protéger l'accès
+
+    // Initialiser la somme partagée à 0 et le mutex
+    reduce_shared_init(&frob, 0.0);
+
+    // Préparer une tâche pour chaque tuile
+    size_t nb_threads = sum_mode == SUM_COMPENSATED ? 1 : pool_size(pool_current());
+    tile_plan_t plan = tile_plan(A.m, A.n, nb_threads, sizeof(double));
+    size_t nb_tiles = tile_count(&plan);
+    arena_t *scratch = arena_scratch();  // Données de travail de l'appel, sans allocation
+    arena_mark_t mark = arena_mark(scratch);
+    ThreadData *thread_data = arena_alloc(scratch, nb_tiles, sizeof(ThreadData));
+    padded_double_t *partials = arena_alloc(scratch, nb_tiles, sizeof(padded_double_t));  // Résultats partiels (un par tuile, mode arbre)
+    reduce_mode_t mode = sum_mode == SUM_COMPENSATED ? REDUCE_TREE : reduce_get_mode();
+    size_t distance = prefetch_get_distance();
+    prefetch_hint_t hint = prefetch_get_hint();
+
+    for (size_t i = 0; i < nb_tiles; ++i) {
+        thread_data[i].tile = tile_get(&plan, i); // Tuile à traiter
+        thread_data[i].A = A;            // Vue sur la matrice
+        thread_data[i].prefetch = distance; // Distance de préchargement
+        thread_data[i].hint = hint;      // Indication de localité
+        thread_data[i].ctx.shared = &frob; // Pointeur vers la somme partagée
+        thread_data[i].ctx.mode = mode;  // Mode de réduction
+        thread_data[i].ctx.partial = &partials[i]; // Case privée de la tuile
+        thread_data[i].ctx.sum = sum_mode; // Mode de sommation
+    }
+
+    // Traiter les tuiles avec le pool de threads, puis attendre la fin
+    pool_run(pool_current(), nb_tiles, compute_tile_sum, thread_data, sizeof(ThreadData));
+
+    // Combiner les sommes des tuiles par un arbre (mode arbre uniquement)
+    if (sum_mode == SUM_COMPENSATED) {
+        frob.value = reduce_tree_compensated(nb_tiles, partials);
+    } else if (mode == REDUCE_TREE) {
+        frob.value = reduce_tree(nb_tiles, partials, REDUCE_SUM);
+    }
+
+    // Détruire le mutex et libérer les données des tâches
+    reduce_shared_destroy(&frob);
+    arena_release(scratch, mark);
+
+    return frob.value;  // Retourner la somme des carrés
+}
+
+double frobenius_view(matrix_view_t A) {
+    return sqrt(frobenius_sq_view(A));  // Racine carrée de la somme des carrés
+}
+
+/**
+ * Fonction parallèle pour calculer la norme de Frobenius d'une matrice stockée par lignes.
+ */
+double frobenius(size_t m, size_t n, double A[m][n]) {
+    return frobenius_view(matrix_row_major(m, n, n, &A[0][0]));
+}
+
+// ========================= SOUMISSION ASYNCHRONE ===============================
+
+static double run_frobenius(void *arg) {
+    return frobenius_view(*(matrix_view_t *)arg);
+}
+
+pool_future_t *frobenius_view_async(matrix_view_t A, pool_callback_fn callback, void *user) {
+    return pool_async(pool_current(), run_frobenius, &A, sizeof(A), callback, user);
+}
@@ -0,0 +1,42 @@
+#ifndef FROBNORM_H
+#define FROBNORM_H
+
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "matrix.h"
+
+// ========================== NORME DE FROBENIUS ==================================
+
+/**
+ * Calculer séquentiellement la norme de Frobenius (racine de la somme des carrés).
+ * Définie dans `frobnorm.c`.
+ */
+double frobenius_ref(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Calculer en parallèle la norme de Frobenius d'une vue quelconque (par lignes, par
+ * colonnes ou sous-matrice), tuile par tuile avec le noyau vectorisé `simd_dot`.
+ * Les sommes des tuiles sont combinées selon `REDUCE_MODE` ; en sommation compensée
+ * (`SUM_MODE=compensated`), le résultat ne dépend pas du nombre de threads.
+ */
+double frobenius_view(matrix_view_t A);
+
+/**
+ * Somme des carrés des éléments de la vue, dont `frobenius_view` est la racine : à
+ * réduire telle quelle lorsque la matrice est répartie (voir `3_distrib/dist.h`).
+ */
+double frobenius_sq_view(matrix_view_t A);
+
+/**
+ * Même calcul pour une matrice stockée par lignes.
+ */
+double frobenius(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Version asynchrone de `frobenius_view` sur le pool courant : retourne aussitôt un
+ * futur (voir `pool_async`) ; la matrice doit rester valide jusqu'au résultat.
+ */
+pool_future_t *frobenius_view_async(matrix_view_t A, pool_callback_fn callback, void *user);
+
+#endif // FROBNORM_H
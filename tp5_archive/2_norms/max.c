@@ -2,118 +2,32 @@
 #include <stdio.h>
 #include <math.h>
 
-#include <pthread.h>
-#include <assert.h>
-
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "args.h"
+#include "matrix.h"
+#include "mapfile.h"
+#include "placement.h"
+#include "simd_dot.h"
+#include "maxnorm.h"
+
+// Dimensions par défaut (modifiables par `--m`/`--n` ou `SIZE_M`/`SIZE_N`)
 #define M 5
 #define N 8
-
-// ======================== STRUCTURE POUR LES THREADS ===========================
-
-/**
- * Structure pour transmettre les données nécessaires à chaque thread.
- */
-typedef struct {
-    size_t row;            // Index de la ligne
-    size_t n;              // Nombre de colonnes
-    double (*A)[N];        // Pointeur vers la matrice
-    double *shared_max;    // Pointeur vers la valeur maximale partagée
-    pthread_mutex_t *mutex; // Pointeur vers le mutex
-} ThreadData;
-
-// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
-
-/**
- * Fonction exécutée par chaque thread pour trouver le maximum dans une ligne donnée.
- */
-void* compute_row_max(void *arg) {
-    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre en `ThreadData`
-    double local_max = fabs(data->A[data->row][0]);
-
-    // Trouver le maximum pour la ligne spécifiée
-    for (size_t j = 1; j < data->n; ++j) {
-        if (fabs(data->A[data->row][j]) > local_max) {
-            local_max = fabs(data->A[data->row][j]);
-        }
-    }
-
-    // Mettre à jour la valeur maximale partagée si nécessaire
-    pthread_mutex_lock(data->mutex);
-    if (local_max > *(data->shared_max)) {
-        *(data->shared_max) = local_max;
-    }
-    pthread_mutex_unlock(data->mutex);
-
-    return NULL;
-}
-
-// ============================ FONCTION DE CALCUL ===============================
-
-/**
- * Fonction de référence pour calculer la norme max séquentiellement.
- */
-double max_ref(size_t m, size_t n, double A[m][n]) {
-  double maxElem = A[0][0];
-  for(size_t i = 0; i < m; ++i) {
-    for(size_t j = 0; j < n; ++j) {
-      if(fabs(A[i][j]) > maxElem) {
-        maxElem = A[i][j];
-      }
-    }
-  }
-
-  return maxElem;
-}
-
-/**
- * Fonction parallèle pour calculer la norme max en utilisant `pthread`.
- */
-double max(size_t m, size_t n, double A[m][n]) {
-    double maxElem = A[0][0];  // Valeur maximale partagée
-    pthread_mutex_t mutex;    // Mutex pour protéger l'accès à la valeur maximale partagée
-
-    // Initialiser le mutex
-    pthread_mutex_init(&mutex, NULL);
-
-    // Créer des threads pour chaque ligne
-    pthread_t threads[m];
-    ThreadData thread_data[m];
-
-    for (size_t i = 0; i < m; ++i) {
-        thread_data[i].row = i;          // Ligne à traiter
-        thread_data[i].n = n;            // Nombre de colonnes
-        thread_data[i].A = A;            // Pointeur vers la matrice
-        thread_data[i].shared_max = &maxElem; // Pointeur vers la valeur maximale partagée
-        thread_data[i].mutex = &mutex;   // Pointeur vers le mutex
-
-        // Créer un thread pour traiter la ligne
-        pthread_create(&threads[i], NULL, compute_row_max, &thread_data[i]);
-    }
-
-    // Attendre la fin de tous les threads
-    for (size_t i = 0; i < m; ++i) {
-        pthread_join(threads[i], NULL);
-    }
-
-    // Détruire le mutex
-    pthread_mutex_destroy(&mutex);
-
-    return maxElem;  // Retourner la valeur maximale trouvée
-}
+#define PRINT_MAX 16
 
 // =========================== FONCTIONS UTILES ==================================
 
 /**
  * Initialiser une matrice avec des valeurs incrémentales.
+ * Le remplissage est fait en parallèle, tuile par tuile comme le calcul des normes :
+ * chaque page est allouée sur le nœud NUMA du thread qui la lira.
  */
 void initMatrix(size_t m, size_t n, double A[m][n]) {
   static double elem = 0.;
-  for(size_t i=0; i<m; ++i) {
-    for(size_t j=0; j<n; ++j) {
-      A[i][j] = elem;
-      elem += 1.;
-    }
-  }
+  first_touch_fill_matrix(matrix_row_major(m, n, n, &A[0][0]), elem);
+  elem += (double)(m * n);
 }
 
 /**
@@ -130,26 +44,94 @@ void printMatrix(size_t m, size_t n, double A[m][n]) {
 
 // =============================== MAIN ===========================================
 
-int main(void) {
-  size_t n = N;
-  size_t m = M;
-
-  double A[m][n];
-  initMatrix(m, n, A);
+int main(int argc, char **argv) {
+  size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+  size_t m = arg_size(argc, argv, "m", "SIZE_M", M);
+  const char *path = arg_string(argc, argv, "input", "INPUT", NULL);  // Fichier de la matrice (brut ou .npy)
+  pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+  double *data;
+  mapped_array_t map = { 0 };
+  if(path) {
+    // Matrice projetée en mémoire, sans copie (ordre Fortran : lue comme sa transposée, même maximum)
+    map = mapfile_open(path, mapfile_get_mode());
+    mapfile_matrix_shape(&map, n, &m, &n);
+    data = map.data;
+  }
+  else {
+    data = alloc_array(m, n * sizeof(double));
+    initMatrix(m, n, (double (*)[n])data);
+  }
+  double (*A)[n] = (double (*)[n])data;
 
-  printf("A=\n");
-  printMatrix(m, n, A);
+  if(m <= PRINT_MAX && n <= PRINT_MAX) {
+    printf("A=\n");
+    printMatrix(m, n, A);
+  }
 
   double ref = max_ref(m, n, A);
   double res = max(m, n, A);
+  double res_t = max_view(matrix_col_major(n, m, n, &A[0][0]));  // Transposée, sans copie
+
+  // Position du maximum ; sur la transposée, première occurrence dans l'ordre des colonnes de A
+  // (la même position, indices échangés, si le maximum est unique)
+  max_loc_t loc_ref = max_ref_loc(m, n, A);
+  max_loc_t loc = max_view_loc(matrix_row_major(m, n, n, &A[0][0]));
+  max_loc_t loc_t = max_view_loc(matrix_col_major(n, m, n, &A[0][0]));
   
-  printf("\nref=%lf res=%lf\n", ref, res);
-  if(ref == res) {
+  printf("\nref=%lf res=%lf res_t=%lf (%s, %s)\n", ref, res, res_t, reduce_mode_name(reduce_get_mode()),
+         simd_dot_name());
+  printf("argmax ref=(%zu, %zu) res=(%zu, %zu) res_t=(%zu, %zu)\n", loc_ref.i, loc_ref.j, loc.i, loc.j,
+         loc_t.j, loc_t.i);
+  if(ref == res && ref == res_t && loc.value == ref && loc_t.value == ref &&
+     loc.i == loc_ref.i && loc.j == loc_ref.j && fabs(A[loc_t.j][loc_t.i]) == ref) {
     printf("OK\n");
   }
   else {
     printf("ERROR: difference between ref and res is above threshold\n");
   }
 
+  // Un NaN est ignoré par tous les noyaux, comme par `max_ref` : placé en fin de ligne,
+  // il tombe dans le dernier pas vectoriel (matrice en mémoire seulement, le fichier est
+  // projeté en lecture)
+  if(!path && m > 0 && n > 0) {
+    A[m / 2][n - 1] = NAN;
+    ref = max_ref(m, n, A);
+    loc_ref = max_ref_loc(m, n, A);
+    res = max(m, n, A);
+    loc = max_view_loc(matrix_row_major(m, n, n, &A[0][0]));
+    loc_t = max_view_loc(matrix_col_major(n, m, n, &A[0][0]));
+    printf("NaN en (%zu, %zu) : ref=%lf res=%lf argmax=(%zu, %zu)\n", m / 2, n - 1, ref, res, loc.i, loc.j);
+    if(ref == res && loc.value == ref && loc_t.value == ref && loc.i == loc_ref.i && loc.j == loc_ref.j) {
+      printf("OK\n");
+    }
+    else {
+      printf("ERROR: NaN not ignored by the max kernels\n");
+    }
+  }
+
+  // Ligne entièrement NaN au-dessus d'une ligne de zéros : la position ne doit pas tomber
+  // sur un NaN, la première occurrence du maximum 0 est le début de la ligne suivante
+  double B[2][2] = { { NAN, NAN }, { 0., 0. } };
+  loc_ref = max_ref_loc(2, 2, B);
+  loc = max_view_loc(matrix_row_major(2, 2, 2, &B[0][0]));
+  loc_t = max_view_loc(matrix_col_major(2, 2, 2, &B[0][0]));
+  printf("Ligne de NaN : argmax ref=(%zu, %zu) res=(%zu, %zu) res_t=(%zu, %zu)\n", loc_ref.i, loc_ref.j, loc.i,
+         loc.j, loc_t.i, loc_t.j);
+  if(loc.value == loc_ref.value && loc.i == loc_ref.i && loc.j == loc_ref.j && loc_t.i == loc_ref.j &&
+     loc_t.j == loc_ref.i) {
+    printf("OK\n");
+  }
+  else {
+    printf("ERROR: argmax on a NaN row\n");
+  }
+
+  if(path) {
+    mapfile_close(&map);
+  }
+  else {
+    alloc_free(A);
+  }
+
   return 0;
 }
@@ -0,0 +1,295 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "matrix.h"
+#include "tile.h"
+#include "prefetch.h"
+#include "simd_max.h"
+#include "cutover.h"
+#include "gpu.h"
+#include "maxnorm.h"
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Meilleure position trouvée par un thread, seule sur sa ligne de cache.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) max_loc_t loc;
+} padded_max_loc_t;
+
+/**
+ * Structure pour transmettre les données nécessaires à chaque thread
+ * (chaque structure commence sur sa propre ligne de cache, voir `reduce_ctx_t`).
+ * En mode `tree`, `ctx.partial` pointe vers les cases des threads (une par thread du pool),
+ * indexées par `pool_worker_index` : chaque thread ne met à jour que la sienne.
+ */
+typedef struct {
+    reduce_ctx_t ctx;      // Contexte de réduction (maximum partagé, mode, cases des threads)
+    tile_t tile;           // Tuile de la matrice à traiter
+    matrix_view_t A;       // Vue sur la matrice (base, dimensions et pas)
+    size_t prefetch;       // Distance de préchargement en octets (0 : préchargement matériel seul)
+    prefetch_hint_t hint;  // Indication de localité du préchargement
+    padded_max_loc_t *locs; // Positions des threads (NULL : maximum seul)
+    bool transposed;       // Vue parcourue comme la transposée de la matrice d'origine
+} ThreadData;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * La position `a` précède-t-elle `b` : valeur plus grande, ou même valeur plus tôt
+ * dans l'ordre des lignes ?
+ */
+static bool loc_better(max_loc_t a, max_loc_t b) {
+    if (a.value != b.value) {
+        return a.value > b.value;
+    }
+    return a.i < b.i || (a.i == b.i && a.j < b.j);
+}
+
+/**
+ * Maximum absolu d'un segment de ligne, contigu (noyau vectorisé) ou non.
+ */
+static double segment_absmax(size_t n, const double *row, ptrdiff_t stride) {
+    if (stride == 1) {
+        return simd_absmax(n, row);
+    }
+    double max = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        double x = fabs(row[(ptrdiff_t)j * stride]);
+        max = x > max ? x : max;
+    }
+    return max;
+}
+
+/**
+ * Fonction exécutée par chaque thread pour trouver le maximum absolu d'une tuile.
+ * Avec les positions, chaque segment qui atteint le meilleur maximum de la tuile est
+ * relu pour trouver sa première occurrence (la tuile est encore dans le cache) ;
+ * les NaN sont ignorés par le maximum comme par cette recherche (voir `simd_max.h`).
+ * Avec une distance de préchargement, le segment de la ligne située à cette distance
+ * est demandé avant chaque ligne (voir `prefetch.h`).
+ */
+void* compute_tile_max(void *arg) {
+    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre en `ThreadData`
+    ptrdiff_t stride = data->A.col_stride;
+    max_loc_t best = { -1.0, 0, 0 };       // Toute valeur absolue l'emporte
+    double *first = matrix_at(data->A, data->tile.i0, data->tile.j0);
+    size_t ahead = prefetch_rows_ahead(data->prefetch, data->tile.cols);
+
+    for (size_t i = 0; i < data->tile.rows; ++i) {
+        double *row = matrix_at(data->A, data->tile.i0 + i, data->tile.j0);
+        prefetch_tile_row(first, data->tile.rows, data->tile.cols, data->A.row_stride, stride, i, ahead, data->hint);
+        double seg_max = segment_absmax(data->tile.cols, row, stride);
+        if (seg_max < best.value || (seg_max == best.value && !data->locs)) {
+            continue;
+        }
+        max_loc_t loc = { seg_max, data->tile.i0 + i, data->tile.j0 };
+        if (data->locs) {
+            size_t j = 0;
+            while (j < data->tile.cols && fabs(row[(ptrdiff_t)j * stride]) != seg_max) {
+                ++j;
+            }
+            if (j == data->tile.cols) {
+                continue;  // Segment entièrement NaN : aucun élément n'atteint le maximum 0
+            }
+            loc.j += j;
+            if (data->transposed) {
+                size_t t = loc.i;
+                loc.i = loc.j;
+                loc.j = t;
+            }
+        }
+        if (loc_better(loc, best)) {
+            best = loc;
+        }
+    }
+
+    // Position : meilleure position du thread
+    if (data->locs) {
+        padded_max_loc_t *slot = &data->locs[pool_worker_index()];
+        if (loc_better(best, slot->loc)) {
+            slot->loc = best;
+        }
+        return NULL;
+    }
+
+    // Mode arbre : maximum du thread ; sinon variable partagée (mutex ou compare-and-swap)
+    if (data->ctx.mode == REDUCE_TREE) {
+        padded_double_t *slot = &data->ctx.partial[pool_worker_index()];
+        slot->value = best.value > slot->value ? best.value : slot->value;
+    } else {
+        reduce_publish(&data->ctx, REDUCE_MAX, best.value);
+    }
+
+    return NULL;
+}
+
+// ============================ FONCTIONS DE CALCUL ===============================
+
+double max_ref(size_t m, size_t n, double A[m][n]) {
+    double maxElem = 0.0;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (fabs(A[i][j]) > maxElem) {
+                maxElem = fabs(A[i][j]);
+            }
+        }
+    }
+
+    return maxElem;
+}
+
+max_loc_t max_ref_loc(size_t m, size_t n, double A[m][n]) {
+    max_loc_t r = { -1.0, 0, 0 };
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (fabs(A[i][j]) > r.value) {
+                r = (max_loc_t){ fabs(A[i][j]), i, j };
+            }
+        }
+    }
+
+    return r.value < 0.0 ? (max_loc_t){ 0.0, 0, 0 } : r;
+}
+
+/**
+ * Maximum absolu d'une vue sur le thread appelant : élément par élément (version
+ * séquentielle), ou segment de ligne par segment de ligne (noyau vectorisé).
+ */
+static double view_absmax(matrix_view_t A, bool vectorized) {
+    double max = 0.0;
+    for (size_t i = 0; i < A.m; ++i) {
+        double *row = matrix_at(A, i, 0);
+        if (vectorized) {
+            double seg_max = segment_absmax(A.n, row, A.col_stride);
+            max = seg_max > max ? seg_max : max;
+            continue;
+        }
+        for (size_t j = 0; j < A.n; ++j) {
+            double x = fabs(row[(ptrdiff_t)j * A.col_stride]);
+            max = x > max ? x : max;
+        }
+    }
+    return max;
+}
+
+/**
+ * Parcours parallèle commun à `max_view` et `max_view_loc`.
+ * Une vue stockée par colonnes est parcourue comme sa transposée (même maximum)
+ * pour que chaque tâche lise des éléments contigus ; les positions sont rendues
+ * dans les indices de la vue d'origine. La matrice est découpée en tuiles tenant
+ * dans le cache L2 (voir `tile.h`), réparties sur les threads du pool.
+ */
+static max_loc_t max_view_impl(matrix_view_t A, bool with_loc) {
+    max_loc_t r = { 0.0, 0, 0 };
+    bool transposed = A.col_stride != 1 && A.row_stride == 1;
+    if (transposed) {
+        A = matrix_transpose(A);
+    }
+    if (A.m == 0 || A.n == 0) {
+        return r;
+    }
+
+    reduce_shared_t maxElem;  // Valeur maximale partagée et mutex pour en protéger l'accès
+    reduce_shared_init(&maxElem, 0.0);
+
+    // Une case par thread (maximum en mode arbre, ou position)
+    size_t nb_threads = pool_size(pool_current());
+    arena_t *scratch = arena_scratch();  // Données de travail de l'appel, sans allocation
+    arena_mark_t mark = arena_mark(scratch);
+    padded_double_t *partials = arena_alloc(scratch, nb_threads, sizeof(padded_double_t));
+    padded_max_loc_t *locs = with_loc ? arena_alloc(scratch, nb_threads, sizeof(padded_max_loc_t)) : NULL;
+    for (size_t t = 0; t < nb_threads; ++t) {
+        partials[t].value = 0.0;
+        if (locs) {
+            locs[t].loc = (max_loc_t){ -1.0, 0, 0 };
+        }
+    }
+
+    // Préparer une tâche pour chaque tuile
+    tile_plan_t plan = tile_plan(A.m, A.n, nb_threads, sizeof(double));
+    size_t nb_tiles = tile_count(&plan);
+    ThreadData *thread_data = arena_alloc(scratch, nb_tiles, sizeof(ThreadData));
+    reduce_mode_t mode = reduce_get_mode();
+    size_t distance = prefetch_get_distance();
+    prefetch_hint_t hint = prefetch_get_hint();
+
+    for (size_t i = 0; i < nb_tiles; ++i) {
+        thread_data[i].tile = tile_get(&plan, i); // Tuile à traiter
+        thread_data[i].A = A;            // Vue sur la matrice
+        thread_data[i].prefetch = distance; // Distance de préchargement
+        thread_data[i].hint = hint;      // Indication de localité
+        thread_data[i].ctx.shared = &maxElem; // Pointeur vers la valeur maximale partagée
+        thread_data[i].ctx.mode = mode;  // Mode de réduction
+        thread_data[i].ctx.partial = partials; // Cases des threads (mode arbre)
+        thread_data[i].ctx.sum = SUM_FAST; // Sans objet pour un maximum
+        thread_data[i].locs = locs;      // Positions des threads (ou NULL)
+        thread_data[i].transposed = transposed;
+    }
+
+    // Traiter les tuiles avec le pool de threads, puis attendre la fin
+    pool_run(pool_current(), nb_tiles, compute_tile_max, thread_data, sizeof(ThreadData));
+
+    // Combiner les résultats des threads
+    if (locs) {
+        r = locs[0].loc;
+        for (size_t t = 1; t < nb_threads; ++t) {
+            if (loc_better(locs[t].loc, r)) {
+                r = locs[t].loc;
+            }
+        }
+        r = r.value < 0.0 ? (max_loc_t){ 0.0, 0, 0 } : r;  // Matrice entièrement NaN, comme `max_ref_loc`
+    } else if (mode == REDUCE_TREE) {
+        r.value = reduce_tree(nb_threads, partials, REDUCE_MAX);
+    } else {
+        r.value = maxElem.value;
+    }
+
+    // Détruire le mutex et libérer les données des tâches
+    reduce_shared_destroy(&maxElem);
+    arena_release(scratch, mark);
+
+    return r;
+}
+
+/**
+ * Hors positions, une petite matrice est traitée sur le thread appelant, selon les
+ * seuils de `cutover.h` (le maximum ne dépend pas de l'ordre de parcours), ou déportée
+ * sur le GPU (voir `gpu.h`).
+ */
+double max_view(matrix_view_t A) {
+    if (A.col_stride != 1 && A.row_stride == 1) {
+        A = matrix_transpose(A);
+    }
+    if (gpu_offload_view(A, false)) {
+        return gpu_absmax(A);
+    }
+    switch (cutover_path(CUTOVER_MAX, A.m * A.n)) {
+    case EXEC_SERIAL: return view_absmax(A, false);
+    case EXEC_SIMD:   return view_absmax(A, true);
+    default:          return max_view_impl(A, false).value;
+    }
+}
+
+double max(size_t m, size_t n, double A[m][n]) {
+    return max_view(matrix_row_major(m, n, n, &A[0][0]));
+}
+
+max_loc_t max_view_loc(matrix_view_t A) {
+    return max_view_impl(A, true);
+}
+
+// ========================= SOUMISSION ASYNCHRONE ===============================
+
+static double run_max(void *arg) {
+    return max_view(*(matrix_view_t *)arg);
+}
+
+pool_future_t *max_view_async(matrix_view_t A, pool_callback_fn callback, void *user) {
+    return pool_async(pool_current(), run_max, &A, sizeof(A), callback, user);
+}
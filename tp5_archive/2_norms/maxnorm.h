@@ -0,0 +1,59 @@
+#ifndef MAXNORM_H
+#define MAXNORM_H
+
+#include <stddef.h>
+
+#include "thread_pool.h"
+#include "matrix.h"
+
+// ============================== NORME MAX =======================================
+
+/**
+ * Plus grande valeur absolue d'une matrice et position (ligne, colonne) de sa première
+ * occurrence dans l'ordre des lignes de la matrice d'origine.
+ */
+typedef struct {
+    double value;       // max |a_ij|
+    size_t i;           // Ligne de la première occurrence
+    size_t j;           // Colonne de la première occurrence
+} max_loc_t;
+
+/**
+ * Calculer séquentiellement la norme max (max |a_ij|).
+ * Définie dans `maxnorm.c`.
+ */
+double max_ref(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Même calcul, avec la position de la première occurrence du maximum.
+ */
+max_loc_t max_ref_loc(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Calculer en parallèle la norme max d'une vue quelconque (par lignes, par colonnes
+ * ou sous-matrice). Chaque tuile est parcourue par le noyau vectorisé `simd_absmax` ;
+ * les maxima locaux sont combinés selon le mode de réduction (`REDUCE_MODE`) :
+ * un maximum par thread combiné à la fin (`tree`), un maximum atomique par
+ * compare-and-swap (`atomic`) ou une section critique par tuile (`mutex`).
+ */
+double max_view(matrix_view_t A);
+
+/**
+ * Même calcul pour une matrice stockée par lignes.
+ */
+double max(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Norme max et position de sa première occurrence (mêmes indices que `max_ref_loc`),
+ * pour tout type de vue. Chaque thread garde sa meilleure position, les positions des
+ * threads sont combinées à la fin : le résultat ne dépend pas du nombre de threads.
+ */
+max_loc_t max_view_loc(matrix_view_t A);
+
+/**
+ * Version asynchrone de `max_view` sur le pool courant : retourne aussitôt un futur
+ * (voir `pool_async`) ; la matrice doit rester valide jusqu'au résultat.
+ */
+pool_future_t *max_view_async(matrix_view_t A, pool_callback_fn callback, void *user);
+
+#endif // MAXNORM_H
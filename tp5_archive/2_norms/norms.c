@@ -0,0 +1,252 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "matrix.h"
+#include "tile.h"
+#include "partition.h"
+#include "norms.h"
+
+// Groupes de rangées de tuiles en sommation compensée : nombre fixe, pour que le
+// résultat ne dépende pas du nombre de threads
+#define REPRO_GROUPS 8
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Structure pour transmettre les données nécessaires à chaque thread, chacune sur
+ * sa propre ligne de cache. Une tâche couvre un groupe de rangées de tuiles consécutives
+ * sur une colonne de tuiles : ses sommes de colonnes sont écrites dans la bande de son
+ * groupe, ses sommes de lignes dans celle de sa colonne de tuiles. Deux tâches n'écrivent
+ * jamais au même endroit, aucune synchronisation n'est requise.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) tile_t tile; // Rangées de tuiles du groupe, sur une colonne de tuiles
+    matrix_view_t A;       // Vue sur la matrice (base, dimensions et pas)
+    double *col_sums;      // Sommes partielles des colonnes du groupe de rangées (n cases)
+    double *row_sums;      // Sommes partielles des lignes de la colonne de tuiles (m cases)
+    padded_double_t *sum_sq; // Case privée de la somme des carrés (et de sa compensation)
+    padded_double_t *max_abs; // Case privée du maximum absolu
+    sum_mode_t sum;        // Mode de sommation (rapide ou compensé)
+} ThreadData;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Fonction exécutée par chaque thread : un seul parcours de la tuile accumule la
+ * somme des carrés, le maximum absolu, et les sommes des |a_ij| de chaque ligne
+ * et de chaque colonne. Les segments contigus sont traités sur quatre accumulateurs
+ * indépendants pour ne pas être limités par la latence des additions.
+ */
+void* compute_tile_norms(void *arg) {
+    ThreadData *data = (ThreadData *)arg;  // Cast du paramètre en `ThreadData`
+    ptrdiff_t stride = data->A.col_stride;
+    size_t cols = data->tile.cols;
+    double *col_sums = data->col_sums + data->tile.j0;
+    double tile_sum = 0.0, tile_error = 0.0, tile_max = 0.0;
+
+    memset(col_sums, 0, cols * sizeof(double));
+
+    for (size_t i = 0; i < data->tile.rows; ++i) {
+        double *row = matrix_at(data->A, data->tile.i0 + i, data->tile.j0);
+        double row_abs = 0.0;
+
+        // Sommation compensée : carrés sans erreur (FMA) additionnés par TwoSum
+        if (data->sum == SUM_COMPENSATED) {
+            for (size_t j = 0; j < cols; ++j) {
+                double x = row[(ptrdiff_t)j * stride];
+                double ax = fabs(x), p = x * x, e;
+                two_sum(tile_sum, p, &tile_sum, &e);
+                tile_error += e + fma(x, x, -p);
+                tile_max = ax > tile_max ? ax : tile_max;
+                row_abs += ax;
+                col_sums[j] += ax;
+            }
+            data->row_sums[data->tile.i0 + i] = row_abs;
+            continue;
+        }
+
+        // Segment contigu : quatre accumulateurs par grandeur
+        size_t j = 0;
+        if (stride == 1) {
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+            double m0 = tile_max, m1 = tile_max, m2 = tile_max, m3 = tile_max;
+            for (; j + 4 <= cols; j += 4) {
+                double x0 = fabs(row[j]), x1 = fabs(row[j + 1]);
+                double x2 = fabs(row[j + 2]), x3 = fabs(row[j + 3]);
+                s0 += x0 * x0; s1 += x1 * x1; s2 += x2 * x2; s3 += x3 * x3;
+                a0 += x0; a1 += x1; a2 += x2; a3 += x3;
+                m0 = x0 > m0 ? x0 : m0; m1 = x1 > m1 ? x1 : m1;
+                m2 = x2 > m2 ? x2 : m2; m3 = x3 > m3 ? x3 : m3;
+                col_sums[j] += x0; col_sums[j + 1] += x1;
+                col_sums[j + 2] += x2; col_sums[j + 3] += x3;
+            }
+            tile_sum += (s0 + s1) + (s2 + s3);
+            row_abs = (a0 + a1) + (a2 + a3);
+            m0 = m0 > m1 ? m0 : m1;
+            m2 = m2 > m3 ? m2 : m3;
+            tile_max = m0 > m2 ? m0 : m2;
+        }
+
+        // Reste du segment (ou segment non contigu)
+        for (; j < cols; ++j) {
+            double ax = fabs(row[(ptrdiff_t)j * stride]);
+            tile_sum += ax * ax;
+            tile_max = ax > tile_max ? ax : tile_max;
+            row_abs += ax;
+            col_sums[j] += ax;
+        }
+        data->row_sums[data->tile.i0 + i] = row_abs;
+    }
+
+    // Publier les résultats de la tuile dans ses cases privées
+    data->sum_sq->value = tile_sum;
+    data->sum_sq->error = tile_error;
+    data->max_abs->value = tile_max;
+
+    return NULL;
+}
+
+// ============================ FONCTIONS DE CALCUL ===============================
+
+norms_t norms_ref(size_t m, size_t n, double A[m][n]) {
+    norms_t r = { 0.0, 0.0, 0.0, 0.0 };
+
+    // Norme de Frobenius
+    double frob = 0.;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            frob += A[i][j] * A[i][j];
+        }
+    }
+    r.frobenius = sqrt(frob);
+
+    // Norme max
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (fabs(A[i][j]) > r.max) {
+                r.max = fabs(A[i][j]);
+            }
+        }
+    }
+
+    // Norme 1 (colonnes)
+    for (size_t j = 0; j < n; ++j) {
+        double s = 0.;
+        for (size_t i = 0; i < m; ++i) {
+            s += fabs(A[i][j]);
+        }
+        if (s > r.one) {
+            r.one = s;
+        }
+    }
+
+    // Norme infinie (lignes)
+    for (size_t i = 0; i < m; ++i) {
+        double s = 0.;
+        for (size_t j = 0; j < n; ++j) {
+            s += fabs(A[i][j]);
+        }
+        if (s > r.inf) {
+            r.inf = s;
+        }
+    }
+
+    return r;
+}
+
+/**
+ * Une vue stockée par colonnes est parcourue comme sa transposée pour que chaque
+ * tâche lise des éléments contigus ; les normes 1 et infinie sont alors échangées.
+ * Les rangées de tuiles sont regroupées en autant de groupes que de threads (un nombre
+ * fixe en sommation compensée) : chaque groupe a sa propre bande de sommes de colonnes,
+ * soit au plus `nb_threads * n` cases et non une par rangée de tuiles (une matrice large
+ * a une rangée par ligne). Les bandes sont combinées après le passage parallèle,
+ * toujours dans le même ordre.
+ */
+norms_t norms_view(matrix_view_t A) {
+    norms_t r = { 0.0, 0.0, 0.0, 0.0 };
+    bool transposed = A.col_stride != 1 && A.row_stride == 1;
+    if (transposed) {
+        A = matrix_transpose(A);
+    }
+    if (A.m == 0 || A.n == 0) {
+        return r;
+    }
+
+    // Préparer une tâche pour chaque groupe de rangées de chaque colonne de tuiles
+    sum_mode_t sum_mode = sum_get_mode();
+    size_t nb_threads = sum_mode == SUM_COMPENSATED ? 1 : pool_size(pool_current());
+    tile_plan_t plan = tile_plan(A.m, A.n, nb_threads, sizeof(double));
+    size_t nb_groups = sum_mode == SUM_COMPENSATED ? REPRO_GROUPS : nb_threads;
+    nb_groups = nb_groups < plan.nb_row_tiles ? nb_groups : plan.nb_row_tiles;
+    size_t nb_tasks = nb_groups * plan.nb_col_tiles;
+    arena_t *scratch = arena_scratch();  // Données de travail de l'appel, sans allocation
+    arena_mark_t mark = arena_mark(scratch);
+    ThreadData *thread_data = arena_alloc(scratch, nb_tasks, sizeof(ThreadData));
+    padded_double_t *sums = arena_alloc(scratch, nb_tasks, sizeof(padded_double_t));   // Sommes des carrés (une par tâche)
+    padded_double_t *maxima = arena_alloc(scratch, nb_tasks, sizeof(padded_double_t)); // Maxima absolus (un par tâche)
+    double *col_sums = arena_alloc(scratch, nb_groups, A.n * sizeof(double));          // Une bande par groupe de rangées
+    double *row_sums = arena_alloc(scratch, plan.nb_col_tiles, A.m * sizeof(double));  // Une bande par colonne de tuiles
+
+    for (size_t t = 0; t < nb_tasks; ++t) {
+        size_t g = t / plan.nb_col_tiles, tj = t % plan.nb_col_tiles, first, end;
+        partition_bounds(plan.nb_row_tiles, nb_groups, g, &first, &end);
+        tile_t top = tile_get(&plan, first * plan.nb_col_tiles + tj);
+        tile_t bottom = tile_get(&plan, (end - 1) * plan.nb_col_tiles + tj);
+        top.rows = bottom.i0 + bottom.rows - top.i0;
+        thread_data[t].tile = top;       // Rangées du groupe sur la colonne de tuiles
+        thread_data[t].A = A;            // Vue sur la matrice
+        thread_data[t].col_sums = col_sums + g * A.n;  // Bande de son groupe
+        thread_data[t].row_sums = row_sums + tj * A.m; // Bande de sa colonne
+        thread_data[t].sum_sq = &sums[t]; // Case privée de la somme des carrés
+        thread_data[t].max_abs = &maxima[t]; // Case privée du maximum
+        thread_data[t].sum = sum_mode;   // Mode de sommation
+    }
+
+    // Traiter les tâches avec le pool de threads, puis attendre la fin
+    pool_run(pool_current(), nb_tasks, compute_tile_norms, thread_data, sizeof(ThreadData));
+
+    // Combiner les résultats des tâches par un arbre
+    double frob = sum_mode == SUM_COMPENSATED ? reduce_tree_compensated(nb_tasks, sums)
+                                              : reduce_tree(nb_tasks, sums, REDUCE_SUM);
+    r.frobenius = sqrt(frob);
+    r.max = reduce_tree(nb_tasks, maxima, REDUCE_MAX);
+
+    // Combiner les sommes partielles des colonnes (norme 1) puis des lignes (norme infinie)
+    for (size_t j = 0; j < A.n; ++j) {
+        double s = 0.0;
+        for (size_t g = 0; g < nb_groups; ++g) {
+            s += col_sums[g * A.n + j];
+        }
+        r.one = s > r.one ? s : r.one;
+    }
+    for (size_t i = 0; i < A.m; ++i) {
+        double s = 0.0;
+        for (size_t tj = 0; tj < plan.nb_col_tiles; ++tj) {
+            s += row_sums[tj * A.m + i];
+        }
+        r.inf = s > r.inf ? s : r.inf;
+    }
+
+    // Rendre les données des tâches à l'arène
+    arena_release(scratch, mark);
+
+    // Vue transposée : les colonnes parcourues sont les lignes de la matrice d'origine
+    if (transposed) {
+        double one = r.one;
+        r.one = r.inf;
+        r.inf = one;
+    }
+
+    return r;
+}
+
+norms_t norms(size_t m, size_t n, double A[m][n]) {
+    return norms_view(matrix_row_major(m, n, n, &A[0][0]));
+}
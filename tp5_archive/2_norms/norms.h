@@ -0,0 +1,82 @@
+#ifndef NORMS_H
+#define NORMS_H
+
+#include <stddef.h>
+
+#include "matrix.h"
+#include "simd_typed.h"
+#include "sparse.h"
+
+// ========================= NORMES MATRICIELLES FUSIONNÉES =======================
+
+/**
+ * Normes d'une même matrice, obtenues en une seule lecture de celle-ci.
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+    double one;         // Norme 1 : plus grande somme des |a_ij| d'une colonne
+    double inf;         // Norme infinie : plus grande somme des |a_ij| d'une ligne
+} norms_t;
+
+/**
+ * Calculer séquentiellement les quatre normes (une boucle par norme).
+ * Définie dans `norms.c`.
+ */
+norms_t norms_ref(size_t m, size_t n, double A[m][n]);
+
+/**
+ * Calculer en parallèle les quatre normes d'une vue quelconque en un seul passage :
+ * chaque tuile accumule à la fois sa somme des carrés, son maximum absolu et ses
+ * sommes partielles de lignes et de colonnes. Définie dans `norms.c`.
+ */
+norms_t norms_view(matrix_view_t A);
+
+/**
+ * Même calcul pour une matrice stockée par lignes.
+ */
+norms_t norms(size_t m, size_t n, double A[m][n]);
+
+// ===================== NORMES EN PRÉCISION RÉDUITE ==============================
+
+/**
+ * Norme de Frobenius et norme max d'une matrice stockée de façon contiguë : ces deux
+ * normes ne dépendent pas de la forme de la matrice, seulement de ses éléments.
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+} elem_norms_t;
+
+/**
+ * Variantes typées, une par ligne de `SIMD_ELEM_TYPES` :
+ *   elem_norms_t norms_f32 (size_t count, const float *A);
+ *   elem_norms_t norms_bf16(size_t count, const bf16_t *A);
+ *   elem_norms_t norms_f16 (size_t count, const f16_t *A);
+ *   elem_norms_t norms_i8  (size_t count, const int8_t *A);
+ * Les `count` éléments sont découpés en blocs (voir `partition.h`) ; chaque bloc est lu
+ * dans son format d'origine par les noyaux de `simd_typed.h` (somme des carrés dans
+ * l'accumulateur du type, exacte en int8, et maximum absolu). Définies dans `norms_typed.c`.
+ */
+#define DECLARE_NORMS_TYPED(SUFFIX, ELEM_T, PART_T, TOTAL_T) \
+    elem_norms_t norms_##SUFFIX(size_t count, const ELEM_T *A);
+SIMD_ELEM_TYPES(DECLARE_NORMS_TYPED)
+
+// ========================= NORMES D'UNE MATRICE CREUSE ==========================
+
+/**
+ * Normes d'une matrice creuse, calculées sur ses seuls éléments stockés.
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+    double inf;         // Norme infinie : plus grande somme des |a_ij| d'une ligne
+} csr_norms_t;
+
+/**
+ * Calculer en parallèle les normes d'une matrice CSR, le travail étant découpé par
+ * nombre d'éléments stockés et non par ligne. Définie dans `norms_csr.c`.
+ */
+csr_norms_t norms_csr(const csr_t *A);
+
+#endif // NORMS_H
@@ -0,0 +1,123 @@
+#include <stddef.h>
+#include <math.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_dot.h"
+#include "simd_max.h"
+#include "alloc.h"
+#include "sparse.h"
+#include "norms.h"
+
+// ======================== STRUCTURE POUR LES THREADS ===========================
+
+/**
+ * Bloc [start, end) des éléments stockés d'une matrice CSR. Un bloc peut commencer et
+ * finir au milieu d'une ligne : les sommes des lignes de ses bords sont gardées à part
+ * pour être complétées par les blocs voisins, celles des lignes entièrement dans le
+ * bloc sont réduites à leur maximum.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) const csr_t *A; // Matrice creuse
+    size_t start;          // Premier élément stocké du bloc
+    size_t end;            // Fin du bloc (exclue)
+    double sum_sq;         // Somme des carrés du bloc
+    double max_abs;        // Maximum absolu du bloc
+    size_t head_row;       // Ligne du premier élément
+    double head_sum;       // Somme des |a_ij| de cette ligne dans le bloc
+    size_t tail_row;       // Ligne du dernier élément
+    double tail_sum;       // Somme des |a_ij| de cette ligne dans le bloc (si différente)
+    double inner_max;      // Plus grande somme d'une ligne entièrement dans le bloc
+} CsrTask;
+
+// ======================= FONCTION EXECUTÉE PAR LES THREADS =====================
+
+/**
+ * Somme des carrés et maximum absolu du tableau des valeurs du bloc (noyaux vectoriels),
+ * puis sommes des |a_ij| ligne par ligne à partir de la ligne du premier élément.
+ */
+static void *compute_csr_block(void *arg) {
+    CsrTask *task = (CsrTask *)arg;
+    const csr_t *A = task->A;
+    const double *value = A->value + task->start;
+    size_t len = task->end - task->start;
+
+    task->sum_sq = simd_dot(len, value, value);
+    task->max_abs = simd_absmax(len, value);
+
+    size_t row = csr_row_of(A, task->start);
+    size_t k = task->start;
+    task->head_row = row;
+    task->inner_max = 0.0;
+    for (; k < task->end; ++row) {
+        size_t row_end = A->row_ptr[row + 1] < task->end ? A->row_ptr[row + 1] : task->end;
+        double sum = 0.0;
+        for (; k < row_end; ++k) {
+            sum += fabs(A->value[k]);
+        }
+
+        if (row == task->head_row) {
+            task->head_sum = sum;
+        } else if (k < task->end) {
+            task->inner_max = sum > task->inner_max ? sum : task->inner_max;
+        }
+        task->tail_row = row;
+        task->tail_sum = sum;
+    }
+    return NULL;
+}
+
+// ============================ FONCTION DE CALCUL ===============================
+
+/**
+ * Normes de Frobenius, max et infinie d'une matrice CSR. Les éléments stockés sont
+ * découpés en blocs de même taille, quelle que soit la longueur des lignes : une ligne
+ * très remplie est partagée entre plusieurs tâches au lieu d'en retarder une seule.
+ * Les sommes des lignes coupées sont reconstituées en combinant les bords des blocs dans
+ * l'ordre. Définie dans `norms_csr.c`.
+ */
+csr_norms_t norms_csr(const csr_t *A) {
+    size_t nb_blocks = partition_count(A->nnz, 0, pool_size(pool_current()), sizeof(size_t) + 2 * sizeof(double));
+    if (nb_blocks == 0) {
+        return (csr_norms_t){ 0.0, 0.0, 0.0 };
+    }
+
+    arena_t *scratch = arena_scratch();
+    arena_mark_t mark = arena_mark(scratch);
+    CsrTask *tasks = arena_alloc(scratch, nb_blocks, sizeof(CsrTask));
+    for (size_t i = 0; i < nb_blocks; ++i) {
+        tasks[i].A = A;
+        partition_bounds(A->nnz, nb_blocks, i, &tasks[i].start, &tasks[i].end);
+    }
+
+    pool_run(pool_current(), nb_blocks, compute_csr_block, tasks, sizeof(CsrTask));
+
+    // Ligne en cours (commencée dans un bloc précédent) et sa somme partielle
+    double sum = 0.0, max = 0.0, inf = 0.0;
+    size_t carry_row = tasks[0].head_row;
+    double carry_sum = 0.0;
+    for (size_t i = 0; i < nb_blocks; ++i) {
+        const CsrTask *t = &tasks[i];
+        sum += t->sum_sq;
+        max = t->max_abs > max ? t->max_abs : max;
+
+        if (t->head_row == carry_row) {
+            carry_sum += t->head_sum;
+        } else {
+            inf = carry_sum > inf ? carry_sum : inf;
+            carry_row = t->head_row;
+            carry_sum = t->head_sum;
+        }
+        if (t->tail_row != t->head_row) {
+            inf = carry_sum > inf ? carry_sum : inf;
+            inf = t->inner_max > inf ? t->inner_max : inf;
+            carry_row = t->tail_row;
+            carry_sum = t->tail_sum;
+        }
+    }
+    inf = carry_sum > inf ? carry_sum : inf;
+
+    arena_release(scratch, mark);
+    return (csr_norms_t){ sqrt(sum), max, inf };
+}
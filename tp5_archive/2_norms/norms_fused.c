@@ -0,0 +1,141 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "args.h"
+#include "matrix.h"
+#include "timer.h"
+#include "mapfile.h"
+#include "norms.h"
+
+// Dimensions par défaut (modifiables par `--m`/`--n` ou `SIZE_M`/`SIZE_N`)
+#define M 5  // Nombre de lignes
+#define N 8  // Nombre de colonnes
+#define PRINT_MAX 16  // Dimension maximale des matrices affichées
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Initialiser une matrice avec des valeurs incrémentales de signe alterné
+ * (pour que les normes 1, infinie et max dépendent bien des valeurs absolues).
+ */
+void initMatrix(size_t m, size_t n, double A[m][n]) {
+    double elem = 0.;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            A[i][j] = (i + j) % 2 ? -elem : elem;
+            elem += 1.;
+        }
+    }
+}
+
+/**
+ * Afficher une matrice.
+ */
+void printMatrix(size_t m, size_t n, double A[m][n]) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            printf("%lf ", A[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * Vérifier si deux nombres flottants sont proches (à une tolérance donnée).
+ */
+inline bool isClose(double a, double b, double threshold) {
+    return fabs(a - b) <= threshold;
+}
+
+/**
+ * Comparer les quatre normes à la référence. La somme des carrés a une erreur
+ * relative bornée par m * n * epsilon, une somme de ligne (colonne) par n (m) * epsilon ;
+ * le maximum est exact.
+ */
+bool normsClose(size_t m, size_t n, norms_t ref, norms_t res) {
+    return isClose(ref.frobenius, res.frobenius, m * n * DBL_EPSILON * fmax(1., ref.frobenius))
+        && isClose(ref.one, res.one, m * DBL_EPSILON * fmax(1., ref.one))
+        && isClose(ref.inf, res.inf, n * DBL_EPSILON * fmax(1., ref.inf))
+        && ref.max == res.max;
+}
+
+// =============================== MAIN ===========================================
+
+int main(int argc, char **argv) {
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);  // Nombre de lignes
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);  // Nombre de colonnes
+    const char *path = arg_string(argc, argv, "input", "INPUT", NULL);  // Fichier de la matrice (brut ou .npy)
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *data;
+    bool fortran = false;  // Fichier en ordre Fortran : A est alors la transposée de la matrice lue
+    mapped_array_t map = { 0 };
+    if (path) {
+        // Matrice lue sur disque : projetée en mémoire et passée telle quelle aux noyaux
+        map = mapfile_open(path, mapfile_get_mode());
+        fortran = mapfile_matrix_shape(&map, n, &m, &n);
+        data = map.data;
+    } else {
+        // Allocation (sur le tas) et initialisation de la matrice
+        data = alloc_array(m, n * sizeof(double));
+        initMatrix(m, n, (double (*)[n])data);
+    }
+    double (*A)[n] = (double (*)[n])data;
+
+    // Affichage de la matrice (seulement si elle est petite)
+    if (m <= PRINT_MAX && n <= PRINT_MAX) {
+        printf("Matrice A =\n");
+        printMatrix(m, n, A);
+    }
+
+    // Calcul des normes en version séquentielle (un parcours par norme)
+    double t0 = timer_now();
+    norms_t ref = norms_ref(m, n, A);
+    double t_ref = timer_now() - t0;
+
+    // Calcul des normes en version parallèle (un seul parcours)
+    t0 = timer_now();
+    norms_t res = norms(m, n, A);
+    double t_res = timer_now() - t0;
+
+    // Même calcul sur la transposée, vue par colonnes sans copie (normes 1 et infinie échangées)
+    norms_t res_t = norms_view(matrix_col_major(n, m, n, &A[0][0]));
+    double swap = res_t.one;
+    res_t.one = res_t.inf;
+    res_t.inf = swap;
+
+    // Ordre Fortran : les normes 1 et infinie de la matrice du fichier sont celles de A échangées
+    if (fortran) {
+        printf("\nFichier en ordre Fortran : normes 1 et infinie de la transposée ci-dessous\n");
+    }
+
+    // Affichage des résultats
+    printf("\nRéférence  : frobenius=%.17g max=%.17g un=%.17g inf=%.17g (%.3f ms)\n",
+           ref.frobenius, ref.max, ref.one, ref.inf, 1e3 * t_ref);
+    printf("Fusionnée  : frobenius=%.17g max=%.17g un=%.17g inf=%.17g (%.3f ms, %zu threads, %s)\n",
+           res.frobenius, res.max, res.one, res.inf, 1e3 * t_res, pool_size(pool_global()),
+           sum_mode_name(sum_get_mode()));
+    printf("Transposée : frobenius=%.17g max=%.17g un=%.17g inf=%.17g\n",
+           res_t.frobenius, res_t.max, res_t.one, res_t.inf);
+
+    // Vérification de la validité des résultats
+    if (normsClose(m, n, ref, res) && normsClose(m, n, ref, res_t)) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    if (path) {
+        mapfile_close(&map);
+    } else {
+        alloc_free(A);
+    }
+
+    return 0;
+}
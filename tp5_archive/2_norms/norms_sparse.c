@@ -0,0 +1,97 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "thread_pool.h"
+#include "sparse.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+#include "norms.h"
+
+// Valeurs par défaut (modifiables par `--m`/`--n`/`--density`/`--reps` ou `SIZE_M`/`SIZE_N`/`DENSITY`/`REPS`)
+#define M 5          // Nombre de lignes
+#define N 8          // Nombre de colonnes
+#define DENSITY 10   // Pourcentage d'éléments non nuls hors des lignes pleines
+#define REPS 5       // Répétitions de chaque mesure (on garde la plus rapide)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Matrice creuse déséquilibrée : la première ligne et une ligne sur 64 sont pleines,
+ * les autres contiennent environ `density` % d'éléments non nuls. Un découpage par
+ * lignes laisserait les lignes pleines à quelques tâches. Valeurs multiples de 1/16.
+ */
+static void fillSkewed(size_t m, size_t n, size_t density, double *A) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            size_t h = (i * n + j) * 7919;
+            bool stored = i % 64 == 0 || h % 100 < density;
+            A[i * n + j] = stored ? ((double)(h % 255) - 127.0) / 16.0 : 0.0;
+        }
+    }
+}
+
+// Meilleur temps de `reps` appels de EXPR, résultat dans RES
+#define TIME_BEST(RES, EXPR, reps, best)            \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            RES = (EXPR);                           \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Normes d'une matrice creuse au format CSR (`norms_csr`), comparées au calcul dense
+ * de la même matrice (`norms`) et vérifiées avec `norms_ref`.
+ */
+int main(int argc, char **argv) {
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t density = arg_size(argc, argv, "density", "DENSITY", DENSITY);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    reps = reps ? reps : 1;
+    density = density < 100 ? density : 100;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *A = alloc_array(m * n, sizeof(double));
+    fillSkewed(m, n, density, A);
+    csr_t S = csr_from_dense(m, n, A);
+
+    norms_t ref = norms_ref(m, n, (double (*)[n])A);
+    printf("Matrice %zu x %zu, %zu éléments non nuls, %zu threads\n", m, n, S.nnz, pool_size(pool_global()));
+    printf("Référence : frobenius %.10g  max %g  inf %g\n\n", ref.frobenius, ref.max, ref.inf);
+
+    double best;
+    norms_t res_d;
+    csr_norms_t res;
+
+    TIME_BEST(res_d, norms(m, n, (double (*)[n])A), reps, best);
+    printf("dense (norms)     %10.6f s  frobenius %.10g  max %g  inf %g\n", best, res_d.frobenius, res_d.max,
+           res_d.inf);
+
+    TIME_BEST(res, norms_csr(&S), reps, best);
+    double tol = S.nnz * DBL_EPSILON;
+    bool ok = fabs(res.frobenius - ref.frobenius) <= tol * fmax(1., ref.frobenius) && res.max == ref.max &&
+              fabs(res.inf - ref.inf) <= tol * fmax(1., ref.inf);
+    printf("CSR   (norms_csr) %10.6f s  frobenius %.10g  max %g  inf %g  %s\n", best, res.frobenius, res.max,
+           res.inf, ok ? "OK" : "ERREUR");
+
+    if (ok) {
+        printf("\nRésultat correct : OK\n");
+    } else {
+        printf("\nErreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    csr_free(&S);
+    alloc_free(A);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "simd_typed.h"
+#include "alloc.h"
+#include "norms.h"
+
+// ================== NORMES DE FROBENIUS ET MAX, TOUS LES TYPES ==================
+
+/**
+ * Génère, pour une ligne de `SIMD_ELEM_TYPES`, la tâche et la fonction parallèle
+ * `norms_<suffixe>`. Chaque bloc tient dans la moitié du cache L2 : la somme des carrés
+ * (produit scalaire du bloc avec lui-même) puis le maximum absolu relisent le bloc dans
+ * le cache, la mémoire n'est parcourue qu'une fois. Les résultats des tâches sont dans
+ * leur propre structure (une ligne de cache), combinés dans l'ordre des blocs.
+ */
+#define DEFINE_NORMS_TYPED(SUFFIX, ELEM_T, PART_T, TOTAL_T)                             \
+    typedef struct {                                                                    \
+        _Alignas(CACHE_LINE) const ELEM_T *A; /* Éléments de la matrice */              \
+        size_t start;      /* Index de début du bloc */                                 \
+        size_t end;        /* Index de fin du bloc */                                   \
+        PART_T sum_sq;     /* Somme des carrés du bloc */                               \
+        TOTAL_T max_abs;   /* Maximum absolu du bloc */                                 \
+    } NormsTask_##SUFFIX;                                                               \
+                                                                                        \
+    static void *compute_block_##SUFFIX(void *arg) {                                    \
+        NormsTask_##SUFFIX *task = (NormsTask_##SUFFIX *)arg;                           \
+        const ELEM_T *block = task->A + task->start;                                    \
+        size_t len = task->end - task->start;                                           \
+        task->sum_sq = simd_dot_##SUFFIX(len, block, block);                            \
+        task->max_abs = simd_absmax_##SUFFIX(len, block);                               \
+        return NULL;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    elem_norms_t norms_##SUFFIX(size_t count, const ELEM_T *A) {                        \
+        size_t nb_blocks = partition_count(count, 0, pool_size(pool_current()), sizeof(ELEM_T)); \
+        arena_t *scratch = arena_scratch();                                             \
+        arena_mark_t mark = arena_mark(scratch);                                        \
+        NormsTask_##SUFFIX *tasks = arena_alloc(scratch, nb_blocks, sizeof(NormsTask_##SUFFIX)); \
+        for (size_t i = 0; i < nb_blocks; ++i) {                                        \
+            tasks[i].A = A;                                                             \
+            partition_bounds(count, nb_blocks, i, &tasks[i].start, &tasks[i].end);      \
+        }                                                                               \
+                                                                                        \
+        pool_run(pool_current(), nb_blocks, compute_block_##SUFFIX, tasks, sizeof(NormsTask_##SUFFIX)); \
+                                                                                        \
+        TOTAL_T sum = 0, max = 0;                                                       \
+        for (size_t i = 0; i < nb_blocks; ++i) {                                        \
+            sum += (TOTAL_T)tasks[i].sum_sq;                                            \
+            max = tasks[i].max_abs > max ? tasks[i].max_abs : max;                      \
+        }                                                                               \
+        arena_release(scratch, mark);                                                   \
+        return (elem_norms_t){ sqrt((double)sum), (double)max };                        \
+    }
+
+SIMD_ELEM_TYPES(DEFINE_NORMS_TYPED)
@@ -0,0 +1,136 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "thread_pool.h"
+#include "simd_dot.h"
+#include "simd_typed.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+#include "norms.h"
+
+// Valeurs par défaut (modifiables par `--m`/`--n`/`--reps` ou `SIZE_M`/`SIZE_N`/`REPS`)
+#define M 5      // Nombre de lignes
+#define N 8      // Nombre de colonnes
+#define REPS 5   // Répétitions de chaque mesure (on garde la plus rapide)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Entier pseudo-aléatoire de [-127, 127], représentable exactement dans tous les types.
+ */
+static int elemValue(size_t i) {
+    return (int)((i * 7919) % 255) - 127;
+}
+
+/**
+ * Comparer les normes à la référence : la somme des carrés a une erreur relative
+ * bornée par count * eps (précision de l'accumulateur), le maximum est exact.
+ */
+static bool elemNormsClose(size_t count, double eps, norms_t ref, elem_norms_t res) {
+    return fabs(ref.frobenius - res.frobenius) <= count * eps * fmax(1., ref.frobenius) && ref.max == res.max;
+}
+
+/**
+ * Afficher une mesure : meilleur temps, éléments et octets lus par seconde.
+ */
+static void printTiming(const char *type, size_t count, size_t elem_size, double seconds, elem_norms_t r, bool ok) {
+    printf("%-6s %10.6f s  %8.3f Gélém/s  %8.3f Go/s  frobenius %.10g  max %g  %s\n", type, seconds,
+           count / seconds / 1e9, (double)count * elem_size / seconds / 1e9, r.frobenius, r.max, ok ? "OK" : "ERREUR");
+}
+
+// Meilleur temps de `reps` appels de EXPR, résultat dans RES
+#define TIME_BEST(RES, EXPR, reps, best)            \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            RES = (EXPR);                           \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Normes de Frobenius et max de la même matrice en double (`norms`), float32, bf16, f16
+ * et int8 : chaque variante lit ses éléments dans son format d'origine. Les résultats
+ * sont comparés à `norms_ref` (valeurs v / 16 en flottant, v en entier).
+ */
+int main(int argc, char **argv) {
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    size_t count = m * n;
+    reps = reps ? reps : 1;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    double *A = alloc_array(count, sizeof(double));
+    float *F = alloc_array(count, sizeof(float));
+    bf16_t *B = alloc_array(count, sizeof(bf16_t));
+    f16_t *H = alloc_array(count, sizeof(f16_t));
+    int8_t *I = alloc_array(count, sizeof(int8_t));
+    for (size_t i = 0; i < count; ++i) {
+        int v = elemValue(i);
+        A[i] = v / 16.0;
+        F[i] = (float)A[i];
+        B[i] = float_to_bf16(F[i]);
+        H[i] = float_to_f16(F[i]);
+        I[i] = (int8_t)v;
+    }
+
+    norms_t ref = norms_ref(m, n, (double (*)[n])A);
+    norms_t ref_i8 = { 16.0 * ref.frobenius, 16.0 * ref.max, 0.0, 0.0 };  // Même matrice, multipliée par 16
+    printf("Matrice %zu x %zu, %zu threads, noyau %s\n", m, n, pool_size(pool_global()), simd_dot_name());
+    printf("Référence : frobenius %.10g  max %g\n\n", ref.frobenius, ref.max);
+
+    double best;
+    norms_t res_d;
+    elem_norms_t res;
+    bool ok, all_ok = true;
+
+    TIME_BEST(res_d, norms(m, n, (double (*)[n])A), reps, best);
+    ok = elemNormsClose(count, DBL_EPSILON, ref, (elem_norms_t){ res_d.frobenius, res_d.max });
+    printTiming("double", count, sizeof(double), best, (elem_norms_t){ res_d.frobenius, res_d.max }, ok);
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res, norms_f32(count, F), reps, best);
+    ok = elemNormsClose(count, DBL_EPSILON, ref, res);
+    printTiming("f32", count, sizeof(float), best, res, ok);
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res, norms_bf16(count, B), reps, best);
+    ok = elemNormsClose(count, FLT_EPSILON, ref, res);
+    printTiming("bf16", count, sizeof(bf16_t), best, res, ok);
+    all_ok = all_ok && ok;
+
+    TIME_BEST(res, norms_f16(count, H), reps, best);
+    ok = elemNormsClose(count, FLT_EPSILON, ref, res);
+    printTiming("f16", count, sizeof(f16_t), best, res, ok);
+    all_ok = all_ok && ok;
+
+    // Entiers : somme des carrés exacte, seule la racine carrée est arrondie
+    TIME_BEST(res, norms_i8(count, I), reps, best);
+    ok = elemNormsClose(count, DBL_EPSILON, ref_i8, res);
+    printTiming("i8", count, sizeof(int8_t), best, res, ok);
+    all_ok = all_ok && ok;
+
+    if (all_ok) {
+        printf("\nRésultat correct : OK\n");
+    } else {
+        printf("\nErreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    alloc_free(A);
+    alloc_free(F);
+    alloc_free(B);
+    alloc_free(H);
+    alloc_free(I);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <pthread.h>
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include "partition.h"
+#include "matrix.h"
+#include "dotprod.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+#include "dist.h"
+
+// ============================ PROCESSUS =========================================
+
+static int rank = 0;
+static int size = 1;
+
+void dist_init(int *argc, char ***argv) {
+#ifdef USE_MPI
+    // Les workers du pool ne communiquent pas : seul le thread principal appelle MPI
+    int provided;
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#else
+    (void)argc;
+    (void)argv;
+#endif
+}
+
+void dist_finalize(void) {
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
+}
+
+int dist_rank(void) {
+    return rank;
+}
+
+int dist_size(void) {
+    return size;
+}
+
+void dist_shard(size_t n, size_t *start, size_t *end) {
+    partition_bounds(n, (size_t)size, (size_t)rank, start, end);
+}
+
+// ============================ RECOUVREMENT ======================================
+
+static size_t overlap = 1;
+static pthread_once_t overlap_once = PTHREAD_ONCE_INIT;
+
+static void overlap_init(void) {
+    const char *env = getenv("DIST_OVERLAP");
+    if (env) {
+        dist_set_overlap(strtoul(env, NULL, 10));
+    }
+}
+
+size_t dist_get_overlap(void) {
+    pthread_once(&overlap_once, overlap_init);
+    return overlap;
+}
+
+void dist_set_overlap(size_t chunks) {
+    overlap = chunks == 0 ? 1 : chunks < DIST_OVERLAP_MAX ? chunks : DIST_OVERLAP_MAX;
+}
+
+// ========================= RÉDUCTION EN MORCEAUX ================================
+
+/**
+ * Réduction locale des éléments (ou lignes) [start, end) de la part du rang.
+ */
+typedef double (*local_fn)(size_t start, size_t end, const void *arg);
+
+/**
+ * Réduire localement la part de `n` éléments, morceau par morceau, et combiner chaque
+ * morceau entre les rangs (somme ou maximum). Les morceaux sont additionnés dans leur
+ * ordre : le résultat est le même sur tous les rangs.
+ * Les parts des rangs diffèrent d'un élément quand la taille globale ne se divise pas :
+ * le nombre de morceaux ne dépend donc pas de `n`, pour que tous les rangs lancent les
+ * mêmes réductions collectives. Un morceau vide vaut 0, neutre pour la somme comme
+ * pour le maximum absolu.
+ */
+static double dist_reduce(size_t n, local_fn fn, const void *arg, bool is_max) {
+    size_t chunks = dist_get_overlap();
+    double local[DIST_OVERLAP_MAX] = { 0 }, global[DIST_OVERLAP_MAX] = { 0 };
+
+#ifdef USE_MPI
+    MPI_Op op = is_max ? MPI_MAX : MPI_SUM;
+    MPI_Request requests[DIST_OVERLAP_MAX];
+#endif
+
+    for (size_t c = 0; c < chunks; ++c) {
+        size_t start, end;
+        partition_bounds(n, chunks, c, &start, &end);
+        local[c] = fn(start, end, arg);
+#ifdef USE_MPI
+        // Réduction collective lancée sans attendre, recouverte par le morceau suivant
+        if (chunks > 1) {
+            MPI_Iallreduce(&local[c], &global[c], 1, MPI_DOUBLE, op, MPI_COMM_WORLD, &requests[c]);
+        }
+#else
+        global[c] = local[c];
+#endif
+    }
+
+#ifdef USE_MPI
+    if (chunks > 1) {
+        MPI_Waitall((int)chunks, requests, MPI_STATUSES_IGNORE);
+    } else {
+        MPI_Allreduce(&local[0], &global[0], 1, MPI_DOUBLE, op, MPI_COMM_WORLD);
+    }
+#endif
+
+    double res = global[0];
+    for (size_t c = 1; c < chunks; ++c) {
+        res = is_max ? fmax(res, global[c]) : res + global[c];
+    }
+    return res;
+}
+
+// ============================ NOYAUX RÉPARTIS ===================================
+
+typedef struct {
+    double *a;
+    double *b;
+} DotArgs;
+
+static double local_dot(size_t start, size_t end, const void *arg) {
+    const DotArgs *args = (const DotArgs *)arg;
+    return dotprod_blocks(end - start, 0, args->a + start, args->b + start);
+}
+
+static double local_sum_sq(size_t start, size_t end, const void *arg) {
+    const matrix_view_t *A = (const matrix_view_t *)arg;
+    return frobenius_sq_view(matrix_sub(*A, start, 0, end - start, A->n));
+}
+
+static double local_max(size_t start, size_t end, const void *arg) {
+    const matrix_view_t *A = (const matrix_view_t *)arg;
+    return max_view(matrix_sub(*A, start, 0, end - start, A->n));
+}
+
+double dist_dot(size_t n, double a[n], double b[n]) {
+    DotArgs args = { a, b };
+    return dist_reduce(n, local_dot, &args, false);
+}
+
+double dist_frobenius(matrix_view_t A) {
+    return sqrt(dist_reduce(A.m, local_sum_sq, &A, false));
+}
+
+double dist_max(matrix_view_t A) {
+    return dist_reduce(A.m, local_max, &A, true);
+}
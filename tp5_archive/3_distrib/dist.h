@@ -0,0 +1,68 @@
+#ifndef DIST_H
+#define DIST_H
+
+#include <stddef.h>
+
+#include "matrix.h"
+
+// ================= RÉDUCTIONS RÉPARTIES SUR PLUSIEURS PROCESSUS =================
+
+/**
+ * Les vecteurs et les matrices sont répartis entre les processus (rangs MPI) : chaque
+ * rang ne possède que sa part (voir `dist_shard`) et la réduit localement avec le pool
+ * de threads (`dotprod_blocks`, `frobenius_sq_view`, `max_view`), puis un seul
+ * `MPI_Allreduce` combine les résultats des rangs (somme ou maximum). Tous les rangs
+ * obtiennent le même résultat.
+ *
+ * Compilé sans `USE_MPI`, le même code tourne sur un seul processus (rang 0 sur 1) :
+ * la part locale est alors le problème entier et aucune communication n'a lieu.
+ *
+ * Recouvrement (`DIST_OVERLAP`, ou `dist_set_overlap`) : avec k > 1, la part locale est
+ * réduite en k morceaux ; la réduction collective de chaque morceau (`MPI_Iallreduce`)
+ * est lancée dès qu'il est calculé et progresse pendant le calcul des suivants : seule
+ * celle du dernier morceau reste à attendre.
+ *
+ * En sommation compensée, le résultat de chaque rang ne dépend pas du nombre de threads,
+ * mais la somme des rangs dépend de leur nombre.
+ */
+
+// Nombre maximal de morceaux recouverts
+#define DIST_OVERLAP_MAX 16
+
+/**
+ * Démarrer et arrêter la couche de communication (seul le thread principal communique).
+ */
+void dist_init(int *argc, char ***argv);
+void dist_finalize(void);
+
+/**
+ * Rang du processus et nombre de processus.
+ */
+int dist_rank(void);
+int dist_size(void);
+
+/**
+ * Part [start, end) du rang courant parmi `n` éléments (ou lignes) répartis en blocs
+ * contigus, le reste allant aux derniers rangs (voir `partition_bounds`).
+ */
+void dist_shard(size_t n, size_t *start, size_t *end);
+
+/**
+ * Nombre de morceaux recouverts (1 : une seule réduction collective, après le calcul local).
+ */
+size_t dist_get_overlap(void);
+void dist_set_overlap(size_t chunks);
+
+/**
+ * Produit scalaire global des vecteurs répartis, à partir des `n` éléments locaux.
+ */
+double dist_dot(size_t n, double a[n], double b[n]);
+
+/**
+ * Normes de Frobenius et max d'une matrice répartie par lignes, à partir des lignes
+ * locales `A`.
+ */
+double dist_frobenius(matrix_view_t A);
+double dist_max(matrix_view_t A);
+
+#endif // DIST_H
@@ -0,0 +1,134 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "thread_pool.h"
+#include "alloc.h"
+#include "args.h"
+#include "timer.h"
+#include "matrix.h"
+#include "dotprod.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+#include "dist.h"
+
+// Valeurs par défaut (modifiables par `--n`/`--m`/`--cols`/`--overlap`/`--reps`
+// ou `SIZE_N`/`SIZE_M`/`SIZE_COLS`/`DIST_OVERLAP`/`REPS`)
+#define N 1000     // Longueur globale des vecteurs
+#define M 200      // Nombre global de lignes de la matrice
+#define COLS 100   // Nombre de colonnes de la matrice
+#define REPS 5     // Répétitions de chaque mesure (on garde la plus rapide)
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Valeur pseudo-aléatoire de [-1, 1] de l'élément d'indice global `i`, multiple de
+ * 1/64 : chaque rang remplit sa part sans connaître les autres, et les sommes de
+ * produits sont exactes quel que soit l'ordre des additions.
+ */
+static double elemValue(size_t i, size_t prime) {
+    return ((double)((i * prime) % 129) - 64.0) / 64.0;
+}
+
+// Meilleur temps de `reps` appels de EXPR, résultat dans RES
+#define TIME_BEST(RES, EXPR, reps, best)            \
+    do {                                            \
+        best = INFINITY;                            \
+        for (size_t r = 0; r < (reps); ++r) {       \
+            double t0 = timer_now();                \
+            RES = (EXPR);                           \
+            double t = timer_now() - t0;            \
+            best = t < best ? t : best;             \
+        }                                           \
+    } while (0)
+
+// =============================== MAIN ===========================================
+
+/**
+ * Produit scalaire et normes de données réparties entre les rangs : chaque rang remplit
+ * et réduit sa part (`dist_dot`, `dist_frobenius`, `dist_max`), puis les résultats sont
+ * combinés entre les rangs. Le rang 0 reconstruit les données entières pour les
+ * vérifier avec les fonctions séquentielles de référence.
+ */
+int main(int argc, char **argv) {
+    dist_init(&argc, &argv);
+    size_t n = arg_size(argc, argv, "n", "SIZE_N", N);
+    size_t m = arg_size(argc, argv, "m", "SIZE_M", M);
+    size_t cols = arg_size(argc, argv, "cols", "SIZE_COLS", COLS);
+    size_t reps = arg_size(argc, argv, "reps", "REPS", REPS);
+    dist_set_overlap(arg_size(argc, argv, "overlap", "DIST_OVERLAP", dist_get_overlap()));
+    reps = reps ? reps : 1;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    // Part locale des vecteurs et des lignes de la matrice
+    size_t v0, v1, r0, r1;
+    dist_shard(n, &v0, &v1);
+    dist_shard(m, &r0, &r1);
+    size_t nv = v1 - v0, nr = r1 - r0;
+    double *a = alloc_array(nv, sizeof(double));
+    double *b = alloc_array(nv, sizeof(double));
+    double *A = alloc_array(nr * cols, sizeof(double));
+    for (size_t i = 0; i < nv; ++i) {
+        a[i] = elemValue(v0 + i, 7919);
+        b[i] = elemValue(v0 + i, 104729);
+    }
+    for (size_t i = 0; i < nr * cols; ++i) {
+        A[i] = elemValue(r0 * cols + i, 15485863);
+    }
+    matrix_view_t local = matrix_row_major(nr, cols, cols, A);
+
+    double t_dot, t_frob, t_max, dot, frob, max_abs;
+    TIME_BEST(dot, dist_dot(nv, a, b), reps, t_dot);
+    TIME_BEST(frob, dist_frobenius(local), reps, t_frob);
+    TIME_BEST(max_abs, dist_max(local), reps, t_max);
+
+    if (dist_rank() == 0) {
+        printf("%d processus x %zu threads, %zu morceaux recouverts ; vecteurs de %zu, matrice %zu x %zu\n",
+               dist_size(), pool_size(pool_global()), dist_get_overlap(), n, m, cols);
+
+        // Données entières, reconstruites à partir des indices globaux
+        double *ga = alloc_array(n, sizeof(double));
+        double *gb = alloc_array(n, sizeof(double));
+        double *gA = alloc_array(m * cols, sizeof(double));
+        double abs_dot = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            ga[i] = elemValue(i, 7919);
+            gb[i] = elemValue(i, 104729);
+            abs_dot += fabs(ga[i] * gb[i]);
+        }
+        for (size_t i = 0; i < m * cols; ++i) {
+            gA[i] = elemValue(i, 15485863);
+        }
+        double dot_ref = dotprod_ref(n, ga, gb);
+        double frob_ref = frobenius_ref(m, cols, (double (*)[cols])gA);
+        double max_abs_ref = max_ref(m, cols, (double (*)[cols])gA);
+
+        bool ok_dot = fabs(dot - dot_ref) <= n * DBL_EPSILON * fmax(1., abs_dot);
+        bool ok_frob = fabs(frob - frob_ref) <= m * cols * DBL_EPSILON * fmax(1., frob_ref);
+        bool ok_max = max_abs == max_abs_ref;
+        printf("dot       %10.6f s  %.17g (référence %.17g)  %s\n", t_dot, dot, dot_ref, ok_dot ? "OK" : "ERREUR");
+        printf("frobenius %10.6f s  %.17g (référence %.17g)  %s\n", t_frob, frob, frob_ref,
+               ok_frob ? "OK" : "ERREUR");
+        printf("max       %10.6f s  %.17g (référence %.17g)  %s\n", t_max, max_abs, max_abs_ref,
+               ok_max ? "OK" : "ERREUR");
+
+        if (ok_dot && ok_frob && ok_max) {
+            printf("\nRésultat correct : OK\n");
+        } else {
+            printf("\nErreur : différence entre les résultats supérieure au seuil\n");
+        }
+
+        alloc_free(gA);
+        alloc_free(gb);
+        alloc_free(ga);
+    }
+
+    alloc_free(A);
+    alloc_free(b);
+    alloc_free(a);
+    dist_finalize();
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "alloc.h"
+
+void *alloc_array(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        fprintf(stderr, "alloc_array: taille demandée trop grande (%zu x %zu octets)\n", count, size);
+        exit(EXIT_FAILURE);
+    }
+
+    size_t bytes = count * size;
+    size_t align = bytes >= ALIGN_HUGE ? ALIGN_HUGE : ALIGN_CACHE;
+    void *ptr = NULL;
+
+    if (posix_memalign(&ptr, align, bytes ? bytes : 1) != 0) {
+        fprintf(stderr, "alloc_array: impossible d'allouer %zu octets\n", bytes);
+        exit(EXIT_FAILURE);
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Simple indication : sans grandes pages transparentes, l'appel échoue sans conséquence
+    if (align == ALIGN_HUGE) {
+        madvise(ptr, bytes, alloc_get_huge() == ALLOC_HUGE_OFF ? MADV_NOHUGEPAGE : MADV_HUGEPAGE);
+    }
+#endif
+
+    return ptr;
+}
+
+void alloc_free(void *ptr) {
+    free(ptr);
+}
+
+// ============================= GRANDES PAGES ====================================
+
+static alloc_huge_t huge_mode = ALLOC_HUGE_THP;
+static pthread_once_t huge_once = PTHREAD_ONCE_INIT;
+
+static void huge_init(void) {
+    const char *env = getenv("ALLOC_HUGE");
+    if (env && strcmp(env, "off") == 0) {
+        huge_mode = ALLOC_HUGE_OFF;
+    }
+}
+
+alloc_huge_t alloc_get_huge(void) {
+    pthread_once(&huge_once, huge_init);
+    return huge_mode;
+}
+
+void alloc_set_huge(alloc_huge_t huge) {
+    pthread_once(&huge_once, huge_init);
+    huge_mode = huge;
+}
+
+const char *alloc_huge_name(alloc_huge_t huge) {
+    return huge == ALLOC_HUGE_OFF ? "off" : "thp";
+}
+
+size_t alloc_huge_backed(const void *ptr) {
+    FILE *smaps = fopen("/proc/self/smaps", "r");
+    if (!smaps) {
+        return 0;
+    }
+
+    // Chaque projection commence par "début-fin ..." suivi de ses champs "Nom: valeur kB"
+    uintptr_t addr = (uintptr_t)ptr, start, end;
+    int inside = 0;
+    size_t kb = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), smaps)) {
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2) {
+            if (inside) {
+                break;
+            }
+            inside = addr >= start && addr < end;
+        } else if (inside && sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(smaps);
+
+    return inside ? kb * 1024 : 0;
+}
+
+// ===================== ARÈNE DE TRAVAIL DES APPELS ==============================
+
+/**
+ * Bloc d'une arène : l'en-tête occupe une ligne de cache, les données le suivent.
+ */
+struct arena_block {
+    _Alignas(ALIGN_CACHE) arena_block_t *prev; // Bloc précédent
+    size_t capacity;       // Octets de données
+    size_t used;           // Octets découpés
+};
+
+static unsigned char *block_data(arena_block_t *block) {
+    return (unsigned char *)block + sizeof(arena_block_t);
+}
+
+static arena_block_t *block_new(size_t capacity, arena_block_t *prev) {
+    arena_block_t *block = alloc_array(1, sizeof(arena_block_t) + capacity);
+    block->prev = prev;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+arena_mark_t arena_mark(const arena_t *arena) {
+    // Arène vide : repère sans bloc, que le regroupement des blocs ne peut pas invalider
+    if (arena->in_use == 0) {
+        return (arena_mark_t){ NULL, 0, 0 };
+    }
+    return (arena_mark_t){ arena->head, arena->head->used, arena->in_use };
+}
+
+void *arena_alloc(arena_t *arena, size_t count, size_t size) {
+    if (size != 0 && count > (SIZE_MAX - ALIGN_CACHE) / size) {
+        fprintf(stderr, "arena_alloc: taille demandée trop grande (%zu x %zu octets)\n", count, size);
+        exit(EXIT_FAILURE);
+    }
+
+    size_t bytes = (count * size + ALIGN_CACHE - 1) / ALIGN_CACHE * ALIGN_CACHE;
+    arena_block_t *head = arena->head;
+    if (!head || head->capacity - head->used < bytes) {
+        size_t capacity = head ? 2 * head->capacity : ARENA_BLOCK_MIN;
+        head = arena->head = block_new(capacity > bytes ? capacity : bytes, head);
+    }
+
+    void *ptr = block_data(head) + head->used;
+    head->used += bytes;
+    arena->in_use += bytes;
+    arena->peak = arena->in_use > arena->peak ? arena->in_use : arena->peak;
+    return ptr;
+}
+
+void arena_release(arena_t *arena, arena_mark_t mark) {
+    // Retour à l'arène vide : un seul bloc, assez grand pour le plus gros appel (dans la
+    // limite conservée). Aucun repère pris avant n'y désigne un bloc (voir `arena_mark`)
+    if (mark.in_use == 0) {
+        size_t target = arena->peak < ARENA_KEEP_MAX ? arena->peak : ARENA_KEEP_MAX;
+        target = target > ARENA_BLOCK_MIN ? target : ARENA_BLOCK_MIN;
+        if (!arena->head || arena->head->prev || arena->head->capacity < target ||
+            arena->head->capacity > ARENA_KEEP_MAX) {
+            arena_destroy(arena);
+            arena->head = block_new(target, NULL);
+        }
+        arena->head->used = 0;
+        arena->in_use = 0;
+        return;
+    }
+
+    while (arena->head != mark.block) {
+        arena_block_t *prev = arena->head->prev;
+        alloc_free(arena->head);
+        arena->head = prev;
+    }
+    arena->head->used = mark.used;
+    arena->in_use = mark.in_use;
+}
+
+void arena_destroy(arena_t *arena) {
+    while (arena->head) {
+        arena_block_t *prev = arena->head->prev;
+        alloc_free(arena->head);
+        arena->head = prev;
+    }
+    arena->in_use = 0;
+}
+
+// Arène de chaque thread, libérée à sa sortie par le destructeur de `scratch_key`
+static _Thread_local arena_t scratch = { NULL, 0, 0 };
+static pthread_key_t scratch_key;
+static pthread_once_t scratch_once = PTHREAD_ONCE_INIT;
+
+static void scratch_exit(void *arg) {
+    arena_destroy((arena_t *)arg);
+}
+
+static void scratch_init(void) {
+    pthread_key_create(&scratch_key, scratch_exit);
+}
+
+arena_t *arena_scratch(void) {
+    if (!scratch.head) {
+        pthread_once(&scratch_once, scratch_init);
+        pthread_setspecific(scratch_key, &scratch);
+    }
+    return &scratch;
+}
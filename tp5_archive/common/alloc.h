@@ -0,0 +1,126 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stddef.h>
+
+// ========================= ALLOCATION DES DONNÉES ===============================
+
+// Alignement minimal des tableaux : une ligne de cache
+#define ALIGN_CACHE 64
+// Alignement des grands tableaux : une grande page
+#define ALIGN_HUGE (2 * 1024 * 1024)
+
+/**
+ * Allouer `count` éléments de `size` octets sur le tas (remplace les VLA sur la pile).
+ * Les tableaux sont alignés sur une ligne de cache ; ceux d'au moins 2 Mo sont
+ * alignés sur 2 Mo et marqués `MADV_HUGEPAGE`, pour que le noyau puisse les
+ * servir en grandes pages et les répartir entre nœuds NUMA page par page
+ * (sauf avec ALLOC_HUGE_OFF, voir `alloc_get_huge`).
+ * En cas d'échec (ou de dépassement de capacité), le programme s'arrête avec un message.
+ */
+void *alloc_array(size_t count, size_t size);
+
+/**
+ * Libérer un tableau obtenu par `alloc_array`.
+ */
+void alloc_free(void *ptr);
+
+/**
+ * Grandes pages des tableaux d'au moins ALIGN_HUGE octets :
+ *  - ALLOC_HUGE_THP : alignés sur 2 Mo et marqués `MADV_HUGEPAGE` (grandes pages
+ *    transparentes, moins de défauts de TLB en lecture séquentielle) ;
+ *  - ALLOC_HUGE_OFF : marqués `MADV_NOHUGEPAGE`, servis en petites pages (comparaisons).
+ */
+typedef enum {
+    ALLOC_HUGE_THP,
+    ALLOC_HUGE_OFF
+} alloc_huge_t;
+
+/**
+ * Choix courant. Par défaut ALLOC_HUGE_THP, ou la valeur de la variable
+ * d'environnement `ALLOC_HUGE` (`thp` ou `off`). Ne concerne que les allocations suivantes.
+ */
+alloc_huge_t alloc_get_huge(void);
+
+/**
+ * Forcer le choix des grandes pages.
+ */
+void alloc_set_huge(alloc_huge_t huge);
+
+/**
+ * Nom lisible d'un choix de grandes pages.
+ */
+const char *alloc_huge_name(alloc_huge_t huge);
+
+/**
+ * Octets de la projection contenant `ptr` effectivement servis en grandes pages
+ * (`AnonHugePages` de `/proc/self/smaps`, 0 si le système ne le fournit pas).
+ * Les pages n'existent qu'après la première écriture.
+ */
+size_t alloc_huge_backed(const void *ptr);
+
+// ===================== ARÈNE DE TRAVAIL DES APPELS ==============================
+
+// Taille du premier bloc d'une arène, et capacité qu'elle conserve au plus entre deux appels
+#define ARENA_BLOCK_MIN (64 * 1024)
+#define ARENA_KEEP_MAX (4 * 1024 * 1024)
+
+/**
+ * Arène (allocateur par incrément) : les tableaux sont découpés les uns après les
+ * autres dans des blocs alloués une fois, et libérés tous ensemble en O(1) par retour
+ * à un repère. Sert aux données de travail d'un appel de noyau (descripteurs de tâches,
+ * cases des résultats partiels, sommes partielles) : après le premier appel, l'arène a
+ * la capacité nécessaire et un appel n'alloue plus rien.
+ */
+typedef struct arena_block arena_block_t;
+
+typedef struct {
+    arena_block_t *head;   // Bloc courant (le plus récent)
+    size_t in_use;         // Octets découpés depuis le début de l'arène
+    size_t peak;           // Plus grand `in_use` observé
+} arena_t;
+
+/**
+ * Repère de l'état d'une arène, pour y revenir (sans bloc si l'arène était vide).
+ */
+typedef struct {
+    arena_block_t *block;  // Bloc courant au moment du repère (NULL : arène vide)
+    size_t used;           // Octets découpés dans ce bloc
+    size_t in_use;         // Octets découpés dans toute l'arène
+} arena_mark_t;
+
+/**
+ * Arène de travail du thread courant (une par thread, libérée à la fin du thread).
+ * Plusieurs threads peuvent appeler des noyaux sur le même pool en même temps (thread
+ * asynchrone, contextes partagés) : chacun a son arène, sans verrou.
+ */
+arena_t *arena_scratch(void);
+
+/**
+ * État courant de l'arène. Les repères s'emboîtent : un noyau qui en appelle un autre
+ * prend son propre repère et le rend avant le sien, y compris quand les deux repères
+ * ont été pris sur l'arène vide.
+ */
+arena_mark_t arena_mark(const arena_t *arena);
+
+/**
+ * Découper `count` éléments de `size` octets, alignés sur une ligne de cache
+ * (non initialisés, comme `alloc_array`). Un nouveau bloc n'est alloué que si le bloc
+ * courant est plein. En cas d'échec, le programme s'arrête avec un message.
+ */
+void *arena_alloc(arena_t *arena, size_t count, size_t size);
+
+/**
+ * Libérer d'un coup tout ce qui a été découpé depuis `mark`. Au retour du repère le
+ * plus extérieur (arène vide), les blocs sont remplacés au besoin par un seul bloc de
+ * la plus grande capacité utilisée (au plus ARENA_KEEP_MAX) : les appels suivants de
+ * même taille n'allouent plus rien.
+ */
+void arena_release(arena_t *arena, arena_mark_t mark);
+
+/**
+ * Libérer tous les blocs de l'arène.
+ */
+void arena_destroy(arena_t *arena);
+
+#endif // ALLOC_H
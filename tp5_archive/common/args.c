@@ -0,0 +1,102 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "args.h"
+
+/**
+ * Convertir `text` en taille (avec suffixe optionnel k/m/g).
+ */
+static size_t parse_size(const char *name, const char *text) {
+    char *end;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || errno != 0) {
+        fprintf(stderr, "%s : valeur invalide '%s'\n", name, text);
+        exit(EXIT_FAILURE);
+    }
+
+    switch (*end) {
+    case 'g': case 'G': value <<= 10; // fallthrough
+    case 'm': case 'M': value <<= 10; // fallthrough
+    case 'k': case 'K': value <<= 10; ++end; break;
+    default: break;
+    }
+
+    if (*end != '\0') {
+        fprintf(stderr, "%s : valeur invalide '%s'\n", name, text);
+        exit(EXIT_FAILURE);
+    }
+
+    return (size_t)value;
+}
+
+/**
+ * Valeur brute de l'option `name` (ligne de commande puis environnement), ou NULL.
+ */
+static const char *find_arg(int argc, char **argv, const char *name, const char *env) {
+    size_t len = strlen(name);
+
+    // 1. Ligne de commande
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--", 2) != 0 || strncmp(arg + 2, name, len) != 0) {
+            continue;
+        }
+        if (arg[2 + len] == '=') {
+            return arg + 3 + len;
+        }
+        if (arg[2 + len] == '\0' && i + 1 < argc) {
+            return argv[i + 1];
+        }
+    }
+
+    // 2. Variable d'environnement
+    const char *value = env ? getenv(env) : NULL;
+    if (value && *value) {
+        return value;
+    }
+
+    return NULL;
+}
+
+size_t arg_size(int argc, char **argv, const char *name, const char *env, size_t def) {
+    const char *value = find_arg(argc, argv, name, env);
+
+    // 3. Valeur par défaut
+    return value ? parse_size(name, value) : def;
+}
+
+const char *arg_string(int argc, char **argv, const char *name, const char *env, const char *def) {
+    const char *value = find_arg(argc, argv, name, env);
+    return value ? value : def;
+}
+
+size_t arg_size_list(int argc, char **argv, const char *name, const char *env, const char *def,
+                     size_t *values, size_t max) {
+    const char *list = find_arg(argc, argv, name, env);
+    if (!list) {
+        list = def;
+    }
+
+    size_t count = 0;
+    char item[64];
+    while (*list && count < max) {
+        size_t len = strcspn(list, ",");
+        if (len >= sizeof(item)) {
+            fprintf(stderr, "%s : valeur trop longue\n", name);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(item, list, len);
+        item[len] = '\0';
+        values[count++] = parse_size(name, item);
+        list += len;
+        if (*list == ',') {
+            ++list;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,31 @@
+#ifndef ARGS_H
+#define ARGS_H
+
+#include <stddef.h>
+
+// ===================== PARAMÈTRES EN LIGNE DE COMMANDE ==========================
+
+/**
+ * Lire une taille de problème, par ordre de priorité :
+ *  1. l'option `--<name>=<valeur>` ou `--<name> <valeur>` de la ligne de commande ;
+ *  2. la variable d'environnement `env` (si `env` n'est pas NULL) ;
+ *  3. la valeur par défaut `def`.
+ * Les suffixes `k`, `m` et `g` (puissances de 1024) sont acceptés, par exemple `--n=1g`.
+ * Une valeur invalide arrête le programme avec un message.
+ */
+size_t arg_size(int argc, char **argv, const char *name, const char *env, size_t def);
+
+/**
+ * Lire une option textuelle, avec les mêmes règles de priorité que `arg_size`.
+ */
+const char *arg_string(int argc, char **argv, const char *name, const char *env, const char *def);
+
+/**
+ * Lire une liste de tailles séparées par des virgules (par exemple `--threads=1,2,4`)
+ * dans `values` (au plus `max` valeurs). Si l'option est absente, la liste
+ * `def` (même format) est utilisée. Retourne le nombre de valeurs lues.
+ */
+size_t arg_size_list(int argc, char **argv, const char *name, const char *env, const char *def,
+                     size_t *values, size_t max);
+
+#endif // ARGS_H
@@ -0,0 +1,161 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+
+#include "baseline.h"
+
+// Longueur maximale d'une ligne du fichier CSV
+#define LINE_MAX_LEN 1024
+
+/**
+ * Découper `line` (modifiée) en champs séparés par des virgules. Retourne le nombre de champs.
+ */
+static size_t split_fields(char *line, char *fields[], size_t max) {
+    size_t count = 0;
+    line[strcspn(line, "\r\n")] = '\0';
+    for (char *p = line; count < max; ++p) {
+        fields[count++] = p;
+        p += strcspn(p, ",");
+        if (*p == '\0') {
+            break;
+        }
+        *p = '\0';
+    }
+    return count;
+}
+
+void baseline_machine(char *buf, size_t size, const char *isa) {
+    char model[BASELINE_MACHINE_LEN] = "";
+
+    // Modèle du processeur : `model name` (x86), à défaut `Hardware` ou `cpu model` (Arm, MIPS)
+    FILE *in = fopen("/proc/cpuinfo", "r");
+    char line[LINE_MAX_LEN];
+    while (in && !model[0] && fgets(line, sizeof(line), in)) {
+        if (strncmp(line, "model name", 10) == 0 || strncmp(line, "Hardware", 8) == 0 ||
+            strncmp(line, "cpu model", 9) == 0) {
+            char *p = strchr(line, ':');
+            if (p) {
+                p += 1 + strspn(p + 1, " \t");
+                p[strcspn(p, "\r\n")] = '\0';
+                snprintf(model, sizeof(model), "%s", p);
+            }
+        }
+    }
+    if (in) {
+        fclose(in);
+    }
+    struct utsname host;
+    if (!model[0] && uname(&host) == 0) {
+        snprintf(model, sizeof(model), "%s", host.machine);
+    }
+
+    snprintf(buf, size, "%s / %s", model[0] ? model : "inconnu", isa);
+    for (char *p = buf; (p = strchr(p, ',')) != NULL;) {
+        *p = ' ';
+    }
+}
+
+size_t baseline_load(baseline_t *baseline, const char *path, const char *const keys[], size_t nb_keys,
+                     const char *value) {
+    baseline->rows = NULL;
+    baseline->count = 0;
+    baseline->machine[0] = '\0';
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        perror(path);
+        return 0;
+    }
+
+    // Position de chaque colonne de la clé, puis de la valeur, d'après l'en-tête
+    enum { MAX_FIELDS = 64 };
+    char line[LINE_MAX_LEN], *fields[MAX_FIELDS];
+    int index[BASELINE_MAX_KEYS + 1];
+    size_t nb_cols = nb_keys < BASELINE_MAX_KEYS ? nb_keys : BASELINE_MAX_KEYS;
+    size_t nb_fields = fgets(line, sizeof(line), in) ? split_fields(line, fields, MAX_FIELDS) : 0;
+    for (size_t c = 0; c <= nb_cols; ++c) {
+        const char *name = c < nb_cols ? keys[c] : value;
+        index[c] = -1;
+        for (size_t f = 0; f < nb_fields; ++f) {
+            if (strcmp(fields[f], name) == 0) {
+                index[c] = (int)f;
+            }
+        }
+        if (index[c] < 0) {
+            fprintf(stderr, "%s : colonne '%s' absente\n", path, name);
+            fclose(in);
+            return 0;
+        }
+    }
+    int machine = -1;  // Colonne facultative de la machine de mesure
+    for (size_t f = 0; f < nb_fields; ++f) {
+        if (strcmp(fields[f], "machine") == 0) {
+            machine = (int)f;
+        }
+    }
+
+    size_t capacity = 0;
+    while (fgets(line, sizeof(line), in)) {
+        nb_fields = split_fields(line, fields, MAX_FIELDS);
+        baseline_entry_t row = { "", 0.0 };
+        bool complete = true;
+        for (size_t c = 0; c <= nb_cols && complete; ++c) {
+            if ((size_t)index[c] >= nb_fields) {
+                complete = false;
+            } else if (c < nb_cols) {
+                if (c) {
+                    strncat(row.key, ",", sizeof(row.key) - strlen(row.key) - 1);
+                }
+                strncat(row.key, fields[index[c]], sizeof(row.key) - strlen(row.key) - 1);
+            } else {
+                row.value = strtod(fields[index[c]], NULL);
+            }
+        }
+        if (!complete) {
+            continue;  // Ligne incomplète (fichier tronqué) : ignorée
+        }
+        if (machine >= 0 && (size_t)machine < nb_fields && !baseline->machine[0]) {
+            snprintf(baseline->machine, sizeof(baseline->machine), "%s", fields[machine]);
+        }
+        if (baseline->count == capacity) {
+            capacity = capacity ? 2 * capacity : 64;
+            baseline_entry_t *grown = realloc(baseline->rows, capacity * sizeof(baseline_entry_t));
+            if (!grown) {
+                break;
+            }
+            baseline->rows = grown;
+        }
+        baseline->rows[baseline->count++] = row;
+    }
+    fclose(in);
+
+    return baseline->count;
+}
+
+const double *baseline_find(const baseline_t *baseline, const char *key) {
+    for (size_t i = 0; i < baseline->count; ++i) {
+        if (strcmp(baseline->rows[i].key, key) == 0) {
+            return &baseline->rows[i].value;
+        }
+    }
+    return NULL;
+}
+
+bool baseline_check(const baseline_t *baseline, const char *key, double value, double max_drop) {
+    const double *ref = baseline_find(baseline, key);
+    if (!ref || value >= *ref * (1. - max_drop / 100.)) {
+        return true;
+    }
+    fprintf(stderr, "régression %s : %.3f Go/s, référence %.3f Go/s (baisse de %.1f %%, max %g %%)\n", key, value,
+            *ref, 100. * (1. - value / *ref), max_drop);
+    return false;
+}
+
+void baseline_free(baseline_t *baseline) {
+    free(baseline->rows);
+    baseline->rows = NULL;
+    baseline->count = 0;
+    baseline->machine[0] = '\0';
+}
@@ -0,0 +1,66 @@
+#ifndef BASELINE_H
+#define BASELINE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ===================== MESURES DE RÉFÉRENCE (NON-RÉGRESSION) ====================
+
+/**
+ * Mesures de référence lues dans un fichier CSV écrit par `bench_dotprod --format=csv` :
+ * chaque ligne est repérée par une clé, faite des valeurs de colonnes
+ * choisies jointes par des virgules (par exemple `blocks,1048576,4,0,0,tree`), et
+ * porte la valeur d'une colonne (le débit). Les colonnes sont repérées par l'en-tête,
+ * dans n'importe quel ordre. La colonne `machine`, si elle existe, donne la machine de
+ * mesure (voir `baseline_machine`) : des débits mesurés ailleurs ne sont pas comparables.
+ */
+typedef struct {
+    char key[128];         // Valeurs des colonnes de la clé, jointes par des virgules
+    double value;          // Valeur de référence
+} baseline_entry_t;
+
+// Longueur maximale de la signature d'une machine
+#define BASELINE_MACHINE_LEN 128
+
+typedef struct {
+    baseline_entry_t *rows;  // Mesures lues
+    size_t count;            // Nombre de mesures
+    char machine[BASELINE_MACHINE_LEN]; // Machine de mesure (colonne `machine`, vide si absente)
+} baseline_t;
+
+// Colonnes au plus dans une clé
+#define BASELINE_MAX_KEYS 8
+
+/**
+ * Signature de la machine courante, écrite dans `buf` : modèle du processeur (lu dans
+ * `/proc/cpuinfo`, à défaut l'architecture) et noyau vectoriel `isa`, sans virgule
+ * pour tenir dans une colonne CSV.
+ */
+void baseline_machine(char *buf, size_t size, const char *isa);
+
+/**
+ * Lire le fichier `path` : clé formée des `nb_keys` colonnes `keys`, valeur de la
+ * colonne `value`. Retourne le nombre de mesures lues (0 si le fichier est illisible
+ * ou si une colonne manque, avec un message).
+ */
+size_t baseline_load(baseline_t *baseline, const char *path, const char *const keys[], size_t nb_keys,
+                     const char *value);
+
+/**
+ * Valeur de référence de la clé `key` (NULL si la clé est absente).
+ */
+const double *baseline_find(const baseline_t *baseline, const char *key);
+
+/**
+ * Comparer le débit mesuré `value` à celui de référence de la clé `key` : faux (avec
+ * un message) s'il baisse de plus de `max_drop` pour cent. Une clé absente de la
+ * référence (nouvelle mesure) n'est pas une régression.
+ */
+bool baseline_check(const baseline_t *baseline, const char *key, double value, double max_drop);
+
+/**
+ * Libérer les mesures lues.
+ */
+void baseline_free(baseline_t *baseline);
+
+#endif // BASELINE_H
@@ -0,0 +1,185 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "cutover.h"
+#include "thread_pool.h"
+#include "timer.h"
+
+// ============================ SEUILS COURANTS ===================================
+
+// Seuils par défaut, en l'absence de profil : le réveil du pool coûte quelques
+// microsecondes, rentabilisées à partir de quelques dizaines de milliers d'éléments
+static cutover_t thresholds[CUTOVER_NB_KERNELS] = {
+    [CUTOVER_DOT]       = { 16, 32768 },
+    [CUTOVER_FROBENIUS] = { 16, 32768 },
+    [CUTOVER_MAX]       = { 16, 32768 },
+};
+static exec_path_t forced = EXEC_AUTO;
+static pthread_once_t profile_once = PTHREAD_ONCE_INIT;
+
+const char *cutover_kernel_name(cutover_kernel_t kernel) {
+    switch (kernel) {
+    case CUTOVER_DOT:       return "dot";
+    case CUTOVER_FROBENIUS: return "frobenius";
+    case CUTOVER_MAX:       return "max";
+    case CUTOVER_NB_KERNELS: break;
+    }
+    return "?";
+}
+
+const char *exec_path_name(exec_path_t path) {
+    switch (path) {
+    case EXEC_AUTO:   return "auto";
+    case EXEC_SERIAL: return "serial";
+    case EXEC_SIMD:   return "simd";
+    case EXEC_POOL:   return "pool";
+    }
+    return "?";
+}
+
+const char *cutover_profile_path(void) {
+    const char *env = getenv("CUTOVER_PROFILE");
+    return env && *env ? env : CUTOVER_PROFILE_DEFAULT;
+}
+
+/**
+ * Lire la version imposée (`CUTOVER_PATH`), puis le profil s'il existe. Les lignes
+ * vides, les commentaires (`#`) et les noyaux inconnus sont ignorés ; `pool_min`
+ * vaut `never` pour un pool jamais rentable.
+ */
+static void profile_init(void) {
+    const char *env = getenv("CUTOVER_PATH");
+    for (exec_path_t p = EXEC_SERIAL; env && p <= EXEC_POOL; ++p) {
+        if (strcmp(env, exec_path_name(p)) == 0) {
+            forced = p;
+        }
+    }
+
+    FILE *file = fopen(cutover_profile_path(), "r");
+    if (!file) {
+        return;
+    }
+    char line[128], name[32], pool[32];
+    size_t simd_min;
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || sscanf(line, "%31s %zu %31s", name, &simd_min, pool) != 3) {
+            continue;
+        }
+        for (cutover_kernel_t k = 0; k < CUTOVER_NB_KERNELS; ++k) {
+            if (strcmp(name, cutover_kernel_name(k)) == 0) {
+                thresholds[k].simd_min = simd_min;
+                thresholds[k].pool_min = strcmp(pool, "never") == 0 ? SIZE_MAX : strtoull(pool, NULL, 10);
+            }
+        }
+    }
+    fclose(file);
+}
+
+exec_path_t cutover_path(cutover_kernel_t kernel, size_t n) {
+    pthread_once(&profile_once, profile_init);
+    exec_path_t path = forced;
+    if (path == EXEC_AUTO) {
+        const cutover_t *t = &thresholds[kernel];
+        path = n >= t->pool_min ? EXEC_POOL : n >= t->simd_min ? EXEC_SIMD : EXEC_SERIAL;
+    }
+    if (path == EXEC_POOL && pool_size(pool_current()) == 1) {
+        path = EXEC_SIMD;
+    }
+    return path;
+}
+
+cutover_t cutover_get(cutover_kernel_t kernel) {
+    pthread_once(&profile_once, profile_init);
+    return thresholds[kernel];
+}
+
+void cutover_set(cutover_kernel_t kernel, cutover_t t) {
+    pthread_once(&profile_once, profile_init);
+    thresholds[kernel] = t;
+}
+
+void cutover_force(exec_path_t path) {
+    pthread_once(&profile_once, profile_init);
+    forced = path;
+}
+
+int cutover_save(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return -1;
+    }
+    fprintf(file, "# Seuils de bascule (éléments) : noyau, version SIMD dès, pool dès (%zu threads)\n",
+            pool_size(pool_current()));
+    for (cutover_kernel_t k = 0; k < CUTOVER_NB_KERNELS; ++k) {
+        cutover_t t = cutover_get(k);
+        if (t.pool_min == SIZE_MAX) {
+            fprintf(file, "%s %zu never\n", cutover_kernel_name(k), t.simd_min);
+        } else {
+            fprintf(file, "%s %zu %zu\n", cutover_kernel_name(k), t.simd_min, t.pool_min);
+        }
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+// ================================ ÉTALONNAGE ====================================
+
+// Bornes de l'étalonnage : première taille mesurée, éléments lus par mesure
+#define CALIBRATE_N_MIN 16
+#define CALIBRATE_WORK (1u << 20)
+#define CALIBRATE_REPS 5
+#define CALIBRATE_MAX_SIZES 48
+
+/**
+ * Meilleur temps par appel de la version imposée `path` sur `n` éléments : chaque
+ * mesure enchaîne assez d'appels pour lire environ CALIBRATE_WORK éléments.
+ */
+static double time_path(exec_path_t path, cutover_run_fn run, void *arg, size_t n) {
+    size_t calls = CALIBRATE_WORK / n ? CALIBRATE_WORK / n : 1;
+    double best = INFINITY;
+    cutover_force(path);
+    run(n, arg);  // Mise en cache et réveil des threads
+    for (size_t r = 0; r < CALIBRATE_REPS; ++r) {
+        double t0 = timer_now();
+        for (size_t c = 0; c < calls; ++c) {
+            run(n, arg);
+        }
+        double t = (timer_now() - t0) / calls;
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+/**
+ * Plus petite taille à partir de laquelle `faster[i] <= slower[i]` pour toutes les
+ * tailles suivantes (SIZE_MAX si la dernière taille ne la vérifie pas).
+ */
+static size_t first_win(size_t count, const size_t *sizes, const double *faster, const double *slower) {
+    size_t from = SIZE_MAX;
+    for (size_t i = count; i-- > 0 && faster[i] <= slower[i]; ) {
+        from = sizes[i];
+    }
+    return from;
+}
+
+cutover_t cutover_calibrate(cutover_run_fn run, void *arg, size_t n_max) {
+    size_t sizes[CALIBRATE_MAX_SIZES], count = 0;
+    double t_serial[CALIBRATE_MAX_SIZES], t_simd[CALIBRATE_MAX_SIZES], t_pool[CALIBRATE_MAX_SIZES];
+    exec_path_t previous = forced;
+
+    for (size_t n = CALIBRATE_N_MIN; n <= n_max && count < CALIBRATE_MAX_SIZES; n *= 2, ++count) {
+        sizes[count] = n;
+        t_serial[count] = time_path(EXEC_SERIAL, run, arg, n);
+        t_simd[count] = time_path(EXEC_SIMD, run, arg, n);
+        t_pool[count] = pool_size(pool_current()) > 1 ? time_path(EXEC_POOL, run, arg, n) : INFINITY;
+    }
+    cutover_force(previous);
+
+    cutover_t t = { first_win(count, sizes, t_simd, t_serial), first_win(count, sizes, t_pool, t_simd) };
+    t.simd_min = t.simd_min == SIZE_MAX ? n_max : t.simd_min;
+    return t;
+}
@@ -0,0 +1,94 @@
+#ifndef CUTOVER_H
+#define CUTOVER_H
+
+#include <stddef.h>
+
+// ================= CHOIX ENTRE VERSIONS SÉQUENTIELLE, SIMD ET PARALLÈLE =========
+
+/**
+ * Manière d'exécuter un noyau :
+ *  - EXEC_SERIAL : boucle de référence séquentielle (`dotprod_ref`, ...) ;
+ *  - EXEC_SIMD   : noyau vectoriel sur le seul thread appelant (`simd_dot`, ...) ;
+ *  - EXEC_POOL   : découpage en blocs ou en tuiles répartis sur le pool de threads.
+ * EXEC_AUTO (choix selon la taille) n'est jamais retourné par `cutover_path`.
+ */
+typedef enum {
+    EXEC_AUTO,
+    EXEC_SERIAL,
+    EXEC_SIMD,
+    EXEC_POOL
+} exec_path_t;
+
+/**
+ * Noyaux dont la version est choisie selon la taille du problème.
+ */
+typedef enum {
+    CUTOVER_DOT,           // Produit scalaire (`dotprod_blocks`, `dotprod_pairs`)
+    CUTOVER_FROBENIUS,     // Norme de Frobenius (`frobenius_view`)
+    CUTOVER_MAX,           // Norme max (`max_view`)
+    CUTOVER_NB_KERNELS
+} cutover_kernel_t;
+
+/**
+ * Seuils de bascule d'un noyau, en nombre d'éléments lus : la version SIMD à partir de
+ * `simd_min`, le pool à partir de `pool_min` (SIZE_MAX : jamais).
+ */
+typedef struct {
+    size_t simd_min;
+    size_t pool_min;
+} cutover_t;
+
+// Fichier de profil par défaut (modifiable par `CUTOVER_PROFILE`)
+#define CUTOVER_PROFILE_DEFAULT "cutover.profile"
+
+/**
+ * Version à utiliser pour `n` éléments : selon les seuils du noyau, ou la version
+ * imposée par `cutover_force` ou la variable `CUTOVER_PATH` (`serial`, `simd`, `pool`).
+ * Le pool n'est retenu que s'il a plus d'un thread. Au premier appel, les seuils par
+ * défaut sont remplacés par ceux du profil `CUTOVER_PROFILE` s'il existe (voir
+ * `lib/cutover_tune`, qui les mesure sur la machine).
+ */
+exec_path_t cutover_path(cutover_kernel_t kernel, size_t n);
+
+/**
+ * Lire ou modifier les seuils d'un noyau.
+ */
+cutover_t cutover_get(cutover_kernel_t kernel);
+void cutover_set(cutover_kernel_t kernel, cutover_t thresholds);
+
+/**
+ * Imposer une version à tous les noyaux (EXEC_AUTO : revenir au choix par taille).
+ * Réservé aux programmes de mesure : aucun calcul ne doit être en cours.
+ */
+void cutover_force(exec_path_t path);
+
+/**
+ * Chemin du fichier de profil : `CUTOVER_PROFILE`, ou CUTOVER_PROFILE_DEFAULT.
+ */
+const char *cutover_profile_path(void);
+
+/**
+ * Écrire les seuils de tous les noyaux dans le fichier `path` (une ligne par noyau :
+ * nom, `simd_min`, `pool_min`). Retourne 0, ou -1 si le fichier ne peut être écrit.
+ */
+int cutover_save(const char *path);
+
+/**
+ * Une exécution du noyau mesuré sur `n` éléments (de la version imposée).
+ */
+typedef void (*cutover_run_fn)(size_t n, void *arg);
+
+/**
+ * Mesurer les trois versions d'un noyau pour n = 16, 32, ... jusqu'à `n_max`, et en
+ * déduire ses seuils : chaque version est retenue à partir de la plus petite taille
+ * au-delà de laquelle elle est toujours au moins aussi rapide que la précédente.
+ */
+cutover_t cutover_calibrate(cutover_run_fn run, void *arg, size_t n_max);
+
+/**
+ * Noms lisibles (pour l'affichage et le fichier de profil).
+ */
+const char *cutover_kernel_name(cutover_kernel_t kernel);
+const char *exec_path_name(exec_path_t path);
+
+#endif // CUTOVER_H
@@ -0,0 +1,89 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "matrix.h"
+#include "gpu.h"
+
+// ============================== MODÈLE DE COÛT ==================================
+
+typedef enum {
+    OFFLOAD_AUTO,
+    OFFLOAD_ALWAYS,
+    OFFLOAD_NEVER
+} offload_mode_t;
+
+static offload_mode_t mode = OFFLOAD_AUTO;
+static double link_gbs = GPU_LINK_GBS;
+static double cpu_gbs = GPU_CPU_GBS;
+static pthread_once_t model_once = PTHREAD_ONCE_INIT;
+
+static double env_double(const char *name, double def) {
+    const char *env = getenv(name);
+    double value = env ? strtod(env, NULL) : 0.0;
+    return value > 0.0 ? value : def;
+}
+
+static void model_init(void) {
+    const char *env = getenv("GPU_OFFLOAD");
+    if (env && strcmp(env, "always") == 0) {
+        mode = OFFLOAD_ALWAYS;
+    } else if (env && strcmp(env, "never") == 0) {
+        mode = OFFLOAD_NEVER;
+    }
+    link_gbs = env_double("GPU_LINK_GBS", GPU_LINK_GBS);
+    cpu_gbs = env_double("GPU_CPU_GBS", GPU_CPU_GBS);
+}
+
+/**
+ * Le GPU est-il plus rapide que le pool courant pour lire `bytes` octets résidant à
+ * l'emplacement `kind` ? La mémoire ordinaire traverse le bus deux fois plus lentement
+ * (copie par un tampon verrouillé du pilote).
+ */
+static bool offload_worth(size_t bytes, gpu_mem_t kind, bool sum) {
+    if (kind == GPU_MEM_DEVICE) {
+        return true;
+    }
+    pthread_once(&model_once, model_init);
+    if (mode == OFFLOAD_NEVER || (sum && sum_get_mode() == SUM_COMPENSATED) || gpu_device_count() == 0) {
+        return false;
+    }
+    if (mode == OFFLOAD_ALWAYS) {
+        return true;
+    }
+
+    double cpu = fmin(pool_size(pool_current()) * cpu_gbs, GPU_DRAM_GBS) * 1e9;
+    double link = (kind == GPU_MEM_PINNED ? link_gbs : link_gbs / 2) * 1e9;
+    return GPU_LAUNCH_S + bytes / link < bytes / cpu;
+}
+
+/**
+ * Emplacement le plus contraignant de deux tableaux.
+ */
+static gpu_mem_t kind_max(gpu_mem_t a, gpu_mem_t b) {
+    return a > b ? a : b;
+}
+
+bool gpu_offload_dot(size_t n, const double *a, const double *b) {
+    gpu_mem_t kind = kind_max(gpu_memory_kind(a), gpu_memory_kind(b));
+    return offload_worth(2 * n * sizeof(double), kind, true);
+}
+
+bool gpu_offload_view(matrix_view_t A, bool sum) {
+    if (A.m == 0 || A.n == 0) {
+        return false;
+    }
+    gpu_mem_t kind = gpu_memory_kind(A.base);
+
+    // Mémoire ordinaire : seule une vue contiguë est copiée d'un bloc
+    bool contiguous = A.col_stride == 1 && (A.m == 1 || A.row_stride == (ptrdiff_t)A.n);
+    if (kind == GPU_MEM_HOST && !contiguous) {
+        return false;
+    }
+    return offload_worth(A.m * A.n * sizeof(double), kind, sum);
+}
@@ -0,0 +1,121 @@
+#ifndef GPU_H
+#define GPU_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ======================= DÉPORT SUR GPU (CUDA OU HIP) ===========================
+
+/**
+ * Déport optionnel de `dotprod_blocks` (découpage automatique, ou tout `k` pour des
+ * tableaux résidant sur le GPU), `frobenius_view` et `max_view` sur un GPU, activé par la
+ * compilation avec `USE_GPU` (`make GPU=cuda` ou `make GPU=hip`) ; sans elle, les
+ * fonctions de déport sont vides et le pool de threads calcule seul. Sur le GPU, chaque
+ * bloc réduit sa part par échanges entre les voies d'un warp (`__shfl_down_sync`), puis
+ * un second passage réduit les résultats des blocs : l'ordre des additions est fixe, le
+ * résultat ne dépend que du GPU.
+ *
+ * Les données peuvent résider sur le GPU (ou en mémoire gérée), toujours réduites sur le
+ * GPU car les threads de l'hôte ne peuvent pas les lire, ou sur l'hôte : la mémoire
+ * verrouillée (`cudaMallocHost`, `cudaHostRegister`) est lue directement à travers le
+ * bus, la mémoire ordinaire d'abord copiée sur le GPU. Une réduction ne lisant chaque
+ * élément qu'une fois, le transfert n'est rentable que s'il est plus rapide que la mémoire
+ * vue par le pool : le temps estimé (lancement plus transfert, débit `GPU_LINK_GBS`) est
+ * comparé à celui du pool (débit `GPU_CPU_GBS` par thread, borné par GPU_DRAM_GBS).
+ * `GPU_OFFLOAD` (`auto`, `always`, `never`) impose le choix pour les données de l'hôte.
+ * En sommation compensée, seules les données résidant sur le GPU y sont réduites.
+ */
+
+/**
+ * Emplacement d'un tableau, vu du GPU.
+ */
+typedef enum {
+    GPU_MEM_HOST,      // Mémoire ordinaire de l'hôte : copie avant la réduction
+    GPU_MEM_PINNED,    // Mémoire verrouillée de l'hôte : lue directement par le GPU
+    GPU_MEM_DEVICE     // Mémoire du GPU ou gérée : réduction sur le GPU obligatoire
+} gpu_mem_t;
+
+// Estimations du modèle de coût (débits en Go/s, modifiables par l'environnement)
+#define GPU_LAUNCH_S 10e-6     // Lancement des deux passages et lecture du résultat
+#define GPU_LINK_GBS 12.0      // Débit du bus hôte-GPU (mémoire verrouillée)
+#define GPU_CPU_GBS 8.0        // Débit mémoire d'un thread du pool
+#define GPU_DRAM_GBS 40.0      // Débit mémoire de l'hôte, tous threads confondus
+
+#ifdef USE_GPU
+
+/**
+ * Nombre de GPU visibles (0 si aucun, ou si le pilote est absent).
+ */
+int gpu_device_count(void);
+
+/**
+ * Emplacement du tableau `ptr`.
+ */
+gpu_mem_t gpu_memory_kind(const void *ptr);
+
+/**
+ * Faut-il réduire sur le GPU le produit scalaire de `a` et `b` (n éléments), ou la vue
+ * `A` (`sum` : somme des carrés, sinon maximum) ? Vrai pour des données résidant sur le
+ * GPU, sinon selon le modèle de coût. Définies dans `gpu.c`.
+ */
+bool gpu_offload_dot(size_t n, const double *a, const double *b);
+bool gpu_offload_view(matrix_view_t A, bool sum);
+
+/**
+ * Réductions sur le GPU : produit scalaire, somme des carrés et maximum absolu d'une vue
+ * quelconque. Définies dans `gpu_kernels.cu`.
+ */
+double gpu_dot(size_t n, const double *a, const double *b);
+double gpu_sum_sq(matrix_view_t A);
+double gpu_absmax(matrix_view_t A);
+
+#else
+
+static inline gpu_mem_t gpu_memory_kind(const void *ptr) {
+    (void)ptr;
+    return GPU_MEM_HOST;
+}
+
+static inline bool gpu_offload_dot(size_t n, const double *a, const double *b) {
+    (void)n;
+    (void)a;
+    (void)b;
+    return false;
+}
+
+static inline bool gpu_offload_view(matrix_view_t A, bool sum) {
+    (void)A;
+    (void)sum;
+    return false;
+}
+
+static inline double gpu_dot(size_t n, const double *a, const double *b) {
+    (void)n;
+    (void)a;
+    (void)b;
+    return 0.0;
+}
+
+static inline double gpu_sum_sq(matrix_view_t A) {
+    (void)A;
+    return 0.0;
+}
+
+static inline double gpu_absmax(matrix_view_t A) {
+    (void)A;
+    return 0.0;
+}
+
+#endif // USE_GPU
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPU_H
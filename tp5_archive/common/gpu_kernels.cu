@@ -0,0 +1,238 @@
+#include <stddef.h>
+#include <pthread.h>
+
+#ifdef __HIPCC__
+#include <hip/hip_runtime.h>
+// Mêmes appels sous HIP (les warps d'AMD ont 64 voies : `warpSize` n'est jamais supposé)
+#define cudaError_t hipError_t
+#define cudaSuccess hipSuccess
+#define cudaGetDeviceCount hipGetDeviceCount
+#define cudaGetLastError hipGetLastError
+#define cudaMalloc hipMalloc
+#define cudaFree hipFree
+#define cudaMemcpy hipMemcpy
+#define cudaMemcpyHostToDevice hipMemcpyHostToDevice
+#define cudaMemcpyDeviceToHost hipMemcpyDeviceToHost
+#define cudaPointerAttributes hipPointerAttribute_t
+#define cudaPointerGetAttributes hipPointerGetAttributes
+#define cudaHostGetDevicePointer hipHostGetDevicePointer
+#define cudaMemoryTypeDevice hipMemoryTypeDevice
+#define cudaMemoryTypeManaged hipMemoryTypeManaged
+#define cudaMemoryTypeHost hipMemoryTypeHost
+#define __shfl_down_sync(mask, value, offset) __shfl_down((value), (offset))
+#else
+#include <cuda_runtime.h>
+#endif
+
+#include "gpu.h"
+
+// ========================== PARAMÈTRES DES NOYAUX ===============================
+
+#define GPU_BLOCK 256        // Threads par bloc (multiple de la taille d'un warp)
+#define GPU_GRID 1024        // Nombre maximal de blocs (résultats partiels du premier passage)
+#define GPU_WARPS_MAX (GPU_BLOCK / 32)
+
+// Réduction effectuée (le second passage somme ou prend le maximum des résultats partiels)
+enum {
+    OP_DOT,      // Somme des a[i] * b[i]
+    OP_SUM_SQ,   // Somme des a[i]²
+    OP_SUM,      // Somme des a[i]
+    OP_ABSMAX    // Maximum des |a[i]|
+};
+
+/**
+ * Éléments lus par les noyaux : `rows` x `cols` à `base[r * row_stride + c * col_stride]`
+ * (une ligne contiguë pour un vecteur).
+ */
+typedef struct {
+    const double *a;
+    const double *b;
+    size_t rows;
+    size_t cols;
+    ptrdiff_t row_stride;
+    ptrdiff_t col_stride;
+} gpu_operand_t;
+
+// ========================== NOYAUX DE RÉDUCTION =================================
+
+static __device__ double combine(int op, double acc, double x) {
+    return op == OP_ABSMAX ? fmax(acc, x) : acc + x;
+}
+
+/**
+ * Réduction entre les voies d'un warp : à chaque étape, chaque voie combine sa valeur
+ * avec celle de la voie située `offset` plus loin, sans passer par la mémoire partagée.
+ */
+static __device__ double warp_reduce(int op, double value) {
+    for (int offset = warpSize / 2; offset > 0; offset /= 2) {
+        value = combine(op, value, __shfl_down_sync(0xffffffffu, value, offset));
+    }
+    return value;
+}
+
+/**
+ * Réduction d'un bloc : chaque warp réduit ses voies, puis le premier warp réduit les
+ * résultats des warps. La valeur neutre vaut 0 pour la somme comme pour le maximum absolu.
+ */
+static __device__ double block_reduce(int op, double value) {
+    __shared__ double warp_values[GPU_WARPS_MAX];
+    int lane = threadIdx.x % warpSize, warp = threadIdx.x / warpSize;
+    int nb_warps = (blockDim.x + warpSize - 1) / warpSize;
+
+    value = warp_reduce(op, value);
+    if (lane == 0) {
+        warp_values[warp] = value;
+    }
+    __syncthreads();
+    value = threadIdx.x < nb_warps ? warp_values[threadIdx.x] : 0.0;
+    return warp == 0 ? warp_reduce(op, value) : value;
+}
+
+/**
+ * Premier passage : chaque thread accumule les éléments de rang `i`, `i + total`, ...
+ * (accès consécutifs par les voies d'un warp), puis chaque bloc écrit son résultat.
+ */
+static __global__ void reduce_kernel(int op, gpu_operand_t x, double *partials) {
+    size_t count = x.rows * x.cols;
+    bool contiguous = x.col_stride == 1 && (x.rows == 1 || x.row_stride == (ptrdiff_t)x.cols);
+    double acc = 0.0;
+
+    for (size_t i = blockIdx.x * (size_t)blockDim.x + threadIdx.x; i < count; i += (size_t)gridDim.x * blockDim.x) {
+        ptrdiff_t at = contiguous ? (ptrdiff_t)i
+                                  : (ptrdiff_t)(i / x.cols) * x.row_stride + (ptrdiff_t)(i % x.cols) * x.col_stride;
+        double v = x.a[at];
+        switch (op) {
+        case OP_DOT:    acc += v * x.b[at]; break;
+        case OP_SUM_SQ: acc += v * v; break;
+        case OP_SUM:    acc += v; break;
+        default:        acc = fmax(acc, fabs(v)); break;
+        }
+    }
+
+    acc = block_reduce(op, acc);
+    if (threadIdx.x == 0) {
+        partials[blockIdx.x] = acc;
+    }
+}
+
+// ========================= MÉMOIRE ET LANCEMENTS ================================
+
+// Tampons du GPU : résultats partiels, copies des tableaux de l'hôte (agrandies au besoin)
+static pthread_mutex_t gpu_lock = PTHREAD_MUTEX_INITIALIZER;
+static double *partials = NULL;
+static double *staging[2] = { NULL, NULL };
+static size_t staging_len[2] = { 0, 0 };
+
+static int device_count = 0;
+static pthread_once_t count_once = PTHREAD_ONCE_INIT;
+
+static void count_init(void) {
+    int n = 0;
+    device_count = cudaGetDeviceCount(&n) == cudaSuccess ? n : 0;
+    cudaGetLastError();  // Pas de pilote : l'erreur est oubliée, le pool calcule seul
+}
+
+extern "C" int gpu_device_count(void) {
+    pthread_once(&count_once, count_init);
+    return device_count;
+}
+
+extern "C" gpu_mem_t gpu_memory_kind(const void *ptr) {
+    if (!ptr || gpu_device_count() == 0) {
+        return GPU_MEM_HOST;
+    }
+    cudaPointerAttributes attr;
+    if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+        cudaGetLastError();  // Mémoire inconnue du pilote (anciennes versions) : hôte ordinaire
+        return GPU_MEM_HOST;
+    }
+    switch (attr.type) {
+    case cudaMemoryTypeDevice:
+    case cudaMemoryTypeManaged: return GPU_MEM_DEVICE;
+    case cudaMemoryTypeHost:    return GPU_MEM_PINNED;
+    default:                    return GPU_MEM_HOST;
+    }
+}
+
+/**
+ * Adresse lisible par le GPU des `len` éléments de `ptr` : la même pour la mémoire du
+ * GPU, l'adresse projetée pour la mémoire verrouillée, une copie dans le tampon `slot`
+ * pour la mémoire ordinaire. Appelée sous `gpu_lock`.
+ */
+static const double *device_view(const double *ptr, size_t len, int slot) {
+    switch (gpu_memory_kind(ptr)) {
+    case GPU_MEM_DEVICE:
+        return ptr;
+    case GPU_MEM_PINNED: {
+        void *mapped = NULL;
+        cudaHostGetDevicePointer(&mapped, (void *)ptr, 0);
+        return (const double *)mapped;
+    }
+    default:
+        break;
+    }
+    if (staging_len[slot] < len) {
+        cudaFree(staging[slot]);
+        cudaMalloc((void **)&staging[slot], len * sizeof(double));
+        staging_len[slot] = len;
+    }
+    cudaMemcpy(staging[slot], ptr, len * sizeof(double), cudaMemcpyHostToDevice);
+    return staging[slot];
+}
+
+/**
+ * Les deux passages : `blocks` résultats partiels, puis un seul bloc qui les réduit.
+ */
+static double reduce_launch(int op, gpu_operand_t x) {
+    size_t count = x.rows * x.cols;
+    size_t blocks = (count + GPU_BLOCK - 1) / GPU_BLOCK;
+    blocks = blocks < GPU_GRID ? blocks : GPU_GRID;
+    if (!partials) {
+        cudaMalloc((void **)&partials, (GPU_GRID + 1) * sizeof(double));
+    }
+
+    reduce_kernel<<<(unsigned)blocks, GPU_BLOCK>>>(op, x, partials);
+    gpu_operand_t second = { partials, NULL, 1, blocks, (ptrdiff_t)blocks, 1 };
+    reduce_kernel<<<1, GPU_BLOCK>>>(op == OP_ABSMAX ? OP_ABSMAX : OP_SUM, second, partials + GPU_GRID);
+
+    double res = 0.0;
+    cudaMemcpy(&res, partials + GPU_GRID, sizeof(double), cudaMemcpyDeviceToHost);
+    return res;
+}
+
+/**
+ * Étendue en éléments d'une vue (du premier au dernier élément, pas positifs).
+ */
+static size_t view_span(matrix_view_t A) {
+    return (A.m - 1) * (size_t)A.row_stride + (A.n - 1) * (size_t)A.col_stride + 1;
+}
+
+static double reduce_view(int op, matrix_view_t A) {
+    if (A.m == 0 || A.n == 0) {
+        return 0.0;
+    }
+    pthread_mutex_lock(&gpu_lock);
+    gpu_operand_t x = { device_view(A.base, view_span(A), 0), NULL, A.m, A.n, A.row_stride, A.col_stride };
+    double res = reduce_launch(op, x);
+    pthread_mutex_unlock(&gpu_lock);
+    return res;
+}
+
+extern "C" double gpu_dot(size_t n, const double *a, const double *b) {
+    if (n == 0) {
+        return 0.0;
+    }
+    pthread_mutex_lock(&gpu_lock);
+    gpu_operand_t x = { device_view(a, n, 0), device_view(b, n, 1), 1, n, (ptrdiff_t)n, 1 };
+    double res = reduce_launch(OP_DOT, x);
+    pthread_mutex_unlock(&gpu_lock);
+    return res;
+}
+
+extern "C" double gpu_sum_sq(matrix_view_t A) {
+    return reduce_view(OP_SUM_SQ, A);
+}
+
+extern "C" double gpu_absmax(matrix_view_t A) {
+    return reduce_view(OP_ABSMAX, A);
+}
@@ -0,0 +1,258 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mapfile.h"
+#include "thread_pool.h"
+#include "partition.h"
+#include "alloc.h"
+
+// ============================ MODE COURANT ======================================
+
+static mapfile_mode_t current_mode = MAPFILE_TOUCH;
+static pthread_once_t mode_once = PTHREAD_ONCE_INIT;
+
+static void mode_init(void) {
+    const char *env = getenv("MAP_MODE");
+    if (!env) {
+        return;
+    }
+    if (strcmp(env, "lazy") == 0) {
+        current_mode = MAPFILE_LAZY;
+    } else if (strcmp(env, "populate") == 0) {
+        current_mode = MAPFILE_POPULATE;
+    } else if (strcmp(env, "touch") == 0) {
+        current_mode = MAPFILE_TOUCH;
+    }
+}
+
+mapfile_mode_t mapfile_get_mode(void) {
+    pthread_once(&mode_once, mode_init);
+    return current_mode;
+}
+
+// ============================ FORMAT .NPY ======================================
+
+static void fail(const char *path, const char *msg) {
+    fprintf(stderr, "mapfile_open: %s : %s\n", path, msg);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * Valeur associée à la clé `key` dans le dictionnaire d'en-tête `.npy` (après les deux-points).
+ */
+static const char *npy_field(const char *path, const char *header, const char *key) {
+    const char *p = strstr(header, key);
+    if (!p) {
+        fail(path, "en-tête .npy incomplet");
+    }
+    p = strchr(p + strlen(key), ':');
+    if (!p) {
+        fail(path, "en-tête .npy invalide");
+    }
+    ++p;
+    while (*p == ' ') {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * Lire l'en-tête d'un fichier `.npy` (versions 1 à 3) : décalage des données, forme et ordre.
+ */
+static void npy_parse(const char *path, const unsigned char *bytes, size_t length, mapped_array_t *array) {
+    size_t hlen, offset;
+    if (length < 10) {
+        fail(path, "fichier .npy tronqué");
+    }
+    if (bytes[6] == 1) {
+        hlen = (size_t)bytes[8] | (size_t)bytes[9] << 8;
+        offset = 10 + hlen;
+    } else if (length >= 12 && (bytes[6] == 2 || bytes[6] == 3)) {
+        hlen = (size_t)bytes[8] | (size_t)bytes[9] << 8 | (size_t)bytes[10] << 16 | (size_t)bytes[11] << 24;
+        offset = 12 + hlen;
+    } else {
+        fail(path, "version .npy non prise en charge");
+    }
+    if (offset > length) {
+        fail(path, "en-tête .npy tronqué");
+    }
+
+    // Copie de l'en-tête en chaîne terminée par un zéro
+    char *header = alloc_array(hlen + 1, 1);
+    memcpy(header, bytes + offset - hlen, hlen);
+    header[hlen] = '\0';
+
+    const char *descr = npy_field(path, header, "'descr'");
+    if (strncmp(descr, "'<f8'", 5) != 0 && strncmp(descr, "'=f8'", 5) != 0) {
+        fail(path, "seul le type float64 ('<f8') est pris en charge");
+    }
+    array->fortran_order = strncmp(npy_field(path, header, "'fortran_order'"), "True", 4) == 0;
+
+    // Forme : (n,) ou (m, n)
+    const char *shape = npy_field(path, header, "'shape'");
+    size_t dims[2] = { 0, 1 }, ndim = 0;
+    if (*shape++ != '(') {
+        fail(path, "forme .npy invalide");
+    }
+    while (*shape && *shape != ')') {
+        char *end;
+        unsigned long long d = strtoull(shape, &end, 10);
+        if (end == shape) {
+            break;
+        }
+        if (ndim == 2) {
+            fail(path, "seuls les tableaux à 1 ou 2 dimensions sont pris en charge");
+        }
+        if (d > SIZE_MAX) {
+            fail(path, "forme .npy trop grande");
+        }
+        dims[ndim++] = (size_t)d;
+        shape = end;
+        while (*shape == ',' || *shape == ' ') {
+            ++shape;
+        }
+    }
+    if (ndim == 0) {
+        fail(path, "tableau .npy de dimension 0");
+    }
+    alloc_free(header);
+
+    // Forme lue dans le fichier : les produits sont vérifiés avant d'être calculés, pour
+    // qu'un dépassement ne fasse pas passer une forme plus grande que les données
+    if (dims[1] != 0 && dims[0] > SIZE_MAX / dims[1]) {
+        fail(path, "forme .npy trop grande");
+    }
+    array->ndim = ndim;
+    array->rows = dims[0];
+    array->cols = dims[1];
+    array->count = dims[0] * dims[1];
+    if (array->count > (length - offset) / sizeof(double)) {
+        fail(path, "données .npy tronquées");
+    }
+    array->data = (double *)(bytes + offset);
+}
+
+// ======================= PROJECTION ET CHARGEMENT ===============================
+
+mapped_array_t mapfile_open(const char *path, mapfile_mode_t mode) {
+    mapped_array_t array = { NULL, 0, NULL, 0, 1, 0, 1, false };
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        fail(path, "fichier vide ou illisible");
+    }
+    array.length = (size_t)st.st_size;
+
+    // Lecture seule et privée : les noyaux ne modifient jamais leurs entrées
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (mode == MAPFILE_POPULATE) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    array.addr = mmap(NULL, array.length, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (array.addr == MAP_FAILED) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    // Les réductions lisent chaque bloc une seule fois, dans l'ordre : lecture anticipée agressive
+    if (mode != MAPFILE_POPULATE) {
+        madvise(array.addr, array.length, MADV_SEQUENTIAL);
+    }
+
+    // Format : `.npy` si la signature est présente, sinon float64 brut
+    const unsigned char *bytes = array.addr;
+    if (array.length >= 6 && memcmp(bytes, "\x93NUMPY", 6) == 0) {
+        npy_parse(path, bytes, array.length, &array);
+    } else {
+        if (array.length % sizeof(double) != 0) {
+            fail(path, "taille non multiple de 8 octets pour un fichier float64 brut");
+        }
+        array.data = array.addr;
+        array.count = array.length / sizeof(double);
+        array.rows = array.count;
+    }
+
+    if (mode == MAPFILE_TOUCH) {
+        mapfile_touch(&array);
+    }
+
+    return array;
+}
+
+/**
+ * Tâche de premier accès : lire un octet par page du bloc [start, end).
+ */
+typedef struct {
+    const volatile char *start; // Début du bloc
+    const volatile char *end;   // Fin du bloc
+    size_t page;                // Taille d'une page
+} TouchData;
+
+static void *touch_block(void *arg) {
+    TouchData *data = (TouchData *)arg;
+    for (const volatile char *p = data->start; p < data->end; p += data->page) {
+        (void)*p;
+    }
+    return NULL;
+}
+
+void mapfile_touch(const mapped_array_t *array) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t n = array->length / sizeof(double);
+
+    // Même découpage que les noyaux (blocs de doubles tenant dans le cache), arrondi aux pages
+    size_t nb_chunks = partition_count(n, 0, pool_size(pool_current()), sizeof(double));
+    TouchData *tasks = alloc_array(nb_chunks, sizeof(TouchData));
+    for (size_t i = 0; i < nb_chunks; ++i) {
+        size_t start, end;
+        partition_bounds(n, nb_chunks, i, &start, &end);
+        start = start * sizeof(double) / page * page;
+        end = i + 1 == nb_chunks ? array->length : end * sizeof(double);
+        tasks[i].start = (const char *)array->addr + start;
+        tasks[i].end = (const char *)array->addr + end;
+        tasks[i].page = page;
+    }
+
+    pool_run(pool_current(), nb_chunks, touch_block, tasks, sizeof(TouchData));
+    alloc_free(tasks);
+}
+
+bool mapfile_matrix_shape(const mapped_array_t *array, size_t raw_cols, size_t *m, size_t *n) {
+    if (array->ndim == 2) {
+        *m = array->fortran_order ? array->cols : array->rows;
+        *n = array->fortran_order ? array->rows : array->cols;
+        return array->fortran_order;
+    }
+    if (raw_cols == 0 || array->count % raw_cols != 0) {
+        fprintf(stderr, "mapfile: %zu éléments ne forment pas des lignes de %zu colonnes\n",
+                array->count, raw_cols);
+        exit(EXIT_FAILURE);
+    }
+    *m = array->count / raw_cols;
+    *n = raw_cols;
+    return false;
+}
+
+void mapfile_close(mapped_array_t *array) {
+    if (array->addr) {
+        munmap(array->addr, array->length);
+    }
+    array->addr = NULL;
+    array->data = NULL;
+}
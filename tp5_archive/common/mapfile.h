@@ -0,0 +1,70 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ===================== PROJECTION DE FICHIERS EN MÉMOIRE ========================
+
+/**
+ * Manière de charger les pages d'un fichier projeté :
+ *  - MAPFILE_LAZY     : à la demande, au premier accès des noyaux ;
+ *  - MAPFILE_TOUCH    : premier accès anticipé en parallèle, chaque tâche du pool
+ *    touchant son propre bloc (défauts de page et lectures répartis sur les cœurs) ;
+ *  - MAPFILE_POPULATE : `MAP_POPULATE`, tout le fichier lu par le thread appelant.
+ */
+typedef enum {
+    MAPFILE_LAZY,
+    MAPFILE_TOUCH,
+    MAPFILE_POPULATE
+} mapfile_mode_t;
+
+/**
+ * Tableau de doubles projeté depuis un fichier brut (float64 natif, sans en-tête)
+ * ou un fichier `.npy` (dtype `<f8`, 1 ou 2 dimensions). Les données sont lues
+ * en place : `data` pointe directement dans la projection, sans copie.
+ */
+typedef struct {
+    void *addr;            // Début de la projection (en-tête compris)
+    size_t length;         // Taille de la projection en octets
+    double *data;          // Premier élément
+    size_t count;          // Nombre d'éléments
+    size_t ndim;           // Nombre de dimensions (1 pour un fichier brut)
+    size_t rows;           // Nombre de lignes (.npy 2D ; sinon `count`)
+    size_t cols;           // Nombre de colonnes (.npy 2D ; sinon 1)
+    bool fortran_order;    // Matrice stockée par colonnes (.npy `fortran_order: True`)
+} mapped_array_t;
+
+/**
+ * Mode de chargement courant. Par défaut MAPFILE_TOUCH, ou la valeur de la
+ * variable d'environnement `MAP_MODE` (`lazy`, `touch` ou `populate`).
+ */
+mapfile_mode_t mapfile_get_mode(void);
+
+/**
+ * Projeter le fichier `path` en lecture seule et charger ses pages selon `mode`.
+ * Le format est déduit du contenu (signature `.npy`), sinon le fichier est brut.
+ * En cas d'échec (fichier absent, format non pris en charge), le programme s'arrête avec un message.
+ */
+mapped_array_t mapfile_open(const char *path, mapfile_mode_t mode);
+
+/**
+ * Toucher en parallèle chaque page de la projection, un bloc par tâche du pool global.
+ */
+void mapfile_touch(const mapped_array_t *array);
+
+/**
+ * Dimensions de la matrice telle qu'elle est rangée dans le fichier, lue ligne par ligne :
+ * `rows` x `cols` pour un `.npy` 2D en ordre C, `cols` x `rows` (la transposée) en ordre
+ * Fortran, et `count / raw_cols` x `raw_cols` pour un fichier brut ou un `.npy` 1D.
+ * Retourne vrai si la matrice logique est la transposée de ce rangement (ordre Fortran).
+ * Le programme s'arrête si `count` n'est pas un multiple de `raw_cols`.
+ */
+bool mapfile_matrix_shape(const mapped_array_t *array, size_t raw_cols, size_t *m, size_t *n);
+
+/**
+ * Supprimer la projection.
+ */
+void mapfile_close(mapped_array_t *array);
+
+#endif // MAPFILE_H
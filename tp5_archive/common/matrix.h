@@ -0,0 +1,61 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stddef.h>
+
+// ============================ VUE SUR UNE MATRICE ===============================
+
+/**
+ * Vue sur une matrice m x n sans copie : l'élément (i, j) se trouve à
+ * `base[i * row_stride + j * col_stride]`. Une même structure décrit donc une
+ * matrice stockée par lignes, par colonnes, ou une sous-matrice de l'une d'elles.
+ */
+typedef struct {
+    double *base;          // Adresse de l'élément (0, 0)
+    size_t m;              // Nombre de lignes
+    size_t n;              // Nombre de colonnes
+    ptrdiff_t row_stride;  // Distance (en éléments) entre deux lignes consécutives
+    ptrdiff_t col_stride;  // Distance (en éléments) entre deux colonnes consécutives
+} matrix_view_t;
+
+/**
+ * Matrice m x n stockée par lignes (ordre C), de dimension principale `ld` >= n.
+ */
+static inline matrix_view_t matrix_row_major(size_t m, size_t n, size_t ld, double *A) {
+    matrix_view_t v = { A, m, n, (ptrdiff_t)ld, 1 };
+    return v;
+}
+
+/**
+ * Matrice m x n stockée par colonnes (ordre Fortran), de dimension principale `ld` >= m.
+ */
+static inline matrix_view_t matrix_col_major(size_t m, size_t n, size_t ld, double *A) {
+    matrix_view_t v = { A, m, n, 1, (ptrdiff_t)ld };
+    return v;
+}
+
+/**
+ * Sous-matrice de `A` de taille rows x cols commençant à l'élément (i0, j0).
+ */
+static inline matrix_view_t matrix_sub(matrix_view_t A, size_t i0, size_t j0, size_t rows, size_t cols) {
+    matrix_view_t v = { A.base + (ptrdiff_t)i0 * A.row_stride + (ptrdiff_t)j0 * A.col_stride,
+                        rows, cols, A.row_stride, A.col_stride };
+    return v;
+}
+
+/**
+ * Transposée de `A` (simple échange des dimensions et des pas).
+ */
+static inline matrix_view_t matrix_transpose(matrix_view_t A) {
+    matrix_view_t v = { A.base, A.n, A.m, A.col_stride, A.row_stride };
+    return v;
+}
+
+/**
+ * Adresse de l'élément (i, j).
+ */
+static inline double *matrix_at(matrix_view_t A, size_t i, size_t j) {
+    return A.base + (ptrdiff_t)i * A.row_stride + (ptrdiff_t)j * A.col_stride;
+}
+
+#endif // MATRIX_H
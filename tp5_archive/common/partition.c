@@ -0,0 +1,67 @@
+#include <stddef.h>
+#include <unistd.h>
+
+#include "partition.h"
+
+// Taille de L2 retenue si `sysconf` ne la connaît pas
+#define DEFAULT_L2_SIZE (256 * 1024)
+
+size_t cache_l2_size(void) {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) {
+        return (size_t)size;
+    }
+#endif
+    return DEFAULT_L2_SIZE;
+}
+
+size_t partition_count(size_t n, size_t k, size_t nb_threads, size_t bytes_per_elem) {
+    if (n == 0) {
+        return 0;
+    }
+
+    // Taille de bloc imposée : blocs d'au plus k éléments
+    if (k > 0) {
+        return (n + k - 1) / k;
+    }
+
+    if (nb_threads == 0) {
+        nb_threads = 1;
+    }
+    if (bytes_per_elem == 0) {
+        bytes_per_elem = sizeof(double);
+    }
+
+    // Bloc tenant dans la moitié du L2, sans descendre sous PARTITION_MIN_CHUNK
+    size_t chunk = cache_l2_size() / 2 / bytes_per_elem;
+    if (chunk < PARTITION_MIN_CHUNK) {
+        chunk = PARTITION_MIN_CHUNK;
+    }
+
+    size_t nb_chunks = (n + chunk - 1) / chunk;
+
+    // Petits tableaux : un bloc par thread tant que les blocs restent assez gros
+    if (nb_chunks < nb_threads) {
+        size_t by_min = (n + PARTITION_MIN_CHUNK - 1) / PARTITION_MIN_CHUNK;
+        return by_min < nb_threads ? by_min : nb_threads;
+    }
+
+    // Grands tableaux : arrondi au multiple de nb_threads supérieur
+    nb_chunks = (nb_chunks + nb_threads - 1) / nb_threads * nb_threads;
+    return nb_chunks < n ? nb_chunks : n;
+}
+
+void partition_bounds(size_t n, size_t nb_chunks, size_t i, size_t *start, size_t *end) {
+    size_t base = n / nb_chunks;   // Taille commune à tous les blocs
+    size_t rem = n % nb_chunks;    // Éléments restants, donnés aux `rem` derniers blocs
+    size_t first_big = nb_chunks - rem;
+
+    if (i < first_big) {
+        *start = i * base;
+        *end = *start + base;
+    } else {
+        *start = first_big * base + (i - first_big) * (base + 1);
+        *end = *start + base + 1;
+    }
+}
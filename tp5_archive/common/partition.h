@@ -0,0 +1,34 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stddef.h>
+
+// ======================== DÉCOUPAGE EN BLOCS ====================================
+
+// Taille minimale d'un bloc choisi automatiquement (en éléments)
+#define PARTITION_MIN_CHUNK 4096
+
+/**
+ * Nombre de blocs à utiliser pour traiter `n` éléments.
+ *  - si `k > 0`, la taille de bloc est imposée : on obtient ceil(n / k) blocs
+ *    d'au plus k éléments (utile pour les expériences) ;
+ *  - si `k == 0`, le nombre de blocs est choisi automatiquement : chaque bloc
+ *    tient dans la moitié du cache L2 (`bytes_per_elem` octets lus par élément),
+ *    et le nombre de blocs est un multiple de `nb_threads` pour équilibrer la charge.
+ * Le résultat vaut au moins 1 (si n > 0) et au plus n.
+ */
+size_t partition_count(size_t n, size_t k, size_t nb_threads, size_t bytes_per_elem);
+
+/**
+ * Bornes [start, end) du bloc `i` parmi `nb_chunks` blocs couvrant `n` éléments.
+ * Tous les éléments sont couverts : les blocs font n / nb_chunks éléments et
+ * le reste est réparti (un élément de plus) sur les derniers blocs.
+ */
+void partition_bounds(size_t n, size_t nb_chunks, size_t i, size_t *start, size_t *end);
+
+/**
+ * Taille du cache L2 en octets (valeur par défaut si le système ne la fournit pas).
+ */
+size_t cache_l2_size(void);
+
+#endif // PARTITION_H
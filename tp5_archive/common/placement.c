@@ -0,0 +1,271 @@
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "placement.h"
+#include "thread_pool.h"
+#include "partition.h"
+#include "tile.h"
+#include "alloc.h"
+
+// Nombre maximal de nœuds NUMA examinés
+#define MAX_NODES 256
+
+// ======================== TOPOLOGIE ET POLITIQUE ================================
+
+static affinity_policy_t current_policy = AFFINITY_NONE;
+static int list_cpus[AFFINITY_MAX_CPUS];   // Cœurs de la politique AFFINITY_LIST
+static size_t list_count = 0;
+static int cpu_node[AFFINITY_MAX_CPUS];     // Nœud NUMA de chaque cœur
+static cpu_set_t allowed;                   // Cœurs autorisés pour le processus
+static bool allowed_known = false;          // `allowed` lu (sinon aucun placement)
+static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Lire une liste de cœurs au format du noyau (`0-3,8,10-11`) et marquer leur nœud.
+ */
+static void parse_node_cpulist(const char *text, int node) {
+    const char *p = text;
+    while (*p) {
+        char *end;
+        long first = strtol(p, &end, 10), last = first;
+        if (end == p) {
+            break;
+        }
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+        }
+        for (long c = first; c <= last && c < AFFINITY_MAX_CPUS; ++c) {
+            if (c >= 0) {
+                cpu_node[c] = node;
+            }
+        }
+        p = *end == ',' ? end + 1 : end;
+        if (*p == '\n') {
+            break;
+        }
+    }
+}
+
+static void placement_init(void) {
+    // Nœud de chaque cœur, d'après /sys (un seul nœud si l'information est absente)
+    for (int node = 0; node < MAX_NODES; ++node) {
+        char path[64], text[4096];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *f = fopen(path, "r");
+        if (!f) {
+            continue;
+        }
+        if (fgets(text, sizeof(text), f)) {
+            parse_node_cpulist(text, node);
+        }
+        fclose(f);
+    }
+
+    // Cœurs autorisés, lus avant que le pool ne place un thread : après `pool_pin_caller`,
+    // le masque du thread principal ne contient plus que son propre cœur
+    CPU_ZERO(&allowed);
+    allowed_known = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    const char *env = getenv("POOL_AFFINITY");
+    if (!env || !*env || strcmp(env, "none") == 0) {
+        return;
+    }
+    if (strcmp(env, "compact") == 0) {
+        current_policy = AFFINITY_COMPACT;
+    } else if (strcmp(env, "scatter") == 0) {
+        current_policy = AFFINITY_SCATTER;
+    } else {
+        // Liste explicite de cœurs
+        const char *p = env;
+        while (*p && list_count < AFFINITY_MAX_CPUS) {
+            char *end;
+            long c = strtol(p, &end, 10);
+            if (end == p || c < 0 || c >= AFFINITY_MAX_CPUS) {
+                fprintf(stderr, "POOL_AFFINITY : valeur invalide '%s'\n", env);
+                exit(EXIT_FAILURE);
+            }
+            p = *end == ',' ? end + 1 : end;
+            if (!allowed_known || c >= CPU_SETSIZE || !CPU_ISSET((int)c, &allowed)) {
+                fprintf(stderr, "POOL_AFFINITY : cœur %ld non autorisé pour le processus, ignoré\n", c);
+                continue;
+            }
+            list_cpus[list_count++] = (int)c;
+        }
+        current_policy = list_count ? AFFINITY_LIST : AFFINITY_NONE;  // Aucun cœur autorisé : pas de placement
+    }
+}
+
+affinity_policy_t affinity_get_policy(void) {
+    pthread_once(&init_once, placement_init);
+    return current_policy;
+}
+
+const char *affinity_policy_name(affinity_policy_t policy) {
+    switch (policy) {
+    case AFFINITY_NONE:    return "none";
+    case AFFINITY_COMPACT: return "compact";
+    case AFFINITY_SCATTER: return "scatter";
+    case AFFINITY_LIST:    return "list";
+    }
+    return "?";
+}
+
+int affinity_cpu_node(int cpu) {
+    pthread_once(&init_once, placement_init);
+    return cpu >= 0 && cpu < AFFINITY_MAX_CPUS ? cpu_node[cpu] : 0;
+}
+
+size_t affinity_cpus(int cpus[AFFINITY_MAX_CPUS]) {
+    affinity_policy_t policy = affinity_get_policy();
+    if (policy == AFFINITY_NONE || !allowed_known) {
+        return 0;
+    }
+    if (policy == AFFINITY_LIST) {
+        memcpy(cpus, list_cpus, list_count * sizeof(int));  // Déjà restreinte à `allowed`
+        return list_count;
+    }
+
+    // Cœurs autorisés pour le processus, dans l'ordre des numéros
+    int max_node = 0;
+    for (int c = 0; c < AFFINITY_MAX_CPUS && c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &allowed) && cpu_node[c] > max_node) {
+            max_node = cpu_node[c];
+        }
+    }
+
+    // Compact : nœud par nœud ; dispersé : un cœur de chaque nœud à tour de rôle
+    size_t count = 0;
+    if (policy == AFFINITY_COMPACT) {
+        for (int node = 0; node <= max_node; ++node) {
+            for (int c = 0; c < AFFINITY_MAX_CPUS && c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(c, &allowed) && cpu_node[c] == node) {
+                    cpus[count++] = c;
+                }
+            }
+        }
+    } else {
+        int next[MAX_NODES] = { 0 };  // Prochain cœur à examiner sur chaque nœud
+        for (size_t added = 1; added; ) {
+            added = 0;
+            for (int node = 0; node <= max_node; ++node) {
+                int c = next[node];
+                while (c < AFFINITY_MAX_CPUS && c < CPU_SETSIZE && !(CPU_ISSET(c, &allowed) && cpu_node[c] == node)) {
+                    ++c;
+                }
+                if (c < AFFINITY_MAX_CPUS && c < CPU_SETSIZE) {
+                    cpus[count++] = c;
+                    ++added;
+                }
+                next[node] = c + 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Threads placés sur chaque cœur par les pools existants
+static unsigned cpu_users[AFFINITY_MAX_CPUS];
+static pthread_mutex_t users_lock = PTHREAD_MUTEX_INITIALIZER;
+
+size_t affinity_reserve(size_t count, int cpu[]) {
+    static int cpus[AFFINITY_MAX_CPUS];  // Protégé par `users_lock`
+    pthread_mutex_lock(&users_lock);
+    size_t nb_cpus = affinity_cpus(cpus);
+
+    // Chaque thread prend le cœur le moins occupé, le premier dans l'ordre de la politique
+    for (size_t i = 0; i < count; ++i) {
+        cpu[i] = -1;
+        for (size_t c = 0; c < nb_cpus; ++c) {
+            if (cpu[i] < 0 || cpu_users[cpus[c]] < cpu_users[cpu[i]]) {
+                cpu[i] = cpus[c];
+            }
+        }
+        if (cpu[i] >= 0) {
+            ++cpu_users[cpu[i]];
+        }
+    }
+
+    pthread_mutex_unlock(&users_lock);
+    return nb_cpus;
+}
+
+void affinity_release(size_t count, const int cpu[]) {
+    pthread_mutex_lock(&users_lock);
+    for (size_t i = 0; i < count; ++i) {
+        if (cpu[i] >= 0 && cpu_users[cpu[i]] > 0) {
+            --cpu_users[cpu[i]];
+        }
+    }
+    pthread_mutex_unlock(&users_lock);
+}
+
+void affinity_pin_self(int cpu) {
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "affinity: impossible de placer le thread sur le cœur %d\n", cpu);
+    }
+}
+
+// ======================= INITIALISATION PAR PREMIER ACCÈS =======================
+
+/**
+ * Tâche de remplissage d'un bloc de vecteur ou d'une tuile de matrice.
+ */
+typedef struct {
+    tile_t tile;           // Lignes et colonnes à remplir (une seule ligne pour un vecteur)
+    matrix_view_t A;       // Vue sur les données
+    double base;           // Valeur de l'élément (0, 0)
+} FillData;
+
+static void *fill_tile(void *arg) {
+    FillData *data = (FillData *)arg;
+    for (size_t i = 0; i < data->tile.rows; ++i) {
+        size_t row = data->tile.i0 + i;
+        double *p = matrix_at(data->A, row, data->tile.j0);
+        double v = data->base + (double)row * data->A.n + data->tile.j0;
+        for (size_t j = 0; j < data->tile.cols; ++j) {
+            p[(ptrdiff_t)j * data->A.col_stride] = v + (double)j;
+        }
+    }
+    return NULL;
+}
+
+void first_touch_fill(size_t n, double *a, double base, size_t bytes_per_elem) {
+    size_t nb_chunks = partition_count(n, 0, pool_size(pool_current()), bytes_per_elem);
+    FillData *tasks = alloc_array(nb_chunks, sizeof(FillData));
+    for (size_t i = 0; i < nb_chunks; ++i) {
+        size_t start, end;
+        partition_bounds(n, nb_chunks, i, &start, &end);
+        tasks[i].tile = (tile_t){ 0, start, 1, end - start };
+        tasks[i].A = matrix_row_major(1, n, n, a);
+        tasks[i].base = base;
+    }
+    pool_run(pool_current(), nb_chunks, fill_tile, tasks, sizeof(FillData));
+    alloc_free(tasks);
+}
+
+void first_touch_fill_matrix(matrix_view_t A, double base) {
+    tile_plan_t plan = tile_plan(A.m, A.n, pool_size(pool_current()), sizeof(double));
+    size_t nb_tiles = tile_count(&plan);
+    FillData *tasks = alloc_array(nb_tiles, sizeof(FillData));
+    for (size_t t = 0; t < nb_tiles; ++t) {
+        tasks[t].tile = tile_get(&plan, t);
+        tasks[t].A = A;
+        tasks[t].base = base;
+    }
+    pool_run(pool_current(), nb_tiles, fill_tile, tasks, sizeof(FillData));
+    alloc_free(tasks);
+}
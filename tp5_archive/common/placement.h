@@ -0,0 +1,87 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stddef.h>
+
+#include "matrix.h"
+
+// ===================== PLACEMENT DES THREADS ET DES DONNÉES =====================
+
+/**
+ * Placement des threads du pool sur les cœurs :
+ *  - AFFINITY_NONE    : laissé à l'ordonnanceur du système (défaut) ;
+ *  - AFFINITY_COMPACT : threads consécutifs sur des cœurs voisins, nœud NUMA par nœud ;
+ *  - AFFINITY_SCATTER : threads répartis à tour de rôle sur les nœuds NUMA ;
+ *  - AFFINITY_LIST    : liste explicite de cœurs (thread i sur le i-ème cœur de la liste).
+ */
+typedef enum {
+    AFFINITY_NONE,
+    AFFINITY_COMPACT,
+    AFFINITY_SCATTER,
+    AFFINITY_LIST
+} affinity_policy_t;
+
+// Nombre maximal de cœurs pris en compte
+#define AFFINITY_MAX_CPUS 1024
+
+/**
+ * Politique courante, lue dans la variable d'environnement `POOL_AFFINITY` :
+ * `compact`, `scatter`, ou une liste de cœurs (`0,2,4,6`), dont les cœurs non autorisés
+ * pour le processus sont ignorés (avec un message). Par défaut AFFINITY_NONE.
+ */
+affinity_policy_t affinity_get_policy(void);
+
+/**
+ * Nom lisible d'une politique.
+ */
+const char *affinity_policy_name(affinity_policy_t policy);
+
+/**
+ * Ordre des cœurs selon la politique courante, restreint aux cœurs autorisés pour
+ * le processus : le thread i du pool est placé sur `cpus[i % count]`. Retourne `count`
+ * (0 pour AFFINITY_NONE).
+ */
+size_t affinity_cpus(int cpus[AFFINITY_MAX_CPUS]);
+
+/**
+ * Réserver un cœur pour chacun des `count` threads d'un pool, écrit dans `cpu` (-1 pour
+ * AFFINITY_NONE) : chaque thread prend, dans l'ordre de `affinity_cpus`, le cœur où les
+ * pools existants ont placé le moins de threads. Le premier pool occupe ainsi les premiers
+ * cœurs, et un pool créé pendant qu'un autre existe se place sur les cœurs suivants ;
+ * les cœurs ne sont partagés qu'une fois tous occupés. Retourne le nombre de cœurs de
+ * la politique (0 : threads non placés).
+ */
+size_t affinity_reserve(size_t count, int cpu[]);
+
+/**
+ * Rendre les cœurs réservés par `affinity_reserve` (à la destruction du pool).
+ */
+void affinity_release(size_t count, const int cpu[]);
+
+/**
+ * Placer le thread appelant sur le cœur `cpu` (sans effet si `cpu` est négatif).
+ */
+void affinity_pin_self(int cpu);
+
+/**
+ * Nœud NUMA du cœur `cpu` (0 si le système n'en déclare qu'un).
+ */
+int affinity_cpu_node(int cpu);
+
+// ======================= INITIALISATION PAR PREMIER ACCÈS =======================
+
+/**
+ * Remplir a[i] = base + i en parallèle, par les blocs de `partition_count(n, 0, ...)`
+ * pour `bytes_per_elem` octets lus par élément (les mêmes blocs que le noyau qui lira
+ * le tableau). Chaque page est ainsi écrite pour la première fois, donc allouée sur
+ * le nœud NUMA du thread qui traitera ce bloc (ordonnancement statique du pool).
+ */
+void first_touch_fill(size_t n, double *a, double base, size_t bytes_per_elem);
+
+/**
+ * Remplir A(i, j) = base + i * A.n + j en parallèle, tuile par tuile selon `tile_plan`
+ * (les mêmes tuiles que les noyaux de normes).
+ */
+void first_touch_fill_matrix(matrix_view_t A, double base);
+
+#endif // PLACEMENT_H
@@ -0,0 +1,55 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "prefetch.h"
+
+// ========================= RÉGLAGES DU PRÉCHARGEMENT ============================
+
+static size_t distance = 0;
+static prefetch_hint_t hint = PREFETCH_NTA;
+static pthread_once_t prefetch_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Distance bornée à PREFETCH_DIST_MAX et arrondie à une ligne de cache.
+ */
+static size_t distance_clamp(size_t bytes) {
+    bytes = bytes < PREFETCH_DIST_MAX ? bytes : PREFETCH_DIST_MAX;
+    return (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+static void prefetch_init(void) {
+    const char *env = getenv("PREFETCH_DIST");
+    if (env) {
+        distance = distance_clamp(strtoul(env, NULL, 10));
+    }
+    env = getenv("PREFETCH_HINT");
+    if (env && strcmp(env, "t0") == 0) {
+        hint = PREFETCH_T0;
+    }
+}
+
+size_t prefetch_get_distance(void) {
+    pthread_once(&prefetch_once, prefetch_init);
+    return distance;
+}
+
+void prefetch_set_distance(size_t bytes) {
+    pthread_once(&prefetch_once, prefetch_init);
+    distance = distance_clamp(bytes);
+}
+
+prefetch_hint_t prefetch_get_hint(void) {
+    pthread_once(&prefetch_once, prefetch_init);
+    return hint;
+}
+
+void prefetch_set_hint(prefetch_hint_t value) {
+    pthread_once(&prefetch_once, prefetch_init);
+    hint = value;
+}
+
+const char *prefetch_hint_name(prefetch_hint_t value) {
+    return value == PREFETCH_T0 ? "t0" : "nta";
+}
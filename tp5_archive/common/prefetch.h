@@ -0,0 +1,120 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <stddef.h>
+
+#include "reduce.h"
+
+// ====================== PRÉCHARGEMENT LOGICIEL =================================
+
+/**
+ * Préchargement logiciel des noyaux de réduction (`compute_block` du produit scalaire,
+ * `compute_tile_sum` et `compute_tile_max` des normes). Par défaut, on compte sur le
+ * préchargeur matériel ; il perd la trace des flux quand de nombreux threads lisent la
+ * mémoire en même temps, et à chaque changement de ligne d'une sous-matrice (saut de
+ * `row_stride`). Avec une distance non nulle, les noyaux traitent leurs données par
+ * pas de PREFETCH_STEP octets et demandent, avant chaque pas, les lignes de cache
+ * situées `distance` octets plus loin ; dans une tuile, le segment de la ligne située
+ * à cette distance (au moins la ligne suivante).
+ *
+ * Une réduction ne lit chaque élément qu'une fois : par défaut, l'indication est
+ * non temporelle (`prefetchnta` sur x86), pour ne pas chasser du cache les données
+ * des autres threads. Les tuiles sont lues dans le même ordre avec ou sans
+ * préchargement ; le produit scalaire, découpé en pas, ne l'utilise pas en sommation
+ * compensée (résultat indépendant des réglages).
+ */
+typedef enum {
+    PREFETCH_NTA,          // Lecture unique : le moins de pollution possible des caches
+    PREFETCH_T0            // Données gardées dans tous les niveaux de cache
+} prefetch_hint_t;
+
+// Octets traités entre deux préchargements (32 lignes de cache)
+#define PREFETCH_STEP (32 * CACHE_LINE)
+// Distance de préchargement maximale (au-delà, les lignes sont évincées avant d'être lues)
+#define PREFETCH_DIST_MAX (64 * 1024)
+
+/**
+ * Distance de préchargement courante, en octets (0 : préchargement matériel seul).
+ * Par défaut 0, ou la valeur de la variable d'environnement `PREFETCH_DIST`.
+ */
+size_t prefetch_get_distance(void);
+
+/**
+ * Fixer la distance de préchargement (en octets, arrondie à une ligne de cache,
+ * au plus PREFETCH_DIST_MAX ; 0 la désactive).
+ */
+void prefetch_set_distance(size_t bytes);
+
+/**
+ * Indication de localité courante. Par défaut PREFETCH_NTA, ou la valeur de la
+ * variable d'environnement `PREFETCH_HINT` (`nta` ou `t0`).
+ */
+prefetch_hint_t prefetch_get_hint(void);
+
+/**
+ * Forcer l'indication de localité.
+ */
+void prefetch_set_hint(prefetch_hint_t hint);
+
+/**
+ * Nom lisible d'une indication de localité.
+ */
+const char *prefetch_hint_name(prefetch_hint_t hint);
+
+/**
+ * Demander la ligne de cache contenant `p`. L'argument de localité de
+ * `__builtin_prefetch` doit être une constante.
+ */
+static inline void prefetch_line(const void *p, prefetch_hint_t hint) {
+    if (hint == PREFETCH_T0) {
+        __builtin_prefetch(p, 0, 3);
+    } else {
+        __builtin_prefetch(p, 0, 0);
+    }
+}
+
+/**
+ * Demander les lignes de cache couvrant les `n` éléments de `p` situés tous les
+ * `stride` éléments (une seule demande par ligne pour des éléments contigus).
+ */
+static inline void prefetch_segment(const double *p, size_t n, ptrdiff_t stride, prefetch_hint_t hint) {
+    size_t per_line = CACHE_LINE / sizeof(double);
+    size_t abs_stride = (size_t)(stride < 0 ? -stride : stride);
+    size_t step = abs_stride >= per_line || abs_stride == 0 ? 1 : per_line / abs_stride;
+
+    for (size_t j = 0; j < n; j += step) {
+        prefetch_line(p + (ptrdiff_t)j * stride, hint);
+    }
+    if (n > 0 && (n - 1) % step != 0) {
+        prefetch_line(p + (ptrdiff_t)(n - 1) * stride, hint);  // Dernière ligne, entamée
+    }
+}
+
+/**
+ * Nombre de lignes d'une tuile à demander en avance pour une distance de `distance`
+ * octets et des segments de `cols` éléments (au moins 1 ; 0 si le préchargement est désactivé).
+ */
+static inline size_t prefetch_rows_ahead(size_t distance, size_t cols) {
+    size_t seg = cols * sizeof(double);
+    return distance == 0 || seg == 0 ? 0 : (distance + seg - 1) / seg;
+}
+
+/**
+ * Avant de traiter la ligne `i` d'une tuile de `rows` segments de `cols` éléments
+ * (premier élément `first`, pas `row_stride` entre lignes et `col_stride` entre
+ * colonnes), demander le segment de la ligne `i + ahead` ; avant la première ligne,
+ * les `ahead` premiers segments. Sans effet si `ahead` vaut 0.
+ */
+static inline void prefetch_tile_row(const double *first, size_t rows, size_t cols, ptrdiff_t row_stride,
+                                     ptrdiff_t col_stride, size_t i, size_t ahead, prefetch_hint_t hint) {
+    if (ahead == 0) {
+        return;
+    }
+    size_t from = i == 0 ? 0 : i + ahead;
+    size_t to = i + ahead + 1 < rows ? i + ahead + 1 : rows;
+    for (size_t r = from; r < to; ++r) {
+        prefetch_segment(first + (ptrdiff_t)r * row_stride, cols, col_stride, hint);
+    }
+}
+
+#endif // PREFETCH_H
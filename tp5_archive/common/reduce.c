@@ -0,0 +1,172 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "reduce.h"
+#include "trace.h"
+
+// ============================ MODE COURANT ======================================
+
+static reduce_mode_t current_mode = REDUCE_TREE;
+static pthread_once_t mode_once = PTHREAD_ONCE_INIT;
+
+static void mode_init(void) {
+    const char *env = getenv("REDUCE_MODE");
+    if (!env) {
+        return;
+    }
+    if (strcmp(env, "mutex") == 0) {
+        current_mode = REDUCE_MUTEX;
+    } else if (strcmp(env, "atomic") == 0) {
+        current_mode = REDUCE_ATOMIC;
+    } else if (strcmp(env, "tree") == 0) {
+        current_mode = REDUCE_TREE;
+    }
+}
+
+reduce_mode_t reduce_get_mode(void) {
+    pthread_once(&mode_once, mode_init);
+    return current_mode;
+}
+
+void reduce_set_mode(reduce_mode_t mode) {
+    pthread_once(&mode_once, mode_init);
+    current_mode = mode;
+}
+
+const char *reduce_mode_name(reduce_mode_t mode) {
+    switch (mode) {
+    case REDUCE_MUTEX:  return "mutex";
+    case REDUCE_TREE:   return "tree";
+    case REDUCE_ATOMIC: return "atomic";
+    }
+    return "?";
+}
+
+// ============================ MODE DE SOMMATION =================================
+
+static sum_mode_t current_sum_mode = SUM_FAST;
+static pthread_once_t sum_once = PTHREAD_ONCE_INIT;
+
+static void sum_init(void) {
+    const char *env = getenv("SUM_MODE");
+    if (env && strcmp(env, "compensated") == 0) {
+        current_sum_mode = SUM_COMPENSATED;
+    }
+}
+
+sum_mode_t sum_get_mode(void) {
+    pthread_once(&sum_once, sum_init);
+    return current_sum_mode;
+}
+
+void sum_set_mode(sum_mode_t mode) {
+    pthread_once(&sum_once, sum_init);
+    current_sum_mode = mode;
+}
+
+const char *sum_mode_name(sum_mode_t mode) {
+    return mode == SUM_COMPENSATED ? "compensated" : "fast";
+}
+
+// ========================= RÉDUCTION EN ARBRE ===================================
+
+static inline double combine(double a, double b, reduce_op_t op) {
+    if (op == REDUCE_MAX) {
+        return a > b ? a : b;
+    }
+    return a + b;
+}
+
+double reduce_tree(size_t n, padded_double_t slots[n], reduce_op_t op) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    // À chaque niveau, la case i absorbe la case i + stride
+    for (size_t stride = 1; stride < n; stride *= 2) {
+        for (size_t i = 0; i + stride < n; i += 2 * stride) {
+            slots[i].value = combine(slots[i].value, slots[i + stride].value, op);
+        }
+    }
+
+    return slots[0].value;
+}
+
+double reduce_tree_compensated(size_t n, padded_double_t slots[n]) {
+    if (n == 0) {
+        return 0.0;
+    }
+
+    for (size_t stride = 1; stride < n; stride *= 2) {
+        for (size_t i = 0; i + stride < n; i += 2 * stride) {
+            double s, e;
+            two_sum(slots[i].value, slots[i + stride].value, &s, &e);
+            slots[i].value = s;
+            slots[i].error += slots[i + stride].error + e;
+        }
+    }
+
+    return slots[0].value + slots[0].error;
+}
+
+// ======================== PUBLICATION D'UN PARTIEL ==============================
+
+void reduce_shared_init(reduce_shared_t *shared, double value) {
+    shared->value = value;
+    pthread_mutex_init(&shared->mutex, NULL);
+}
+
+void reduce_shared_destroy(reduce_shared_t *shared) {
+    pthread_mutex_destroy(&shared->mutex);
+}
+
+void reduce_publish(const reduce_ctx_t *ctx, reduce_op_t op, double value) {
+    reduce_shared_t *shared = ctx->shared;
+    switch (ctx->mode) {
+    case REDUCE_MUTEX: {
+        // Section critique : une seule tâche à la fois met à jour la variable partagée
+        TRACE_START(t0);
+        pthread_mutex_lock(&shared->mutex);
+        TRACE_STOP(TRACE_LOCK_WAIT, t0, 0);
+        shared->value = combine(shared->value, value, op);
+        pthread_mutex_unlock(&shared->mutex);
+        break;
+    }
+    case REDUCE_ATOMIC:
+        if (op == REDUCE_MAX) {
+            atomic_max_double(&shared->value, value);
+        } else {
+            atomic_add_double(&shared->value, value);
+        }
+        break;
+    case REDUCE_TREE:
+        // Case privée : aucune synchronisation, la combinaison est faite par l'appelant
+        ctx->partial->value = value;
+        break;
+    }
+}
+
+// ========================= OPÉRATIONS ATOMIQUES ================================
+
+void atomic_add_double(double *target, double value) {
+    double expected, desired;
+    __atomic_load(target, &expected, __ATOMIC_RELAXED);
+    do {
+        desired = expected + value;
+    } while (!__atomic_compare_exchange(target, &expected, &desired, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void atomic_max_double(double *target, double value) {
+    double expected;
+    __atomic_load(target, &expected, __ATOMIC_RELAXED);
+    while (value > expected) {
+        if (__atomic_compare_exchange(target, &expected, &value, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
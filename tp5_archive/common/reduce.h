@@ -0,0 +1,167 @@
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+// ========================= MODES DE RÉDUCTION ===================================
+
+/**
+ * Manière dont les tâches combinent leurs résultats partiels :
+ *  - REDUCE_MUTEX  : accumulation dans une variable partagée protégée par un mutex (référence) ;
+ *  - REDUCE_TREE   : chaque tâche écrit dans sa propre case, combinées ensuite par un arbre ;
+ *  - REDUCE_ATOMIC : accumulation sans verrou par compare-and-swap sur la variable partagée.
+ */
+typedef enum {
+    REDUCE_MUTEX,
+    REDUCE_TREE,
+    REDUCE_ATOMIC
+} reduce_mode_t;
+
+/**
+ * Opération de combinaison des résultats partiels.
+ */
+typedef enum {
+    REDUCE_SUM,
+    REDUCE_MAX
+} reduce_op_t;
+
+// Taille d'une ligne de cache (en octets)
+#define CACHE_LINE 64
+
+/**
+ * Case de résultat partiel occupant une ligne de cache entière, pour que deux
+ * tâches voisines n'écrivent jamais dans la même ligne (pas de faux partage).
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) double value;
+    double error;          // Terme de compensation (sommation compensée uniquement)
+} padded_double_t;
+
+/**
+ * Variable partagée des modes `mutex` et `atomic`, seule sur sa ligne de cache, avec
+ * son mutex sur la ligne suivante : les tâches qui la mettent à jour n'invalident
+ * ni les variables locales de l'appelant, ni le verrou tant qu'il n'est pas pris.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) double value;        // Résultat partagé
+    _Alignas(CACHE_LINE) pthread_mutex_t mutex; // Verrou du mode `mutex`
+} reduce_shared_t;
+
+// ========================= MODES DE SOMMATION ===================================
+
+/**
+ * Précision des sommes parallèles :
+ *  - SUM_FAST        : sommation naïve, résultat dépendant du découpage ;
+ *  - SUM_COMPENSATED : produits et sommes sans erreur (algorithme Dot2 d'Ogita-Rump-Oishi)
+ *    sur des blocs de taille fixe, combinés par un arbre fixe. Le résultat est
+ *    identique bit à bit quel que soit le nombre de threads.
+ */
+typedef enum {
+    SUM_FAST,
+    SUM_COMPENSATED
+} sum_mode_t;
+
+// Taille des blocs en sommation compensée (indépendante du nombre de threads)
+#define SUM_REPRO_CHUNK 8192
+
+/**
+ * Mode de sommation courant. Par défaut SUM_FAST, ou la valeur de la
+ * variable d'environnement `SUM_MODE` (`fast` ou `compensated`).
+ */
+sum_mode_t sum_get_mode(void);
+
+/**
+ * Forcer le mode de sommation.
+ */
+void sum_set_mode(sum_mode_t mode);
+
+/**
+ * Nom lisible d'un mode de sommation.
+ */
+const char *sum_mode_name(sum_mode_t mode);
+
+/**
+ * Transformation sans erreur de l'addition (TwoSum de Knuth) : s + e == a + b exactement.
+ */
+static inline void two_sum(double a, double b, double *s, double *e) {
+    double t = a + b;
+    double z = t - a;
+    *e = (a - (t - z)) + (b - z);
+    *s = t;
+}
+
+// ======================== FONCTIONS DE RÉDUCTION ================================
+
+/**
+ * Mode de réduction courant. Par défaut REDUCE_TREE, ou la valeur de la
+ * variable d'environnement `REDUCE_MODE` (`mutex`, `tree` ou `atomic`).
+ */
+reduce_mode_t reduce_get_mode(void);
+
+/**
+ * Forcer le mode de réduction (par exemple pour comparer les modes entre eux).
+ */
+void reduce_set_mode(reduce_mode_t mode);
+
+/**
+ * Nom lisible d'un mode de réduction.
+ */
+const char *reduce_mode_name(reduce_mode_t mode);
+
+/**
+ * Combiner les `n` cases par un arbre binaire de profondeur log2(n).
+ * Le contenu des cases est écrasé ; le résultat est retourné.
+ */
+double reduce_tree(size_t n, padded_double_t slots[n], reduce_op_t op);
+
+/**
+ * Même arbre que `reduce_tree`, pour des cases (valeur, compensation) : les
+ * valeurs sont additionnées sans erreur et les compensations accumulées.
+ * Le résultat retourné est valeur + compensation de la racine.
+ */
+double reduce_tree_compensated(size_t n, padded_double_t slots[n]);
+
+// ======================== CONTEXTE DES TÂCHES ===================================
+
+/**
+ * Partie commune des données de chaque tâche de réduction, placée en tête des
+ * structures `ThreadData`. Son alignement fait commencer chaque tâche du tableau
+ * sur sa propre ligne de cache. Ces champs sont seulement lus par la tâche
+ * (champs froids) ; elle n'écrit que dans la variable partagée ou dans sa case
+ * privée `partial` (champs chauds), rangées chacune sur leur propre ligne ailleurs.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) reduce_shared_t *shared; // Variable partagée (modes mutex et atomique)
+    padded_double_t *partial;  // Case privée du résultat partiel (mode arbre, sommation compensée)
+    reduce_mode_t mode;        // Mode de réduction
+    sum_mode_t sum;            // Mode de sommation
+} reduce_ctx_t;
+
+/**
+ * Initialiser la variable partagée à `value` (et son mutex).
+ */
+void reduce_shared_init(reduce_shared_t *shared, double value);
+
+/**
+ * Détruire le mutex de la variable partagée.
+ */
+void reduce_shared_destroy(reduce_shared_t *shared);
+
+/**
+ * Publier le résultat partiel `value` d'une tâche selon le mode de son contexte :
+ * dans la variable partagée sous mutex, dans la variable partagée par CAS, ou dans sa case privée.
+ */
+void reduce_publish(const reduce_ctx_t *ctx, reduce_op_t op, double value);
+
+/**
+ * Ajouter `value` à `*target` sans verrou (boucle de compare-and-swap).
+ */
+void atomic_add_double(double *target, double value);
+
+/**
+ * Remplacer `*target` par `value` si elle est plus grande, sans verrou.
+ */
+void atomic_max_double(double *target, double value);
+
+#endif // REDUCE_H
@@ -0,0 +1,345 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_NEON 1
+#endif
+
+#include "simd_dot.h"
+#include "reduce.h"
+
+// ============================ NOYAU SCALAIRE ====================================
+
+/**
+ * Version portable : quatre accumulateurs indépendants pour casser la chaîne
+ * de dépendances de l'accumulateur unique de `dotprod_ref`.
+ */
+static double dot_scalar(size_t n, const double *a, const double *b) {
+    double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += a[i] * b[i];
+    }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * Version compensée portable (Dot2) : somme et compensation scalaires.
+ */
+static double dot2_scalar(size_t n, const double *a, const double *b, double *error) {
+    double s = 0., c = 0.;
+
+    for (size_t i = 0; i < n; ++i) {
+        double p = a[i] * b[i];
+        double ep = fma(a[i], b[i], -p);  // Erreur exacte du produit
+        double es;
+        two_sum(s, p, &s, &es);           // Erreur exacte de l'addition
+        c += es + ep;
+    }
+
+    *error = c;
+    return s;
+}
+
+/**
+ * Combiner dans un ordre fixe les `lanes` paires (somme, compensation) d'un noyau compensé.
+ */
+static double dot2_combine(size_t lanes, const double *s, const double *c, double *error) {
+    double sum = s[0], comp = c[0];
+
+    for (size_t l = 1; l < lanes; ++l) {
+        double e;
+        two_sum(sum, s[l], &sum, &e);
+        comp += c[l] + e;
+    }
+
+    *error = comp;
+    return sum;
+}
+
+// ============================== NOYAUX x86 ======================================
+
+#ifdef SIMD_X86
+
+__attribute__((target("sse2")))
+static double dot_sse2(size_t n, const double *a, const double *b) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    size_t i = 0;
+
+    // 4 accumulateurs de 2 doubles : 8 éléments par itération
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+
+    __m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+__attribute__((target("avx2,fma")))
+static double dot_avx2(size_t n, const double *a, const double *b) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    // 4 accumulateurs FMA de 4 doubles : 16 éléments par itération
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+    }
+
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+static double dot_avx512(size_t n, const double *a, const double *b) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    // 4 accumulateurs FMA de 8 doubles : 32 éléments par itération
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+    }
+
+    // Reste traité par un chargement masqué
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i), s1);
+    }
+
+    return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+__attribute__((target("avx2,fma")))
+static double dot2_avx2(size_t n, const double *a, const double *b, double *error) {
+    __m256d s0 = _mm256_setzero_pd(), c0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    // Deux paires (somme, compensation) indépendantes pour masquer la latence de TwoSum
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(a + i), y0 = _mm256_loadu_pd(b + i);
+        __m256d x1 = _mm256_loadu_pd(a + i + 4), y1 = _mm256_loadu_pd(b + i + 4);
+        __m256d p0 = _mm256_mul_pd(x0, y0), p1 = _mm256_mul_pd(x1, y1);
+        __m256d ep0 = _mm256_fmsub_pd(x0, y0, p0);    // Erreurs exactes des produits
+        __m256d ep1 = _mm256_fmsub_pd(x1, y1, p1);
+        __m256d t0 = _mm256_add_pd(s0, p0), t1 = _mm256_add_pd(s1, p1);   // TwoSum(s, p)
+        __m256d z0 = _mm256_sub_pd(t0, s0), z1 = _mm256_sub_pd(t1, s1);
+        __m256d es0 = _mm256_add_pd(_mm256_sub_pd(s0, _mm256_sub_pd(t0, z0)), _mm256_sub_pd(p0, z0));
+        __m256d es1 = _mm256_add_pd(_mm256_sub_pd(s1, _mm256_sub_pd(t1, z1)), _mm256_sub_pd(p1, z1));
+        s0 = t0;
+        s1 = t1;
+        c0 = _mm256_add_pd(c0, _mm256_add_pd(es0, ep0));
+        c1 = _mm256_add_pd(c1, _mm256_add_pd(es1, ep1));
+    }
+
+    double ls[9], lc[9];
+    _mm256_storeu_pd(ls, s0);
+    _mm256_storeu_pd(ls + 4, s1);
+    _mm256_storeu_pd(lc, c0);
+    _mm256_storeu_pd(lc + 4, c1);
+    ls[8] = dot2_scalar(n - i, a + i, b + i, &lc[8]);  // Reste
+    return dot2_combine(9, ls, lc, error);
+}
+
+__attribute__((target("avx512f")))
+static double dot2_avx512(size_t n, const double *a, const double *b, double *error) {
+    __m512d s0 = _mm512_setzero_pd(), c0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    // Deux paires (somme, compensation) indépendantes pour masquer la latence de TwoSum
+    for (; i + 16 <= n; i += 16) {
+        __m512d x0 = _mm512_loadu_pd(a + i), y0 = _mm512_loadu_pd(b + i);
+        __m512d x1 = _mm512_loadu_pd(a + i + 8), y1 = _mm512_loadu_pd(b + i + 8);
+        __m512d p0 = _mm512_mul_pd(x0, y0), p1 = _mm512_mul_pd(x1, y1);
+        __m512d ep0 = _mm512_fmsub_pd(x0, y0, p0);    // Erreurs exactes des produits
+        __m512d ep1 = _mm512_fmsub_pd(x1, y1, p1);
+        __m512d t0 = _mm512_add_pd(s0, p0), t1 = _mm512_add_pd(s1, p1);   // TwoSum(s, p)
+        __m512d z0 = _mm512_sub_pd(t0, s0), z1 = _mm512_sub_pd(t1, s1);
+        __m512d es0 = _mm512_add_pd(_mm512_sub_pd(s0, _mm512_sub_pd(t0, z0)), _mm512_sub_pd(p0, z0));
+        __m512d es1 = _mm512_add_pd(_mm512_sub_pd(s1, _mm512_sub_pd(t1, z1)), _mm512_sub_pd(p1, z1));
+        s0 = t0;
+        s1 = t1;
+        c0 = _mm512_add_pd(c0, _mm512_add_pd(es0, ep0));
+        c1 = _mm512_add_pd(c1, _mm512_add_pd(es1, ep1));
+    }
+
+    double ls[17], lc[17];
+    _mm512_storeu_pd(ls, s0);
+    _mm512_storeu_pd(ls + 8, s1);
+    _mm512_storeu_pd(lc, c0);
+    _mm512_storeu_pd(lc + 8, c1);
+    ls[16] = dot2_scalar(n - i, a + i, b + i, &lc[16]);  // Reste
+    return dot2_combine(17, ls, lc, error);
+}
+
+#endif // SIMD_X86
+
+// ============================== NOYAU NEON ======================================
+
+#ifdef SIMD_NEON
+
+static double dot_neon(size_t n, const double *a, const double *b) {
+    float64x2_t s0 = vdupq_n_f64(0.), s1 = vdupq_n_f64(0.);
+    float64x2_t s2 = vdupq_n_f64(0.), s3 = vdupq_n_f64(0.);
+    size_t i = 0;
+
+    // 4 accumulateurs FMA de 2 doubles : 8 éléments par itération
+    for (; i + 8 <= n; i += 8) {
+        s0 = vfmaq_f64(s0, vld1q_f64(a + i), vld1q_f64(b + i));
+        s1 = vfmaq_f64(s1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+        s2 = vfmaq_f64(s2, vld1q_f64(a + i + 4), vld1q_f64(b + i + 4));
+        s3 = vfmaq_f64(s3, vld1q_f64(a + i + 6), vld1q_f64(b + i + 6));
+    }
+
+    double sum = vaddvq_f64(vaddq_f64(vaddq_f64(s0, s1), vaddq_f64(s2, s3)));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+#endif // SIMD_NEON
+
+// ======================= SÉLECTION À L'EXÉCUTION ================================
+
+// Noyau compensé associé à chaque noyau rapide
+typedef double (*dot2_fn_t)(size_t n, const double *a, const double *b, double *error);
+
+static dot_fn_t selected_fn = dot_scalar;
+static dot2_fn_t selected_fn2 = dot2_scalar;
+static const char *selected_name = "scalar";
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Le noyau `name` est-il utilisable sur cette machine ?
+ */
+static int kernel_available(const char *name, dot_fn_t *fn) {
+    if (strcmp(name, "scalar") == 0) {
+        *fn = dot_scalar;
+        return 1;
+    }
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "avx512") == 0 && __builtin_cpu_supports("avx512f")) {
+        *fn = dot_avx512;
+        return 1;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        *fn = dot_avx2;
+        return 1;
+    }
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        *fn = dot_sse2;
+        return 1;
+    }
+#endif
+#ifdef SIMD_NEON
+    if (strcmp(name, "neon") == 0) {
+        *fn = dot_neon;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Noyau compensé correspondant au noyau `name` (AVX2 et AVX-512 ont le leur).
+ */
+static dot2_fn_t compensated_for(const char *name) {
+#ifdef SIMD_X86
+    if (strcmp(name, "avx512") == 0) {
+        return dot2_avx512;
+    }
+    if (strcmp(name, "avx2") == 0) {
+        return dot2_avx2;
+    }
+#endif
+    (void)name;
+    return dot2_scalar;
+}
+
+static void select_init(void) {
+    static const char *const by_preference[] = { "avx512", "avx2", "sse2", "neon", "scalar" };
+    dot_fn_t fn;
+
+    const char *env = getenv("DOT_KERNEL");
+    if (env && kernel_available(env, &fn)) {
+        selected_fn = fn;
+        selected_fn2 = compensated_for(env);
+        selected_name = env;
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(by_preference) / sizeof(by_preference[0]); ++i) {
+        if (kernel_available(by_preference[i], &fn)) {
+            selected_fn = fn;
+            selected_fn2 = compensated_for(by_preference[i]);
+            selected_name = by_preference[i];
+            return;
+        }
+    }
+}
+
+dot_fn_t simd_dot_select(void) {
+    pthread_once(&select_once, select_init);
+    return selected_fn;
+}
+
+const char *simd_dot_name(void) {
+    pthread_once(&select_once, select_init);
+    return selected_name;
+}
+
+double simd_dot(size_t n, const double *a, const double *b) {
+    return simd_dot_select()(n, a, b);
+}
+
+double simd_dot_compensated(size_t n, const double *a, const double *b, double *error) {
+    pthread_once(&select_once, select_init);
+    return selected_fn2(n, a, b, error);
+}
@@ -0,0 +1,43 @@
+#ifndef SIMD_DOT_H
+#define SIMD_DOT_H
+
+#include <stddef.h>
+
+// ===================== PRODUIT SCALAIRE VECTORISÉ ===============================
+
+/**
+ * Signature d'un noyau de produit scalaire sur `n` éléments contigus.
+ */
+typedef double (*dot_fn_t)(size_t n, const double *a, const double *b);
+
+/**
+ * Produit scalaire avec le noyau le plus rapide disponible sur la machine
+ * (AVX-512, AVX2+FMA, SSE2 ou NEON, sinon scalaire déroulé).
+ * Le choix est fait une seule fois, au premier appel, à partir de CPUID ;
+ * la variable d'environnement `DOT_KERNEL` (`scalar`, `sse2`, `avx2`, `avx512`, `neon`)
+ * permet d'imposer un noyau pour les comparaisons.
+ * Chaque noyau utilise plusieurs accumulateurs indépendants : l'ordre des additions
+ * diffère donc légèrement de celui de `dotprod_ref`.
+ */
+double simd_dot(size_t n, const double *a, const double *b);
+
+/**
+ * Produit scalaire compensé (algorithme Dot2) avec le même choix de noyau :
+ * chaque produit est séparé en partie arrondie et erreur exacte (FMA), chaque
+ * addition par TwoSum. Retourne la somme arrondie et écrit dans `*error` le
+ * terme de compensation, à ajouter au résultat. Le résultat ne dépend que de
+ * `n`, des données et du noyau, jamais du nombre de threads.
+ */
+double simd_dot_compensated(size_t n, const double *a, const double *b, double *error);
+
+/**
+ * Noyau retenu par la sélection à l'exécution.
+ */
+dot_fn_t simd_dot_select(void);
+
+/**
+ * Nom du noyau retenu (pour l'affichage).
+ */
+const char *simd_dot_name(void);
+
+#endif // SIMD_DOT_H
@@ -0,0 +1,243 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_NEON 1
+#endif
+
+#include "simd_gemm.h"
+#include "simd_dot.h"
+
+// ============================ NOYAU SCALAIRE ====================================
+
+/**
+ * Version portable 4 x 4 : 16 accumulateurs, que le compilateur garde en registres.
+ */
+static void gemm_scalar(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add) {
+    double acc[4][4] = { { 0. } };
+
+    for (size_t p = 0; p < kc; ++p, a += 4, b += 4) {
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t j = 0; j < 4; ++j) {
+                acc[r][j] += a[r] * b[j];
+            }
+        }
+    }
+
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t j = 0; j < 4; ++j) {
+            c[r * ldc + j] = add ? c[r * ldc + j] + acc[r][j] : acc[r][j];
+        }
+    }
+}
+
+// ============================== NOYAUX x86 ======================================
+
+#ifdef SIMD_X86
+
+/**
+ * SSE2 4 x 4 : 8 accumulateurs de 2 doubles (multiplication puis addition, sans FMA).
+ */
+__attribute__((target("sse2")))
+static void gemm_sse2(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add) {
+    __m128d acc[4][2];
+#pragma GCC unroll 4
+    for (size_t r = 0; r < 4; ++r) {
+        acc[r][0] = acc[r][1] = _mm_setzero_pd();
+    }
+
+    for (size_t p = 0; p < kc; ++p, a += 4, b += 4) {
+        __m128d b0 = _mm_loadu_pd(b), b1 = _mm_loadu_pd(b + 2);
+#pragma GCC unroll 4
+        for (size_t r = 0; r < 4; ++r) {
+            __m128d ar = _mm_set1_pd(a[r]);
+            acc[r][0] = _mm_add_pd(acc[r][0], _mm_mul_pd(ar, b0));
+            acc[r][1] = _mm_add_pd(acc[r][1], _mm_mul_pd(ar, b1));
+        }
+    }
+
+#pragma GCC unroll 4
+    for (size_t r = 0; r < 4; ++r) {
+        double *row = c + r * ldc;
+        if (add) {
+            acc[r][0] = _mm_add_pd(acc[r][0], _mm_loadu_pd(row));
+            acc[r][1] = _mm_add_pd(acc[r][1], _mm_loadu_pd(row + 2));
+        }
+        _mm_storeu_pd(row, acc[r][0]);
+        _mm_storeu_pd(row + 2, acc[r][1]);
+    }
+}
+
+/**
+ * AVX2+FMA 6 x 8 : 12 accumulateurs de 4 doubles, 2 lignes de `B` et une diffusion,
+ * soit 15 des 16 registres.
+ */
+__attribute__((target("avx2,fma")))
+static void gemm_avx2(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add) {
+    __m256d acc[6][2];
+#pragma GCC unroll 6
+    for (size_t r = 0; r < 6; ++r) {
+        acc[r][0] = acc[r][1] = _mm256_setzero_pd();
+    }
+
+    for (size_t p = 0; p < kc; ++p, a += 6, b += 8) {
+        __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+#pragma GCC unroll 6
+        for (size_t r = 0; r < 6; ++r) {
+            __m256d ar = _mm256_broadcast_sd(a + r);
+            acc[r][0] = _mm256_fmadd_pd(ar, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_pd(ar, b1, acc[r][1]);
+        }
+    }
+
+#pragma GCC unroll 6
+    for (size_t r = 0; r < 6; ++r) {
+        double *row = c + r * ldc;
+        if (add) {
+            acc[r][0] = _mm256_add_pd(acc[r][0], _mm256_loadu_pd(row));
+            acc[r][1] = _mm256_add_pd(acc[r][1], _mm256_loadu_pd(row + 4));
+        }
+        _mm256_storeu_pd(row, acc[r][0]);
+        _mm256_storeu_pd(row + 4, acc[r][1]);
+    }
+}
+
+/**
+ * AVX-512 8 x 24 : 24 accumulateurs de 8 doubles, 3 lignes de `B` et une diffusion,
+ * soit 28 des 32 registres.
+ */
+__attribute__((target("avx512f")))
+static void gemm_avx512(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add) {
+    __m512d acc[8][3];
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        acc[r][0] = acc[r][1] = acc[r][2] = _mm512_setzero_pd();
+    }
+
+    for (size_t p = 0; p < kc; ++p, a += 8, b += 24) {
+        __m512d b0 = _mm512_loadu_pd(b), b1 = _mm512_loadu_pd(b + 8), b2 = _mm512_loadu_pd(b + 16);
+#pragma GCC unroll 8
+        for (size_t r = 0; r < 8; ++r) {
+            __m512d ar = _mm512_set1_pd(a[r]);
+            acc[r][0] = _mm512_fmadd_pd(ar, b0, acc[r][0]);
+            acc[r][1] = _mm512_fmadd_pd(ar, b1, acc[r][1]);
+            acc[r][2] = _mm512_fmadd_pd(ar, b2, acc[r][2]);
+        }
+    }
+
+#pragma GCC unroll 8
+    for (size_t r = 0; r < 8; ++r) {
+        double *row = c + r * ldc;
+        if (add) {
+            acc[r][0] = _mm512_add_pd(acc[r][0], _mm512_loadu_pd(row));
+            acc[r][1] = _mm512_add_pd(acc[r][1], _mm512_loadu_pd(row + 8));
+            acc[r][2] = _mm512_add_pd(acc[r][2], _mm512_loadu_pd(row + 16));
+        }
+        _mm512_storeu_pd(row, acc[r][0]);
+        _mm512_storeu_pd(row + 8, acc[r][1]);
+        _mm512_storeu_pd(row + 16, acc[r][2]);
+    }
+}
+
+#endif // SIMD_X86
+
+// ============================== NOYAU NEON ======================================
+
+#ifdef SIMD_NEON
+
+/**
+ * NEON 4 x 8 : 16 accumulateurs de 2 doubles et 4 registres pour une ligne de `B`.
+ */
+static void gemm_neon(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add) {
+    float64x2_t acc[4][4];
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t j = 0; j < 4; ++j) {
+            acc[r][j] = vdupq_n_f64(0.);
+        }
+    }
+
+    for (size_t p = 0; p < kc; ++p, a += 4, b += 8) {
+        float64x2_t bv[4] = { vld1q_f64(b), vld1q_f64(b + 2), vld1q_f64(b + 4), vld1q_f64(b + 6) };
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t j = 0; j < 4; ++j) {
+                acc[r][j] = vfmaq_n_f64(acc[r][j], bv[j], a[r]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t j = 0; j < 4; ++j) {
+            double *dst = c + r * ldc + 2 * j;
+            vst1q_f64(dst, add ? vaddq_f64(acc[r][j], vld1q_f64(dst)) : acc[r][j]);
+        }
+    }
+}
+
+#endif // SIMD_NEON
+
+// =============================== RANGEMENT ======================================
+
+void gemm_pack_a(size_t rows, size_t kc, const double *A, size_t lda, size_t mr, double *packed) {
+    for (size_t i0 = 0; i0 < rows; i0 += mr) {
+        size_t h = rows - i0 < mr ? rows - i0 : mr;
+        for (size_t p = 0; p < kc; ++p) {
+            size_t r = 0;
+            for (; r < h; ++r) {
+                packed[r] = A[(i0 + r) * lda + p];
+            }
+            for (; r < mr; ++r) {
+                packed[r] = 0.;
+            }
+            packed += mr;
+        }
+    }
+}
+
+void gemm_pack_b(size_t kc, size_t cols, const double *B, size_t ldb, size_t nr, double *packed) {
+    for (size_t j0 = 0; j0 < cols; j0 += nr) {
+        size_t w = cols - j0 < nr ? cols - j0 : nr;
+        for (size_t p = 0; p < kc; ++p) {
+            memcpy(packed, B + p * ldb + j0, w * sizeof(double));
+            memset(packed + w, 0, (nr - w) * sizeof(double));
+            packed += nr;
+        }
+    }
+}
+
+// ======================= SÉLECTION À L'EXÉCUTION ================================
+
+static gemm_kernel_t selected = { gemm_scalar, 4, 4, "scalar" };
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Même jeu d'instructions que le noyau de produit scalaire retenu.
+ */
+static void select_init(void) {
+    const char *name = simd_dot_name();
+#ifdef SIMD_X86
+    if (strcmp(name, "avx512") == 0) {
+        selected = (gemm_kernel_t){ gemm_avx512, 8, 24, "avx512" };
+    } else if (strcmp(name, "avx2") == 0) {
+        selected = (gemm_kernel_t){ gemm_avx2, 6, 8, "avx2" };
+    } else if (strcmp(name, "sse2") == 0) {
+        selected = (gemm_kernel_t){ gemm_sse2, 4, 4, "sse2" };
+    }
+#endif
+#ifdef SIMD_NEON
+    if (strcmp(name, "neon") == 0) {
+        selected = (gemm_kernel_t){ gemm_neon, 4, 8, "neon" };
+    }
+#endif
+    (void)name;
+}
+
+const gemm_kernel_t *simd_gemm_kernel(void) {
+    pthread_once(&select_once, select_init);
+    return &selected;
+}
@@ -0,0 +1,54 @@
+#ifndef SIMD_GEMM_H
+#define SIMD_GEMM_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ================= MICRO-NOYAU DU PRODUIT MATRICE-MATRICE =======================
+
+// Dimensions maximales d'une tuile de registres (tous noyaux confondus)
+#define GEMM_MR_MAX 8
+#define GEMM_NR_MAX 24
+
+/**
+ * Micro-noyau : produit d'un panneau de `A` (mr x kc) par un panneau de `B` (kc x nr),
+ * tous deux rangés par `gemm_pack_a` / `gemm_pack_b`, dans une tuile mr x nr de `C`
+ * (lignes distantes de `ldc`). Si `add` est vrai le produit est ajouté à `C`, sinon il
+ * la remplace. Toute la tuile reste dans les registres pendant les `kc` étapes : chaque
+ * étape charge une ligne de `B` (nr éléments), diffuse les mr éléments de `A` et fait
+ * mr x nr multiplications-additions, soit bien plus de calcul que d'accès mémoire.
+ */
+typedef void (*gemm_kernel_fn)(size_t kc, const double *a, const double *b, double *c, size_t ldc, bool add);
+
+/**
+ * Micro-noyau retenu et dimensions de sa tuile.
+ */
+typedef struct {
+    gemm_kernel_fn fn;     // Micro-noyau
+    size_t mr;             // Lignes de la tuile (éléments de `A` diffusés par étape)
+    size_t nr;             // Colonnes de la tuile (un multiple de la largeur des vecteurs)
+    const char *name;      // Nom du jeu d'instructions
+} gemm_kernel_t;
+
+/**
+ * Micro-noyau du jeu d'instructions du produit scalaire (`simd_dot_name`, variable
+ * `DOT_KERNEL`) : 8 x 24 en AVX-512, 6 x 8 en AVX2+FMA, 4 x 4 en SSE2, 4 x 8 en NEON,
+ * 4 x 4 en scalaire.
+ */
+const gemm_kernel_t *simd_gemm_kernel(void);
+
+/**
+ * Ranger le bloc `rows` x `kc` de `A` (lignes distantes de `lda`) en panneaux de `mr`
+ * lignes : pour chaque panneau, les `mr` éléments de chaque colonne sont consécutifs.
+ * Le dernier panneau est complété par des zéros.
+ */
+void gemm_pack_a(size_t rows, size_t kc, const double *A, size_t lda, size_t mr, double *packed);
+
+/**
+ * Ranger le bloc `kc` x `cols` de `B` (lignes distantes de `ldb`) en panneaux de `nr`
+ * colonnes : pour chaque panneau, les `nr` éléments de chaque ligne sont consécutifs.
+ * Le dernier panneau est complété par des zéros.
+ */
+void gemm_pack_b(size_t kc, size_t cols, const double *B, size_t ldb, size_t nr, double *packed);
+
+#endif // SIMD_GEMM_H
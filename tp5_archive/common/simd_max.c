@@ -0,0 +1,205 @@
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_NEON 1
+#endif
+
+#include "simd_max.h"
+#include "simd_dot.h"
+
+// Signature d'un noyau de maximum absolu
+typedef double (*absmax_fn_t)(size_t n, const double *a);
+
+// ============================ NOYAU SCALAIRE ====================================
+
+/**
+ * Version portable : quatre maxima indépendants.
+ */
+static double absmax_scalar(size_t n, const double *a) {
+    double m0 = 0., m1 = 0., m2 = 0., m3 = 0.;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        double x0 = fabs(a[i]), x1 = fabs(a[i + 1]);
+        double x2 = fabs(a[i + 2]), x3 = fabs(a[i + 3]);
+        m0 = x0 > m0 ? x0 : m0;
+        m1 = x1 > m1 ? x1 : m1;
+        m2 = x2 > m2 ? x2 : m2;
+        m3 = x3 > m3 ? x3 : m3;
+    }
+    for (; i < n; ++i) {
+        double x = fabs(a[i]);
+        m0 = x > m0 ? x : m0;
+    }
+
+    m0 = m0 > m1 ? m0 : m1;
+    m2 = m2 > m3 ? m2 : m3;
+    return m0 > m2 ? m0 : m2;
+}
+
+// ============================== NOYAUX x86 ======================================
+
+#ifdef SIMD_X86
+
+__attribute__((target("sse2")))
+static double absmax_sse2(size_t n, const double *a) {
+    const __m128d sign = _mm_set1_pd(-0.0);  // Seul le bit de signe est à 1
+    __m128d m0 = _mm_setzero_pd(), m1 = _mm_setzero_pd();
+    __m128d m2 = _mm_setzero_pd(), m3 = _mm_setzero_pd();
+    size_t i = 0;
+
+    // |x| = x privé de son bit de signe (andnot) ; 8 éléments par itération.
+    // `max_pd` rend son second opérande si l'un des deux est NaN : l'accumulateur est
+    // donc placé en second, et un NaN lu est ignoré (même règle que le noyau scalaire)
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm_max_pd(_mm_andnot_pd(sign, _mm_loadu_pd(a + i)), m0);
+        m1 = _mm_max_pd(_mm_andnot_pd(sign, _mm_loadu_pd(a + i + 2)), m1);
+        m2 = _mm_max_pd(_mm_andnot_pd(sign, _mm_loadu_pd(a + i + 4)), m2);
+        m3 = _mm_max_pd(_mm_andnot_pd(sign, _mm_loadu_pd(a + i + 6)), m3);
+    }
+
+    __m128d m = _mm_max_pd(_mm_max_pd(m0, m1), _mm_max_pd(m2, m3));
+    m = _mm_max_sd(m, _mm_unpackhi_pd(m, m));
+    double max = _mm_cvtsd_f64(m);
+    for (; i < n; ++i) {
+        double x = fabs(a[i]);
+        max = x > max ? x : max;
+    }
+
+    return max;
+}
+
+__attribute__((target("avx2")))
+static double absmax_avx2(size_t n, const double *a) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d m0 = _mm256_setzero_pd(), m1 = _mm256_setzero_pd();
+    __m256d m2 = _mm256_setzero_pd(), m3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    // 4 accumulateurs de 4 doubles : 16 éléments par itération (accumulateur en second : NaN ignoré)
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(a + i)), m0);
+        m1 = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(a + i + 4)), m1);
+        m2 = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(a + i + 8)), m2);
+        m3 = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(a + i + 12)), m3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        m0 = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(a + i)), m0);
+    }
+
+    __m256d m = _mm256_max_pd(_mm256_max_pd(m0, m1), _mm256_max_pd(m2, m3));
+    __m128d h = _mm_max_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+    double max = _mm_cvtsd_f64(_mm_max_sd(h, _mm_unpackhi_pd(h, h)));
+    for (; i < n; ++i) {
+        double x = fabs(a[i]);
+        max = x > max ? x : max;
+    }
+
+    return max;
+}
+
+__attribute__((target("avx512f")))
+static double absmax_avx512(size_t n, const double *a) {
+    __m512d m0 = _mm512_setzero_pd(), m1 = _mm512_setzero_pd();
+    __m512d m2 = _mm512_setzero_pd(), m3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    // `_mm512_abs_pd` efface le bit de signe (et logique entier : `andnot_pd` exige AVX-512DQ) ;
+    // accumulateur en second opérande : NaN ignoré
+    for (; i + 32 <= n; i += 32) {
+        m0 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i)), m0);
+        m1 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i + 8)), m1);
+        m2 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i + 16)), m2);
+        m3 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i + 24)), m3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm512_max_pd(_mm512_abs_pd(_mm512_loadu_pd(a + i)), m0);
+    }
+
+    // Reste traité par un chargement masqué (les cases absentes valent 0)
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+        m1 = _mm512_max_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(mask, a + i)), m1);
+    }
+
+    return _mm512_reduce_max_pd(_mm512_max_pd(_mm512_max_pd(m0, m1), _mm512_max_pd(m2, m3)));
+}
+
+#endif // SIMD_X86
+
+// ============================== NOYAU NEON ======================================
+
+#ifdef SIMD_NEON
+
+static double absmax_neon(size_t n, const double *a) {
+    float64x2_t m0 = vdupq_n_f64(0.), m1 = vdupq_n_f64(0.);
+    float64x2_t m2 = vdupq_n_f64(0.), m3 = vdupq_n_f64(0.);
+    size_t i = 0;
+
+    // `vmaxnmq` (maxNum) rend l'opérande qui n'est pas NaN : NaN ignoré
+    for (; i + 8 <= n; i += 8) {
+        m0 = vmaxnmq_f64(m0, vabsq_f64(vld1q_f64(a + i)));
+        m1 = vmaxnmq_f64(m1, vabsq_f64(vld1q_f64(a + i + 2)));
+        m2 = vmaxnmq_f64(m2, vabsq_f64(vld1q_f64(a + i + 4)));
+        m3 = vmaxnmq_f64(m3, vabsq_f64(vld1q_f64(a + i + 6)));
+    }
+
+    double max = vmaxvq_f64(vmaxq_f64(vmaxq_f64(m0, m1), vmaxq_f64(m2, m3)));
+    for (; i < n; ++i) {
+        double x = fabs(a[i]);
+        max = x > max ? x : max;
+    }
+
+    return max;
+}
+
+#endif // SIMD_NEON
+
+// ======================= SÉLECTION À L'EXÉCUTION ================================
+
+static absmax_fn_t selected_fn = absmax_scalar;
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Même jeu d'instructions que le noyau de produit scalaire retenu.
+ */
+static void select_init(void) {
+    const char *name = simd_dot_name();
+#ifdef SIMD_X86
+    if (strcmp(name, "avx512") == 0) {
+        selected_fn = absmax_avx512;
+    } else if (strcmp(name, "avx2") == 0) {
+        selected_fn = absmax_avx2;
+    } else if (strcmp(name, "sse2") == 0) {
+        selected_fn = absmax_sse2;
+    }
+#endif
+#ifdef SIMD_NEON
+    if (strcmp(name, "neon") == 0) {
+        selected_fn = absmax_neon;
+    }
+#endif
+    (void)name;
+}
+
+double simd_absmax(size_t n, const double *a) {
+    pthread_once(&select_once, select_init);
+    return selected_fn(n, a);
+}
+
+double simd_absmax_index(size_t n, const double *a, size_t *index) {
+    double max = simd_absmax(n, a);
+    size_t i = 0;
+    while (i < n && fabs(a[i]) != max) {
+        ++i;
+    }
+    *index = i < n ? i : 0;
+    return max;
+}
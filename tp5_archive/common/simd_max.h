@@ -0,0 +1,25 @@
+#ifndef SIMD_MAX_H
+#define SIMD_MAX_H
+
+#include <stddef.h>
+
+// ===================== MAXIMUM ABSOLU VECTORISÉ =================================
+
+/**
+ * Plus grande valeur absolue de `n` éléments contigus (0 si `n == 0`).
+ * La valeur absolue est obtenue en effaçant le bit de signe (masque), le maximum
+ * par les instructions `max` du jeu retenu, sur plusieurs accumulateurs indépendants.
+ * Le noyau est celui du produit scalaire (`simd_dot_name`, variable `DOT_KERNEL`).
+ * Les NaN sont ignorés, comme par `max_ref` : le maximum ne dépend pas de l'ordre
+ * des comparaisons, et tous les noyaux donnent exactement le même résultat.
+ */
+double simd_absmax(size_t n, const double *a);
+
+/**
+ * Même calcul, en écrivant dans `*index` la position de la première occurrence
+ * du maximum (0 si `n == 0`). Le maximum est d'abord calculé par `simd_absmax`,
+ * puis sa première occurrence recherchée.
+ */
+double simd_absmax_index(size_t n, const double *a, size_t *index);
+
+#endif // SIMD_MAX_H
@@ -0,0 +1,575 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#endif
+
+#include "simd_typed.h"
+#include "simd_dot.h"
+
+// Sous-bloc du produit scalaire 8 bits : au plus 2^14 * 2^16 = 2^30 par case 32 bits
+#define I8_BLOCK 65536
+
+// ============================ CONVERSIONS =======================================
+
+float bf16_to_float(bf16_t x) {
+    uint32_t bits = (uint32_t)x << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+bf16_t float_to_bf16(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        return (bf16_t)((bits >> 16) | 0x40);  // NaN : conserver un NaN silencieux
+    }
+    bits += 0x7fffu + ((bits >> 16) & 1);      // Arrondi au plus proche, pair en cas d'égalité
+    return (bf16_t)(bits >> 16);
+}
+
+float f16_to_float(f16_t x) {
+    uint32_t sign = (uint32_t)(x & 0x8000) << 16;
+    uint32_t exp = (x >> 10) & 0x1f, mant = x & 0x3ff, bits;
+    float f;
+
+    if (exp == 0) {
+        // Zéro ou sous-normal : mant * 2^-24
+        f = (float)mant * 0x1p-24f;
+        memcpy(&bits, &f, sizeof(bits));
+        bits |= sign;
+    } else if (exp == 31) {
+        bits = sign | 0x7f800000u | (mant << 13);  // Infini ou NaN
+    } else {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+f16_t float_to_f16(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000, abs = bits & 0x7fffffffu;
+
+    if (abs >= 0x7f800000u) {
+        return (f16_t)(sign | 0x7c00 | (abs > 0x7f800000u ? 0x200 : 0));  // Infini ou NaN
+    }
+    if (abs >= 0x477ff000u) {
+        return (f16_t)(sign | 0x7c00);  // Au-delà de 65504 (arrondi) : infini
+    }
+    if (abs < 0x38800000u) {
+        // Sous-normal en demi-précision (|x| < 2^-14) : unités de 2^-24
+        if (abs < 0x33000000u) {
+            return (f16_t)sign;
+        }
+        uint32_t shift = 126 - (abs >> 23), mant = (abs & 0x7fffffu) | 0x800000u;
+        uint32_t r = mant >> shift, rem = mant & ((1u << shift) - 1), half = 1u << (shift - 1);
+        r += rem > half || (rem == half && (r & 1));
+        return (f16_t)(sign | r);
+    }
+
+    // Normal : exposant rebiaisé de 127 à 15, mantisse arrondie de 23 à 10 bits
+    uint32_t r = (abs - 0x38000000u) >> 13, rem = abs & 0x1fff;
+    r += rem > 0x1000 || (rem == 0x1000 && (r & 1));
+    return (f16_t)(sign | r);
+}
+
+// ============================ NOYAUX SCALAIRES ==================================
+
+/**
+ * Produit scalaire portable : quatre accumulateurs de type ACC_T, éléments convertis
+ * par TO_ACC. Une instance par type d'élément.
+ */
+#define DEFINE_DOT_SCALAR(SUFFIX, ELEM_T, ACC_T, TO_ACC)                           \
+    static ACC_T dot_##SUFFIX##_scalar(size_t n, const ELEM_T *a, const ELEM_T *b) { \
+        ACC_T s0 = 0, s1 = 0, s2 = 0, s3 = 0;                                      \
+        size_t i = 0;                                                              \
+        for (; i + 4 <= n; i += 4) {                                               \
+            s0 += TO_ACC(a[i]) * TO_ACC(b[i]);                                     \
+            s1 += TO_ACC(a[i + 1]) * TO_ACC(b[i + 1]);                             \
+            s2 += TO_ACC(a[i + 2]) * TO_ACC(b[i + 2]);                             \
+            s3 += TO_ACC(a[i + 3]) * TO_ACC(b[i + 3]);                             \
+        }                                                                          \
+        for (; i < n; ++i) {                                                       \
+            s0 += TO_ACC(a[i]) * TO_ACC(b[i]);                                     \
+        }                                                                          \
+        return (s0 + s1) + (s2 + s3);                                              \
+    }
+
+/**
+ * Maximum portable d'une clé entière KEY(x) (valeur absolue ou bits privés du signe).
+ * Les clés supérieures à `limit` (celle de l'infini : NaN) sont ignorées.
+ */
+#define DEFINE_KEYMAX_SCALAR(SUFFIX, ELEM_T, KEY_T, KEY)                           \
+    static KEY_T keymax_##SUFFIX##_scalar(size_t n, const ELEM_T *a, KEY_T limit) { \
+        KEY_T m0 = 0, m1 = 0;                                                      \
+        size_t i = 0;                                                              \
+        for (; i + 2 <= n; i += 2) {                                               \
+            KEY_T k0 = KEY(a[i]), k1 = KEY(a[i + 1]);                              \
+            m0 = k0 > m0 && k0 <= limit ? k0 : m0;                                 \
+            m1 = k1 > m1 && k1 <= limit ? k1 : m1;                                 \
+        }                                                                          \
+        if (i < n && KEY(a[i]) > m0 && KEY(a[i]) <= limit) {                       \
+            m0 = KEY(a[i]);                                                        \
+        }                                                                          \
+        return m0 > m1 ? m0 : m1;                                                  \
+    }
+
+static inline uint32_t f32_key(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits & 0x7fffffffu;
+}
+
+#define TO_DOUBLE(x) ((double)(x))
+#define TO_INT32(x) ((int32_t)(x))
+#define KEY_16(x) ((uint16_t)((x) & 0x7fff))
+#define KEY_I8(x) ((uint8_t)((x) < 0 ? -(x) : (x)))
+
+// Clés de l'infini (bits privés du signe) : toute clé supérieure est un NaN
+#define F32_INF_KEY 0x7f800000u
+#define BF16_INF_KEY 0x7f80u
+#define F16_INF_KEY 0x7c00u
+
+DEFINE_DOT_SCALAR(f32, float, double, TO_DOUBLE)
+DEFINE_DOT_SCALAR(bf16, bf16_t, float, bf16_to_float)
+DEFINE_DOT_SCALAR(f16, f16_t, float, f16_to_float)
+DEFINE_DOT_SCALAR(i8, int8_t, int32_t, TO_INT32)
+
+DEFINE_KEYMAX_SCALAR(f32, float, uint32_t, f32_key)
+DEFINE_KEYMAX_SCALAR(16, uint16_t, uint16_t, KEY_16)
+DEFINE_KEYMAX_SCALAR(i8, int8_t, uint8_t, KEY_I8)
+
+// ============================== NOYAUX x86 ======================================
+
+#ifdef SIMD_X86
+
+// ----- AVX2 (et F16C pour la demi-précision) -----
+
+__attribute__((target("avx2,fma")))
+static double hsum_pd256(__m256d s) {
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+__attribute__((target("avx2,fma")))
+static float hsum_ps256(__m256 s) {
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    return _mm_cvtss_f32(_mm_add_ss(h, _mm_movehdup_ps(h)));
+}
+
+/**
+ * float32, accumulateur double : chaque moitié de 4 floats est convertie en 4 doubles.
+ */
+__attribute__((target("avx2,fma")))
+static double dot_f32_avx2(size_t n, const float *a, const float *b) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + i)), _mm256_cvtps_pd(_mm_loadu_ps(b + i)), s0);
+        s1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 4)), _mm256_cvtps_pd(_mm_loadu_ps(b + i + 4)), s1);
+        s2 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 8)), _mm256_cvtps_pd(_mm_loadu_ps(b + i + 8)), s2);
+        s3 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + i + 12)), _mm256_cvtps_pd(_mm_loadu_ps(b + i + 12)), s3);
+    }
+
+    double sum = hsum_pd256(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    return sum + dot_f32_scalar(n - i, a + i, b + i);
+}
+
+/**
+ * bf16, accumulateur float : 8 éléments étendus sur 32 bits puis décalés de 16 bits.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256 load_bf16_avx2(const bf16_t *p) {
+    __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(x, 16));
+}
+
+__attribute__((target("avx2,fma")))
+static float dot_bf16_avx2(size_t n, const bf16_t *a, const bf16_t *b) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm256_fmadd_ps(load_bf16_avx2(a + i), load_bf16_avx2(b + i), s0);
+        s1 = _mm256_fmadd_ps(load_bf16_avx2(a + i + 8), load_bf16_avx2(b + i + 8), s1);
+        s2 = _mm256_fmadd_ps(load_bf16_avx2(a + i + 16), load_bf16_avx2(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(load_bf16_avx2(a + i + 24), load_bf16_avx2(b + i + 24), s3);
+    }
+
+    float sum = hsum_ps256(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+    return sum + dot_bf16_scalar(n - i, a + i, b + i);
+}
+
+/**
+ * f16, accumulateur float : conversion matérielle par F16C.
+ */
+__attribute__((target("avx2,fma,f16c")))
+static float dot_f16_avx2(size_t n, const f16_t *a, const f16_t *b) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+#define LOAD_F16(p) _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(p)))
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm256_fmadd_ps(LOAD_F16(a + i), LOAD_F16(b + i), s0);
+        s1 = _mm256_fmadd_ps(LOAD_F16(a + i + 8), LOAD_F16(b + i + 8), s1);
+        s2 = _mm256_fmadd_ps(LOAD_F16(a + i + 16), LOAD_F16(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(LOAD_F16(a + i + 24), LOAD_F16(b + i + 24), s3);
+    }
+#undef LOAD_F16
+
+    float sum = hsum_ps256(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+    return sum + dot_f16_scalar(n - i, a + i, b + i);
+}
+
+/**
+ * int8, accumulateur int32 : extension sur 16 bits puis `madd` (deux produits par case).
+ */
+__attribute__((target("avx2")))
+static int32_t dot_i8_avx2(size_t n, const int8_t *a, const int8_t *b) {
+    __m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i x0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a + i)));
+        __m256i y0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + i)));
+        __m256i x1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a + i + 16)));
+        __m256i y1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + i + 16)));
+        s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(x0, y0));
+        s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(x1, y1));
+    }
+
+    __m256i s = _mm256_add_epi32(s0, s1);
+    __m128i h = _mm_add_epi32(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+    h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(h) + dot_i8_scalar(n - i, a + i, b + i);
+}
+
+/**
+ * Maxima des clés : bits privés du signe (flottants) ou valeur absolue (int8),
+ * sans les clés supérieures à `limit`.
+ */
+__attribute__((target("avx2")))
+static uint32_t keymax_f32_avx2(size_t n, const float *a, uint32_t limit) {
+    const __m256i mask = _mm256_set1_epi32(0x7fffffff);
+    __m256i m0 = _mm256_setzero_si256(), m1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // Clés NaN (au-dessus de l'infini) remises à 0 : comparaison signée, les clés sont < 2^31
+    const __m256i inf = _mm256_set1_epi32((int)limit);
+    for (; i + 16 <= n; i += 16) {
+        __m256i k0 = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(a + i)));
+        __m256i k1 = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(a + i + 8)));
+        m0 = _mm256_max_epi32(m0, _mm256_andnot_si256(_mm256_cmpgt_epi32(k0, inf), k0));
+        m1 = _mm256_max_epi32(m1, _mm256_andnot_si256(_mm256_cmpgt_epi32(k1, inf), k1));
+    }
+
+    uint32_t lanes[8], max = keymax_f32_scalar(n - i, a + i, limit);
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_max_epi32(m0, m1));
+    for (size_t l = 0; l < 8; ++l) {
+        max = lanes[l] > max ? lanes[l] : max;
+    }
+    return max;
+}
+
+__attribute__((target("avx2")))
+static uint16_t keymax_16_avx2(size_t n, const uint16_t *a, uint16_t limit) {
+    const __m256i mask = _mm256_set1_epi16(0x7fff);
+    __m256i m0 = _mm256_setzero_si256(), m1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // Clés NaN remises à 0 : comparaison signée, les clés sont < 2^15
+    const __m256i inf = _mm256_set1_epi16((short)limit);
+    for (; i + 32 <= n; i += 32) {
+        __m256i k0 = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(a + i)));
+        __m256i k1 = _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i *)(a + i + 16)));
+        m0 = _mm256_max_epu16(m0, _mm256_andnot_si256(_mm256_cmpgt_epi16(k0, inf), k0));
+        m1 = _mm256_max_epu16(m1, _mm256_andnot_si256(_mm256_cmpgt_epi16(k1, inf), k1));
+    }
+
+    uint16_t lanes[16], max = keymax_16_scalar(n - i, a + i, limit);
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_max_epu16(m0, m1));
+    for (size_t l = 0; l < 16; ++l) {
+        max = lanes[l] > max ? lanes[l] : max;
+    }
+    return max;
+}
+
+__attribute__((target("avx2")))
+static uint8_t keymax_i8_avx2(size_t n, const int8_t *a, uint8_t limit) {
+    __m256i m0 = _mm256_setzero_si256(), m1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // |-128| = 0x80 : correct une fois lu comme un octet non signé
+    for (; i + 64 <= n; i += 64) {
+        m0 = _mm256_max_epu8(m0, _mm256_abs_epi8(_mm256_loadu_si256((const __m256i *)(a + i))));
+        m1 = _mm256_max_epu8(m1, _mm256_abs_epi8(_mm256_loadu_si256((const __m256i *)(a + i + 32))));
+    }
+
+    uint8_t lanes[32], max = keymax_i8_scalar(n - i, a + i, limit);
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_max_epu8(m0, m1));
+    for (size_t l = 0; l < 32; ++l) {
+        max = lanes[l] > max ? lanes[l] : max;
+    }
+    return max;
+}
+
+// ----- AVX-512 (BW pour les entiers 8 et 16 bits) -----
+
+__attribute__((target("avx512f")))
+static double dot_f32_avx512(size_t n, const float *a, const float *b) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a + i)), _mm512_cvtps_pd(_mm256_loadu_ps(b + i)), s0);
+        s1 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a + i + 8)), _mm512_cvtps_pd(_mm256_loadu_ps(b + i + 8)), s1);
+        s2 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a + i + 16)), _mm512_cvtps_pd(_mm256_loadu_ps(b + i + 16)), s2);
+        s3 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a + i + 24)), _mm512_cvtps_pd(_mm256_loadu_ps(b + i + 24)), s3);
+    }
+
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+    return sum + dot_f32_scalar(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 load_bf16_avx512(const bf16_t *p) {
+    __m512i x = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)p));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(x, 16));
+}
+
+__attribute__((target("avx512f")))
+static float dot_bf16_avx512(size_t n, const bf16_t *a, const bf16_t *b) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        s0 = _mm512_fmadd_ps(load_bf16_avx512(a + i), load_bf16_avx512(b + i), s0);
+        s1 = _mm512_fmadd_ps(load_bf16_avx512(a + i + 16), load_bf16_avx512(b + i + 16), s1);
+        s2 = _mm512_fmadd_ps(load_bf16_avx512(a + i + 32), load_bf16_avx512(b + i + 32), s2);
+        s3 = _mm512_fmadd_ps(load_bf16_avx512(a + i + 48), load_bf16_avx512(b + i + 48), s3);
+    }
+
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+    return sum + dot_bf16_scalar(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx512f")))
+static float dot_f16_avx512(size_t n, const f16_t *a, const f16_t *b) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+
+#define LOAD_F16(p) _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(p)))
+    for (; i + 64 <= n; i += 64) {
+        s0 = _mm512_fmadd_ps(LOAD_F16(a + i), LOAD_F16(b + i), s0);
+        s1 = _mm512_fmadd_ps(LOAD_F16(a + i + 16), LOAD_F16(b + i + 16), s1);
+        s2 = _mm512_fmadd_ps(LOAD_F16(a + i + 32), LOAD_F16(b + i + 32), s2);
+        s3 = _mm512_fmadd_ps(LOAD_F16(a + i + 48), LOAD_F16(b + i + 48), s3);
+    }
+#undef LOAD_F16
+
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+    return sum + dot_f16_scalar(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static int32_t dot_i8_avx512(size_t n, const int8_t *a, const int8_t *b) {
+    __m512i s0 = _mm512_setzero_si512(), s1 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        __m512i x0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(a + i)));
+        __m512i y0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(b + i)));
+        __m512i x1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(a + i + 32)));
+        __m512i y1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(b + i + 32)));
+        s0 = _mm512_add_epi32(s0, _mm512_madd_epi16(x0, y0));
+        s1 = _mm512_add_epi32(s1, _mm512_madd_epi16(x1, y1));
+    }
+
+    return _mm512_reduce_add_epi32(_mm512_add_epi32(s0, s1)) + dot_i8_scalar(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx512f")))
+static uint32_t keymax_f32_avx512(size_t n, const float *a, uint32_t limit) {
+    const __m512i mask = _mm512_set1_epi32(0x7fffffff);
+    __m512i m0 = _mm512_setzero_si512(), m1 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    // Seules les clés qui ne dépassent pas `limit` (pas de NaN) entrent dans le maximum
+    const __m512i inf = _mm512_set1_epi32((int)limit);
+    for (; i + 32 <= n; i += 32) {
+        __m512i k0 = _mm512_and_si512(mask, _mm512_loadu_si512(a + i));
+        __m512i k1 = _mm512_and_si512(mask, _mm512_loadu_si512(a + i + 16));
+        m0 = _mm512_mask_max_epi32(m0, _mm512_cmple_epi32_mask(k0, inf), m0, k0);
+        m1 = _mm512_mask_max_epi32(m1, _mm512_cmple_epi32_mask(k1, inf), m1, k1);
+    }
+
+    uint32_t max = (uint32_t)_mm512_reduce_max_epi32(_mm512_max_epi32(m0, m1));
+    uint32_t rest = keymax_f32_scalar(n - i, a + i, limit);
+    return rest > max ? rest : max;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static uint16_t keymax_16_avx512(size_t n, const uint16_t *a, uint16_t limit) {
+    const __m512i mask = _mm512_set1_epi16(0x7fff);
+    __m512i m0 = _mm512_setzero_si512(), m1 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    // Seules les clés qui ne dépassent pas `limit` (pas de NaN) entrent dans le maximum
+    const __m512i inf = _mm512_set1_epi16((short)limit);
+    for (; i + 64 <= n; i += 64) {
+        __m512i k0 = _mm512_and_si512(mask, _mm512_loadu_si512(a + i));
+        __m512i k1 = _mm512_and_si512(mask, _mm512_loadu_si512(a + i + 32));
+        m0 = _mm512_mask_max_epu16(m0, _mm512_cmple_epu16_mask(k0, inf), m0, k0);
+        m1 = _mm512_mask_max_epu16(m1, _mm512_cmple_epu16_mask(k1, inf), m1, k1);
+    }
+
+    uint16_t lanes[32], max = keymax_16_scalar(n - i, a + i, limit);
+    _mm512_storeu_si512(lanes, _mm512_max_epu16(m0, m1));
+    for (size_t l = 0; l < 32; ++l) {
+        max = lanes[l] > max ? lanes[l] : max;
+    }
+    return max;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static uint8_t keymax_i8_avx512(size_t n, const int8_t *a, uint8_t limit) {
+    __m512i m0 = _mm512_setzero_si512(), m1 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 128 <= n; i += 128) {
+        m0 = _mm512_max_epu8(m0, _mm512_abs_epi8(_mm512_loadu_si512(a + i)));
+        m1 = _mm512_max_epu8(m1, _mm512_abs_epi8(_mm512_loadu_si512(a + i + 64)));
+    }
+
+    uint8_t lanes[64], max = keymax_i8_scalar(n - i, a + i, limit);
+    _mm512_storeu_si512(lanes, _mm512_max_epu8(m0, m1));
+    for (size_t l = 0; l < 64; ++l) {
+        max = lanes[l] > max ? lanes[l] : max;
+    }
+    return max;
+}
+
+#endif // SIMD_X86
+
+// ======================= SÉLECTION À L'EXÉCUTION ================================
+
+/**
+ * Noyaux retenus pour chaque type (versions portables par défaut).
+ */
+static struct {
+    double (*dot_f32)(size_t, const float *, const float *);
+    float (*dot_bf16)(size_t, const bf16_t *, const bf16_t *);
+    float (*dot_f16)(size_t, const f16_t *, const f16_t *);
+    int32_t (*dot_i8)(size_t, const int8_t *, const int8_t *);   // Sous-bloc d'au plus I8_BLOCK éléments
+    uint32_t (*keymax_f32)(size_t, const float *, uint32_t);
+    uint16_t (*keymax_16)(size_t, const uint16_t *, uint16_t);
+    uint8_t (*keymax_i8)(size_t, const int8_t *, uint8_t);
+} kernels = {
+    dot_f32_scalar, dot_bf16_scalar, dot_f16_scalar, dot_i8_scalar,
+    keymax_f32_scalar, keymax_16_scalar, keymax_i8_scalar
+};
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Même jeu d'instructions que le noyau de produit scalaire en double ; les noyaux
+ * entiers AVX-512 exigent en plus AVX-512BW (noyaux AVX2 à défaut).
+ */
+static void select_init(void) {
+#ifdef SIMD_X86
+    const char *name = simd_dot_name();
+    __builtin_cpu_init();
+    bool avx512 = strcmp(name, "avx512") == 0;
+    bool avx2 = (avx512 || strcmp(name, "avx2") == 0) && __builtin_cpu_supports("avx2") &&
+                __builtin_cpu_supports("fma");
+
+    if (avx2) {
+        kernels.dot_f32 = dot_f32_avx2;
+        kernels.dot_bf16 = dot_bf16_avx2;
+        if (__builtin_cpu_supports("f16c")) {
+            kernels.dot_f16 = dot_f16_avx2;
+        }
+        kernels.dot_i8 = dot_i8_avx2;
+        kernels.keymax_f32 = keymax_f32_avx2;
+        kernels.keymax_16 = keymax_16_avx2;
+        kernels.keymax_i8 = keymax_i8_avx2;
+    }
+    if (avx512) {
+        kernels.dot_f32 = dot_f32_avx512;
+        kernels.dot_bf16 = dot_bf16_avx512;
+        kernels.dot_f16 = dot_f16_avx512;
+        kernels.keymax_f32 = keymax_f32_avx512;
+        if (__builtin_cpu_supports("avx512bw")) {
+            kernels.dot_i8 = dot_i8_avx512;
+            kernels.keymax_16 = keymax_16_avx512;
+            kernels.keymax_i8 = keymax_i8_avx512;
+        }
+    }
+#endif
+}
+
+// ============================ POINTS D'ENTRÉE ===================================
+
+double simd_dot_f32(size_t n, const float *a, const float *b) {
+    pthread_once(&select_once, select_init);
+    return kernels.dot_f32(n, a, b);
+}
+
+float simd_dot_bf16(size_t n, const bf16_t *a, const bf16_t *b) {
+    pthread_once(&select_once, select_init);
+    return kernels.dot_bf16(n, a, b);
+}
+
+float simd_dot_f16(size_t n, const f16_t *a, const f16_t *b) {
+    pthread_once(&select_once, select_init);
+    return kernels.dot_f16(n, a, b);
+}
+
+int64_t simd_dot_i8(size_t n, const int8_t *a, const int8_t *b) {
+    pthread_once(&select_once, select_init);
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i += I8_BLOCK) {
+        size_t len = n - i < I8_BLOCK ? n - i : I8_BLOCK;
+        sum += kernels.dot_i8(len, a + i, b + i);
+    }
+    return sum;
+}
+
+double simd_absmax_f32(size_t n, const float *a) {
+    pthread_once(&select_once, select_init);
+    uint32_t key = kernels.keymax_f32(n, a, F32_INF_KEY);
+    float f;
+    memcpy(&f, &key, sizeof(f));
+    return f;
+}
+
+double simd_absmax_bf16(size_t n, const bf16_t *a) {
+    pthread_once(&select_once, select_init);
+    return bf16_to_float(kernels.keymax_16(n, a, BF16_INF_KEY));
+}
+
+double simd_absmax_f16(size_t n, const f16_t *a) {
+    pthread_once(&select_once, select_init);
+    return f16_to_float(kernels.keymax_16(n, a, F16_INF_KEY));
+}
+
+int64_t simd_absmax_i8(size_t n, const int8_t *a) {
+    pthread_once(&select_once, select_init);
+    return kernels.keymax_i8(n, a, UINT8_MAX);
+}
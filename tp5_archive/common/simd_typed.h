@@ -0,0 +1,68 @@
+#ifndef SIMD_TYPED_H
+#define SIMD_TYPED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ===================== TYPES D'ÉLÉMENTS RÉDUITS =================================
+
+/**
+ * Formats 16 bits, stockés comme des entiers non signés (bits IEEE) :
+ *  - bf16 : 1 bit de signe, 8 bits d'exposant, 7 bits de mantisse (float32 tronqué) ;
+ *  - f16  : demi-précision IEEE (1, 5, 10).
+ */
+typedef uint16_t bf16_t;
+typedef uint16_t f16_t;
+
+/**
+ * Table des variantes : suffixe, type d'élément, type du produit scalaire d'un bloc
+ * (accumulateur des noyaux), type du résultat combiné entre blocs. Les variantes typées
+ * des noyaux parallèles sont générées à partir de cette table (voir `dotprod_typed.c`,
+ * `norms_typed.c`). Les produits de deux éléments sont exacts dans l'accumulateur ;
+ * l'entier 8 bits accumule sur 32 bits par sous-blocs, sans débordement, puis sur 64 bits :
+ * son résultat est exact.
+ */
+#define SIMD_ELEM_TYPES(X)                   \
+    X(f32,  float,  double,  double)         \
+    X(bf16, bf16_t, float,   double)         \
+    X(f16,  f16_t,  float,   double)         \
+    X(i8,   int8_t, int64_t, int64_t)
+
+// ============================ CONVERSIONS =======================================
+
+/**
+ * Conversions entre float32 et les formats 16 bits (arrondi au plus proche, pair en cas
+ * d'égalité ; les valeurs trop grandes deviennent infinies).
+ */
+float bf16_to_float(bf16_t x);
+bf16_t float_to_bf16(float x);
+float f16_to_float(f16_t x);
+f16_t float_to_f16(float x);
+
+// ===================== NOYAUX TYPÉS (UN SEUL THREAD) ============================
+
+/**
+ * Produit scalaire de `n` éléments contigus, accumulé dans le type indiqué par
+ * `SIMD_ELEM_TYPES`. Le noyau suit le jeu d'instructions du produit scalaire en double
+ * (`simd_dot_name`, variable `DOT_KERNEL`) : AVX2 (et F16C) ou AVX-512 ; la version
+ * portable est utilisée sinon. Les éléments sont convertis dans les registres, la mémoire
+ * n'est lue qu'une fois dans leur format d'origine.
+ */
+double simd_dot_f32(size_t n, const float *a, const float *b);
+float simd_dot_bf16(size_t n, const bf16_t *a, const bf16_t *b);
+float simd_dot_f16(size_t n, const f16_t *a, const f16_t *b);
+int64_t simd_dot_i8(size_t n, const int8_t *a, const int8_t *b);
+
+/**
+ * Plus grande valeur absolue de `n` éléments contigus (0 si `n == 0`), dans le type du
+ * résultat combiné. Pour les formats flottants, le maximum est cherché sur les bits privés
+ * du signe, comparés comme des entiers : même ordre que les valeurs absolues pour des
+ * données finies, et aucune conversion dans la boucle. Les NaN (bits au-dessus de ceux
+ * de l'infini) sont ignorés, comme par `simd_absmax`.
+ */
+double simd_absmax_f32(size_t n, const float *a);
+double simd_absmax_bf16(size_t n, const bf16_t *a);
+double simd_absmax_f16(size_t n, const f16_t *a);
+int64_t simd_absmax_i8(size_t n, const int8_t *a);
+
+#endif // SIMD_TYPED_H
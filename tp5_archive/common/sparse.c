@@ -0,0 +1,78 @@
+#include <stddef.h>
+
+#include "alloc.h"
+#include "sparse.h"
+
+// ============================== CONVERSIONS =====================================
+
+sparse_vec_t sparse_vec_from_dense(size_t n, const double *a) {
+    size_t nnz = 0;
+    for (size_t i = 0; i < n; ++i) {
+        nnz += a[i] != 0.0;
+    }
+
+    sparse_vec_t v = { n, nnz, alloc_array(nnz, sizeof(size_t)), alloc_array(nnz, sizeof(double)) };
+    for (size_t i = 0, k = 0; i < n; ++i) {
+        if (a[i] != 0.0) {
+            v.index[k] = i;
+            v.value[k++] = a[i];
+        }
+    }
+    return v;
+}
+
+void sparse_vec_free(sparse_vec_t *v) {
+    alloc_free(v->index);
+    alloc_free(v->value);
+    v->index = NULL;
+    v->value = NULL;
+    v->nnz = 0;
+}
+
+csr_t csr_from_dense(size_t m, size_t n, const double *A) {
+    size_t nnz = 0;
+    for (size_t i = 0; i < m * n; ++i) {
+        nnz += A[i] != 0.0;
+    }
+
+    csr_t S = { m, n, nnz, alloc_array(m + 1, sizeof(size_t)), alloc_array(nnz, sizeof(size_t)),
+                alloc_array(nnz, sizeof(double)) };
+    size_t k = 0;
+    for (size_t i = 0; i < m; ++i) {
+        S.row_ptr[i] = k;
+        for (size_t j = 0; j < n; ++j) {
+            if (A[i * n + j] != 0.0) {
+                S.col[k] = j;
+                S.value[k++] = A[i * n + j];
+            }
+        }
+    }
+    S.row_ptr[m] = k;
+    return S;
+}
+
+void csr_free(csr_t *A) {
+    alloc_free(A->row_ptr);
+    alloc_free(A->col);
+    alloc_free(A->value);
+    A->row_ptr = NULL;
+    A->col = NULL;
+    A->value = NULL;
+    A->nnz = 0;
+}
+
+// ============================== RECHERCHE =======================================
+
+size_t csr_row_of(const csr_t *A, size_t k) {
+    // Dernière ligne i telle que row_ptr[i] <= k
+    size_t lo = 0, hi = A->m;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (A->row_ptr[mid] <= k) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
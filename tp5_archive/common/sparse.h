@@ -0,0 +1,60 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <stddef.h>
+
+// ====================== VECTEURS ET MATRICES CREUX ==============================
+
+/**
+ * Vecteur creux de dimension `n` : seuls les `nnz` éléments non nuls sont stockés,
+ * par indices strictement croissants.
+ */
+typedef struct {
+    size_t n;              // Dimension du vecteur
+    size_t nnz;            // Nombre d'éléments stockés
+    size_t *index;         // Indices des éléments, croissants (nnz cases)
+    double *value;         // Valeurs des éléments (nnz cases)
+} sparse_vec_t;
+
+/**
+ * Matrice creuse m x n au format CSR (lignes compressées) : les éléments de la ligne i
+ * occupent les cases [row_ptr[i], row_ptr[i + 1]) de `col` et `value`, par colonnes
+ * croissantes.
+ */
+typedef struct {
+    size_t m;              // Nombre de lignes
+    size_t n;              // Nombre de colonnes
+    size_t nnz;            // Nombre d'éléments stockés
+    size_t *row_ptr;       // Début de chaque ligne (m + 1 cases, row_ptr[m] == nnz)
+    size_t *col;           // Colonnes des éléments (nnz cases)
+    double *value;         // Valeurs des éléments (nnz cases)
+} csr_t;
+
+/**
+ * Vecteur creux des éléments non nuls de `a` (n éléments). À libérer par `sparse_vec_free`.
+ */
+sparse_vec_t sparse_vec_from_dense(size_t n, const double *a);
+
+/**
+ * Libérer les tableaux d'un vecteur creux.
+ */
+void sparse_vec_free(sparse_vec_t *v);
+
+/**
+ * Matrice CSR des éléments non nuls de `A` (m x n, stockée par lignes). À libérer par `csr_free`.
+ */
+csr_t csr_from_dense(size_t m, size_t n, const double *A);
+
+/**
+ * Libérer les tableaux d'une matrice CSR.
+ */
+void csr_free(csr_t *A);
+
+/**
+ * Ligne contenant l'élément stocké `k` (k < nnz) : recherche dichotomique dans `row_ptr`,
+ * les lignes vides sont sautées. Sert à découper le travail par nombre d'éléments
+ * stockés plutôt que par ligne.
+ */
+size_t csr_row_of(const csr_t *A, size_t k);
+
+#endif // SPARSE_H
@@ -0,0 +1,144 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "spin_wait.h"
+
+// ============================== FUTEX ===========================================
+
+/**
+ * S'endormir tant que `*word` vaut `value` (le noyau vérifie la valeur de façon
+ * atomique avant d'endormir le thread). Les réveils intempestifs sont permis :
+ * l'appelant revérifie sa condition. Hors Linux, simple passage de tour.
+ */
+static void futex_wait(atomic_uint *word, unsigned value) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned *)word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    sched_yield();
+#endif
+}
+
+/**
+ * Réveiller au plus `count` threads endormis sur `word`.
+ */
+static void futex_wake(atomic_uint *word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned *)word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+unsigned spin_budget_env(const char *name, unsigned def) {
+    const char *env = getenv(name);
+    if (!env || !*env) {
+        return def;
+    }
+    return (unsigned)strtoul(env, NULL, 10);
+}
+
+// ============================== ÉVÉNEMENT =======================================
+
+void spin_event_init(spin_event_t *event, unsigned value) {
+    atomic_init(&event->word, value);
+    atomic_init(&event->sleepers, 0);
+}
+
+unsigned spin_event_wait(spin_event_t *event, unsigned seen, unsigned spins) {
+    unsigned value;
+    for (unsigned i = 0; i < spins; ++i) {
+        value = atomic_load_explicit(&event->word, memory_order_acquire);
+        if (value != seen) {
+            return value;
+        }
+        spin_pause();
+    }
+
+    // Le compteur est incrémenté avant de relire le mot : soit `spin_event_set` voit
+    // un thread endormi et le réveille, soit le futex voit la nouvelle valeur
+    atomic_fetch_add(&event->sleepers, 1);
+    while ((value = atomic_load(&event->word)) == seen) {
+        futex_wait(&event->word, seen);
+    }
+    atomic_fetch_sub_explicit(&event->sleepers, 1, memory_order_relaxed);
+    return value;
+}
+
+void spin_event_set(spin_event_t *event, unsigned value) {
+    atomic_store(&event->word, value);
+    if (atomic_load(&event->sleepers) > 0) {
+        futex_wake(&event->word, INT_MAX);
+    }
+}
+
+// ============================== BARRIÈRE ========================================
+
+void spin_barrier_init(spin_barrier_t *barrier, unsigned parties) {
+    atomic_init(&barrier->remaining, parties);
+    barrier->parties = parties;
+    spin_event_init(&barrier->sense, 0);
+}
+
+unsigned spin_barrier_arrive(spin_barrier_t *barrier) {
+    // Le sens est lu avant l'arrivée : il ne peut changer qu'après celle-ci
+    unsigned sense = atomic_load_explicit(&barrier->sense.word, memory_order_relaxed);
+    if (atomic_fetch_sub_explicit(&barrier->remaining, 1, memory_order_acq_rel) == 1) {
+        atomic_store_explicit(&barrier->remaining, barrier->parties, memory_order_relaxed);
+        spin_event_set(&barrier->sense, sense ^ 1u);
+    }
+    return sense;
+}
+
+void spin_barrier_await(spin_barrier_t *barrier, unsigned sense, unsigned spins) {
+    spin_event_wait(&barrier->sense, sense, spins);
+}
+
+void spin_barrier_wait(spin_barrier_t *barrier, unsigned spins) {
+    spin_barrier_await(barrier, spin_barrier_arrive(barrier), spins);
+}
+
+// ================================ MUTEX =========================================
+
+void spin_mutex_init(spin_mutex_t *mutex) {
+    atomic_init(&mutex->state, 0);
+}
+
+void spin_mutex_lock(spin_mutex_t *mutex, unsigned spins) {
+    unsigned expected = 0;
+    for (unsigned i = 0; i < spins; ++i) {
+        if (atomic_load_explicit(&mutex->state, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_weak_explicit(&mutex->state, &expected, 1, memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            return;
+        }
+        expected = 0;
+        spin_pause();
+    }
+
+    // Passage à l'état 2 : le thread qui libère le mutex saura qu'il faut réveiller
+    if (atomic_compare_exchange_strong_explicit(&mutex->state, &expected, 1, memory_order_acquire,
+                                                memory_order_relaxed)) {
+        return;
+    }
+    while (atomic_exchange_explicit(&mutex->state, 2, memory_order_acquire) != 0) {
+        futex_wait(&mutex->state, 2);
+    }
+}
+
+void spin_mutex_unlock(spin_mutex_t *mutex) {
+    if (atomic_exchange_explicit(&mutex->state, 0, memory_order_release) == 2) {
+        futex_wake(&mutex->state, 1);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef SPIN_WAIT_H
+#define SPIN_WAIT_H
+
+#include <stdatomic.h>
+
+#include "reduce.h"
+
+// ================= ATTENTE ACTIVE PUIS MISE EN SOMMEIL ==========================
+
+/**
+ * Primitives de synchronisation du pool de threads : chaque attente commence par
+ * `spins` tours de boucle active (instruction `pause`), pour répondre en quelques
+ * centaines de nanosecondes lorsque l'événement arrive vite, puis s'endort dans le
+ * noyau (futex sous Linux, `sched_yield` en boucle ailleurs). Un budget nul endort
+ * aussitôt : c'est le bon choix lorsque les threads sont plus nombreux que les cœurs,
+ * car un thread qui tourne prend alors le cœur de celui qu'il attend. Le réveil ne
+ * fait d'appel système que si un thread dort.
+ */
+
+// Budget par défaut, en tours de boucle active (quelques microsecondes)
+#define SPIN_DEFAULT 4096
+
+/**
+ * Événement : un mot de 32 bits dont les threads attendent le changement.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_uint word; // Valeur courante
+    atomic_uint sleepers;       // Threads endormis sur `word`
+} spin_event_t;
+
+/**
+ * Barrière à inversion de sens : le dernier des `parties` threads arrivés réarme le
+ * compteur puis inverse le sens, ce qui libère les autres. Arrivée et attente sont
+ * séparées : un thread qui n'a pas besoin d'attendre les autres (un worker du pool en
+ * fin de travail) arrive sans attendre.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_uint remaining; // Threads encore attendus
+    unsigned parties;           // Nombre de threads de la barrière
+    spin_event_t sense;         // Sens courant, inversé à chaque passage
+} spin_barrier_t;
+
+/**
+ * Mutex à trois états (0 : libre, 1 : pris, 2 : pris avec des threads endormis) :
+ * la prise tente d'abord sa chance en boucle active, la libération ne réveille un
+ * thread que dans l'état 2.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_uint state;
+} spin_mutex_t;
+
+/**
+ * Une pause dans une boucle d'attente active (`pause` sur x86, `yield` sur ARM).
+ */
+static inline void spin_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Budget d'attente active lu dans la variable d'environnement `name` (nombre de tours),
+ * sinon `def`.
+ */
+unsigned spin_budget_env(const char *name, unsigned def);
+
+void spin_event_init(spin_event_t *event, unsigned value);
+
+/**
+ * Attendre que le mot de l'événement soit différent de `seen` (au plus `spins` tours
+ * actifs avant de s'endormir) et retourner sa nouvelle valeur. Lecture en mode
+ * `acquire` : les écritures qui précèdent `spin_event_set` sont visibles.
+ */
+unsigned spin_event_wait(spin_event_t *event, unsigned seen, unsigned spins);
+
+/**
+ * Donner la valeur `value` au mot de l'événement et réveiller les threads endormis.
+ */
+void spin_event_set(spin_event_t *event, unsigned value);
+
+void spin_barrier_init(spin_barrier_t *barrier, unsigned parties);
+
+/**
+ * Arriver à la barrière sans attendre. Retourne le sens du passage, à donner à
+ * `spin_barrier_await`.
+ */
+unsigned spin_barrier_arrive(spin_barrier_t *barrier);
+
+/**
+ * Attendre la fin du passage `sense` (tous les threads arrivés).
+ */
+void spin_barrier_await(spin_barrier_t *barrier, unsigned sense, unsigned spins);
+
+/**
+ * Arriver puis attendre.
+ */
+void spin_barrier_wait(spin_barrier_t *barrier, unsigned spins);
+
+void spin_mutex_init(spin_mutex_t *mutex);
+void spin_mutex_lock(spin_mutex_t *mutex, unsigned spins);
+void spin_mutex_unlock(spin_mutex_t *mutex);
+
+#endif // SPIN_WAIT_H
@@ -0,0 +1,183 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "stream.h"
+#include "mapfile.h"
+#include "reduce.h"
+#include "alloc.h"
+#include "timer.h"
+
+// ======================== TAMPONS DOUBLES =======================================
+
+/**
+ * État partagé entre le thread de lecture et le thread de calcul : deux jeux de
+ * tampons, l'un rempli pendant que l'autre est réduit.
+ */
+typedef struct {
+    size_t nb_files;                        // Nombre de fichiers
+    int fds[STREAM_MAX_FILES];              // Descripteurs des fichiers
+    off_t offsets[STREAM_MAX_FILES];        // Début des données (après l'en-tête .npy)
+    size_t count;                           // Éléments par fichier
+    size_t chunk;                           // Éléments par bloc
+
+    double *bufs[2][STREAM_MAX_FILES];      // Tampons des deux jeux
+    size_t lens[2];                         // Éléments valides de chaque jeu (0 : fin du flux)
+    bool full[2];                           // Jeu prêt à être réduit
+
+    pthread_mutex_t lock;                   // Protège `lens` et `full`
+    pthread_cond_t cv;                      // Changement d'état d'un jeu
+} stream_t;
+
+/**
+ * Lire exactement `bytes` octets à la position `offset` (les lectures partielles sont complétées).
+ */
+static void read_full(int fd, char *buf, size_t bytes, off_t offset) {
+    while (bytes > 0) {
+        ssize_t r = pread(fd, buf, bytes, offset);
+        if (r <= 0) {
+            perror("stream_reduce: pread");
+            exit(EXIT_FAILURE);
+        }
+        buf += r;
+        bytes -= (size_t)r;
+        offset += r;
+    }
+}
+
+/**
+ * Thread de lecture : remplir les jeux de tampons à tour de rôle, puis publier un bloc vide.
+ */
+static void *reader_main(void *arg) {
+    stream_t *s = (stream_t *)arg;
+    size_t pos = 0;
+
+    for (size_t c = 0; ; ++c) {
+        int slot = c & 1;
+        size_t len = s->count - pos < s->chunk ? s->count - pos : s->chunk;
+
+        // Attendre que le calcul ait libéré ce jeu
+        pthread_mutex_lock(&s->lock);
+        while (s->full[slot]) {
+            pthread_cond_wait(&s->cv, &s->lock);
+        }
+        pthread_mutex_unlock(&s->lock);
+
+        for (size_t f = 0; f < s->nb_files; ++f) {
+            read_full(s->fds[f], (char *)s->bufs[slot][f], len * sizeof(double),
+                      s->offsets[f] + (off_t)(pos * sizeof(double)));
+        }
+        pos += len;
+
+        pthread_mutex_lock(&s->lock);
+        s->lens[slot] = len;
+        s->full[slot] = true;
+        pthread_cond_broadcast(&s->cv);
+        pthread_mutex_unlock(&s->lock);
+
+        if (len == 0) {
+            break;  // Bloc vide publié : fin du flux
+        }
+    }
+
+    return NULL;
+}
+
+// ============================ RÉDUCTION =========================================
+
+stream_result_t stream_reduce(size_t nb_files, const char *paths[], size_t chunk,
+                              stream_chunk_fn fn, void *arg) {
+    stream_result_t res = { 0.0, 0, 0, 0.0, 0.0, 0.0 };
+    stream_t s;
+    if (nb_files == 0 || nb_files > STREAM_MAX_FILES) {
+        fprintf(stderr, "stream_reduce: nombre de fichiers invalide (%zu)\n", nb_files);
+        exit(EXIT_FAILURE);
+    }
+    s.nb_files = nb_files;
+    s.chunk = chunk ? chunk : 1;
+
+    // Taille et début des données de chaque fichier (l'en-tête .npy est lu par une projection)
+    for (size_t f = 0; f < nb_files; ++f) {
+        mapped_array_t probe = mapfile_open(paths[f], MAPFILE_LAZY);
+        s.offsets[f] = (off_t)((char *)probe.data - (char *)probe.addr);
+        if (f == 0) {
+            s.count = probe.count;
+        } else if (probe.count != s.count) {
+            fprintf(stderr, "stream_reduce: %s et %s n'ont pas la même taille\n", paths[0], paths[f]);
+            exit(EXIT_FAILURE);
+        }
+        mapfile_close(&probe);
+
+        s.fds[f] = open(paths[f], O_RDONLY);
+        if (s.fds[f] < 0) {
+            perror(paths[f]);
+            exit(EXIT_FAILURE);
+        }
+        posix_fadvise(s.fds[f], 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        s.bufs[0][f] = alloc_array(s.chunk, sizeof(double));
+        s.bufs[1][f] = alloc_array(s.chunk, sizeof(double));
+    }
+    s.full[0] = s.full[1] = false;
+    pthread_mutex_init(&s.lock, NULL);
+    pthread_cond_init(&s.cv, NULL);
+
+    double t0 = timer_now();
+    pthread_t reader;
+    if (pthread_create(&reader, NULL, reader_main, &s) != 0) {
+        fprintf(stderr, "stream_reduce: impossible de créer le thread de lecture\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double error = 0.0;
+    for (size_t c = 0; ; ++c) {
+        int slot = c & 1;
+
+        // Attendre le bloc (temps non recouvert par le calcul)
+        double tw = timer_now();
+        pthread_mutex_lock(&s.lock);
+        while (!s.full[slot]) {
+            pthread_cond_wait(&s.cv, &s.lock);
+        }
+        size_t len = s.lens[slot];
+        pthread_mutex_unlock(&s.lock);
+        res.wait_s += timer_now() - tw;
+
+        if (len == 0) {
+            break;
+        }
+
+        // Réduire le bloc pendant que le thread de lecture remplit l'autre jeu
+        double tc = timer_now();
+        double e, value = fn(len, s.bufs[slot], arg);
+        two_sum(res.value, value, &res.value, &e);
+        error += e;
+        res.compute_s += timer_now() - tc;
+        res.count += len;
+        res.nb_chunks++;
+
+        // Rendre le jeu au thread de lecture
+        pthread_mutex_lock(&s.lock);
+        s.full[slot] = false;
+        pthread_cond_broadcast(&s.cv);
+        pthread_mutex_unlock(&s.lock);
+    }
+
+    pthread_join(reader, NULL);
+    res.value += error;
+    res.seconds = timer_now() - t0;
+
+    pthread_cond_destroy(&s.cv);
+    pthread_mutex_destroy(&s.lock);
+    for (size_t f = 0; f < nb_files; ++f) {
+        close(s.fds[f]);
+        alloc_free(s.bufs[0][f]);
+        alloc_free(s.bufs[1][f]);
+    }
+
+    return res;
+}
@@ -0,0 +1,41 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stddef.h>
+
+// ===================== RÉDUCTION EN FLUX (HORS MÉMOIRE) =========================
+
+/**
+ * Réduction d'un bloc de `len` éléments : `bufs[f]` contient le bloc du fichier `f`.
+ * Typiquement un noyau parallèle (`dotprod_blocks`, `norms_view`, ...) qui utilise
+ * le pool pendant que le thread de lecture remplit le tampon suivant.
+ */
+typedef double (*stream_chunk_fn)(size_t len, double *const bufs[], void *arg);
+
+/**
+ * Bilan d'une réduction en flux.
+ */
+typedef struct {
+    double value;          // Somme des résultats des blocs (compensée, dans l'ordre des blocs)
+    size_t count;          // Nombre d'éléments lus par fichier
+    size_t nb_chunks;      // Nombre de blocs traités
+    double seconds;        // Durée totale
+    double compute_s;      // Temps passé dans `fn`
+    double wait_s;         // Temps passé à attendre un bloc (lecture non recouverte)
+} stream_result_t;
+
+// Nombre maximal de fichiers lus en parallèle
+#define STREAM_MAX_FILES 4
+
+/**
+ * Lire `nb_files` fichiers float64 (bruts ou `.npy`, de même nombre d'éléments) par blocs
+ * de `chunk` éléments et appliquer `fn` à chaque bloc. Un thread dédié lit le bloc
+ * suivant par `pread` dans un second jeu de tampons pendant que `fn` réduit le bloc
+ * courant : lecture et calcul se recouvrent. Les résultats des blocs sont additionnés
+ * sans erreur (TwoSum) dans l'ordre : le résultat ne dépend que de `chunk`.
+ * En cas d'erreur de lecture, le programme s'arrête avec un message.
+ */
+stream_result_t stream_reduce(size_t nb_files, const char *paths[], size_t chunk,
+                              stream_chunk_fn fn, void *arg);
+
+#endif // STREAM_H
@@ -0,0 +1,570 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <assert.h>
+
+#include "thread_pool.h"
+#include "reduce.h"
+#include "partition.h"
+#include "placement.h"
+#include "trace.h"
+#include "spin_wait.h"
+
+// ========================= STRUCTURE DU POOL ====================================
+
+/**
+ * Contexte propre à chaque thread du pool (un par worker, plus un pour le thread appelant).
+ * Les champs froids, fixés à la création, et les champs chauds, écrits par le thread
+ * à chaque travail, sont sur des lignes de cache distinctes ; deux threads n'écrivent
+ * jamais sur la même ligne.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) thread_pool_t *pool; // Pool d'appartenance
+    size_t index;               // Rang du thread dans le pool (l'appelant est le dernier)
+    pthread_t thread;           // Identifiant du worker
+    int cpu;                    // Cœur imposé (-1 : aucun)
+    double created;             // Instant de `pthread_create` (instrumentation)
+
+    _Alignas(CACHE_LINE) unsigned seen; // Dernière génération de travail traitée
+    atomic_llong bottom;        // Fin de la file de tâches (côté propriétaire, exclue)
+
+    _Alignas(CACHE_LINE) atomic_llong top; // Début de la file (côté voleurs)
+} pool_worker_t;
+
+/**
+ * État du pool, regroupé par ligne de cache selon qui l'écrit et quand : le compteur
+ * de distribution, modifié à chaque tâche, ne partage pas sa ligne avec la description
+ * du travail que tous les threads relisent, ni avec le verrou.
+ */
+struct thread_pool {
+    // Champs froids : fixés à la création
+    size_t nb_workers;          // Nombre de workers créés (sans le thread appelant)
+    pool_worker_t *workers;     // Contextes des threads (`nb_workers + 1` cases)
+    pool_schedule_t schedule;   // Répartition des tâches
+
+    // Travail courant : écrit à la publication, seulement lu ensuite
+    _Alignas(CACHE_LINE) pool_task_fn fn; // Fonction à exécuter
+    char *args;                 // Tableau des arguments des tâches
+    size_t stride;              // Taille d'un argument en octets
+    size_t nb_tasks;            // Nombre de tâches
+    double published;           // Instant de la publication (instrumentation)
+
+    // Prochaine tâche à distribuer, seule sur sa ligne
+    _Alignas(CACHE_LINE) atomic_size_t next;
+
+    // Synchronisation (attente active bornée puis futex, voir `spin_wait.h`)
+    spin_event_t work;          // Génération du travail publié, incrémentée à chaque travail
+    spin_barrier_t done;        // Fin du travail : workers et thread appelant
+    spin_mutex_t submit;        // Sérialise les appels concurrents à `pool_run`
+    atomic_uint spin;           // Budget d'attente active (tours de boucle)
+    atomic_bool stop;           // Demande d'arrêt des workers
+
+    // Soumission asynchrone (voir `pool_async`)
+    _Alignas(CACHE_LINE) pthread_mutex_t async_lock; // Protège la file et l'état des futurs
+    pthread_cond_t async_cv;    // Réveil du thread asynchrone lorsqu'un futur est soumis
+    pthread_cond_t async_done_cv; // Réveil des threads qui attendent un futur
+    pool_future_t *async_head;  // Premier futur en attente d'exécution
+    pool_future_t *async_tail;  // Dernier futur en attente
+    pthread_t async_thread;     // Thread asynchrone, créé à la première soumission
+    bool async_started;         // Le thread asynchrone existe
+    bool async_stop;            // Demande d'arrêt du thread asynchrone
+};
+
+/**
+ * Réduction soumise par `pool_async`, suivie de la copie de ses arguments.
+ */
+struct pool_future {
+    pool_future_t *next;        // Futur suivant dans la file du pool
+    thread_pool_t *pool;        // Pool d'exécution
+    pool_async_fn fn;           // Réduction à exécuter
+    pool_callback_fn callback;  // Fonction de rappel (NULL : aucune)
+    void *user;                 // Argument de la fonction de rappel
+    double result;              // Résultat, valide une fois `done` vrai
+    atomic_bool done;           // Résultat disponible
+    bool detached;              // Libéré par le thread asynchrone à la fin du calcul
+    _Alignas(max_align_t) unsigned char args[]; // Copie des arguments de `fn`
+};
+
+// Contexte du thread courant lorsqu'il exécute des tâches d'un pool
+static _Thread_local pool_worker_t *current_worker = NULL;
+
+// ======================= EXÉCUTION DES TÂCHES ===================================
+
+/**
+ * File de tâches de Chase-Lev, réduite aux indices [top, bottom) de la tranche du thread :
+ * les tâches d'un travail sont toutes connues à la publication, seul le retrait (par le
+ * propriétaire, côté `bottom`) et le vol (par les autres, côté `top`) sont nécessaires.
+ * Retourner la prochaine tâche du propriétaire, ou -1 si sa file est vide.
+ */
+static long long deque_pop(pool_worker_t *self) {
+    long long b = atomic_load_explicit(&self->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&self->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&self->top, memory_order_relaxed);
+
+    if (t > b) {
+        // File vide : rétablir `bottom`
+        atomic_store_explicit(&self->bottom, b + 1, memory_order_relaxed);
+        return -1;
+    }
+    if (t == b) {
+        // Dernière tâche : la disputer aux voleurs
+        bool won = atomic_compare_exchange_strong_explicit(&self->top, &t, t + 1, memory_order_seq_cst,
+                                                           memory_order_relaxed);
+        atomic_store_explicit(&self->bottom, b + 1, memory_order_relaxed);
+        return won ? b : -1;
+    }
+    return b;
+}
+
+/**
+ * Voler la plus ancienne tâche de la file de `victim`. Retourne son indice, -1 si la file
+ * est vide, ou -2 si un autre thread l'a prise au même moment (la file n'est peut-être pas vide).
+ */
+static long long deque_steal(pool_worker_t *victim) {
+    long long t = atomic_load_explicit(&victim->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&victim->bottom, memory_order_acquire);
+
+    if (t >= b) {
+        return -1;
+    }
+    if (!atomic_compare_exchange_strong_explicit(&victim->top, &t, t + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return -2;
+    }
+    return t;
+}
+
+/**
+ * Vol de tâches : vider sa propre file, puis parcourir les files des autres threads
+ * (en commençant par le voisin suivant) jusqu'à ce qu'un tour complet les trouve toutes
+ * vides. Aucune tâche n'est ajoutée pendant le travail, donc une file vide le reste.
+ */
+static void run_tasks_steal(thread_pool_t *pool, pool_worker_t *self) {
+    long long i;
+    while ((i = deque_pop(self)) >= 0) {
+        pool->fn(pool->args + (size_t)i * pool->stride);
+    }
+
+    size_t nb_threads = pool->nb_workers + 1;
+    for (bool busy = true; busy; ) {
+        busy = false;
+        for (size_t k = 1; k < nb_threads; ++k) {
+            pool_worker_t *victim = &pool->workers[(self->index + k) % nb_threads];
+            while ((i = deque_steal(victim)) != -1) {
+                if (i >= 0) {
+                    pool->fn(pool->args + (size_t)i * pool->stride);
+                }
+                busy = true;
+            }
+        }
+    }
+}
+
+/**
+ * Distribuer les tâches du travail courant. En répartition dynamique, chaque thread
+ * prend la prochaine tâche libre jusqu'à épuisement, ce qui équilibre la charge sans
+ * ordonnanceur ; en répartition statique, il traite la tranche de son rang ; en vol
+ * de tâches, il commence par sa tranche puis aide les autres.
+ */
+static void run_tasks(thread_pool_t *pool, pool_worker_t *self) {
+    if (pool->schedule == POOL_STEAL) {
+        run_tasks_steal(pool, self);
+        return;
+    }
+    if (pool->schedule == POOL_STATIC) {
+        size_t start, end;
+        partition_bounds(pool->nb_tasks, pool->nb_workers + 1, self->index, &start, &end);
+        for (size_t i = start; i < end; ++i) {
+            pool->fn(pool->args + i * pool->stride);
+        }
+        return;
+    }
+
+    size_t i;
+    while ((i = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed)) < pool->nb_tasks) {
+        pool->fn(pool->args + i * pool->stride);
+    }
+}
+
+/**
+ * Boucle des workers : attendre un nouveau travail, y participer, signaler la fin.
+ */
+static void *worker_main(void *arg) {
+    pool_worker_t *self = (pool_worker_t *)arg;
+    thread_pool_t *pool = self->pool;
+    current_worker = self;
+    affinity_pin_self(self->cpu);
+    trace_thread_name("worker %zu", self->index);
+    TRACE_STOP(TRACE_SPAWN, self->created, 0);
+
+    for (;;) {
+        unsigned spins = atomic_load_explicit(&pool->spin, memory_order_relaxed);
+        self->seen = spin_event_wait(&pool->work, self->seen, spins);
+        if (atomic_load_explicit(&pool->stop, memory_order_relaxed)) {
+            break;
+        }
+        TRACE_STOP(TRACE_WAKE, pool->published, self->seen);
+
+        TRACE_START(t0);
+        run_tasks(pool, self);
+        TRACE_STOP(TRACE_COMPUTE, t0, self->seen);
+
+        // Arrivée sans attente : seul le thread appelant attend la fin du travail
+        spin_barrier_arrive(&pool->done);
+    }
+
+    return NULL;
+}
+
+// ======================= CRÉATION / DESTRUCTION =================================
+
+thread_pool_t *pool_create(size_t nb_threads) {
+    if (nb_threads == 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nb_threads = ncpu > 0 ? (size_t)ncpu : 1;
+    }
+
+    thread_pool_t *pool = aligned_alloc(CACHE_LINE, sizeof(*pool));
+    assert(pool);
+    memset(pool, 0, sizeof(*pool));
+    pool->nb_workers = nb_threads - 1;  // Le thread appelant fait office de dernier worker
+    pool->workers = aligned_alloc(CACHE_LINE, nb_threads * sizeof(pool_worker_t));
+    assert(pool->workers);
+    memset(pool->workers, 0, nb_threads * sizeof(pool_worker_t));
+
+    // Placement des threads : cœurs réservés pour ce pool (voir `affinity_reserve`) ; le
+    // cœur du dernier rang est celui du thread appelant, qui n'est placé que sur demande
+    // (`pool_pin_caller`)
+    int *cpus = malloc(nb_threads * sizeof(int));
+    assert(cpus);
+    size_t nb_cpus = affinity_reserve(nb_threads, cpus);
+    for (size_t i = 0; i < nb_threads; ++i) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        pool->workers[i].cpu = cpus[i];
+        atomic_init(&pool->workers[i].top, 0);
+        atomic_init(&pool->workers[i].bottom, 0);
+    }
+    free(cpus);
+    trace_thread_name("appelant");
+
+    // Répartition : statique par défaut lorsque les threads sont placés
+    const char *schedule = getenv("POOL_SCHEDULE");
+    if (schedule && strcmp(schedule, "static") == 0) {
+        pool->schedule = POOL_STATIC;
+    } else if (schedule && strcmp(schedule, "steal") == 0) {
+        pool->schedule = POOL_STEAL;
+    } else if (schedule && strcmp(schedule, "dynamic") == 0) {
+        pool->schedule = POOL_DYNAMIC;
+    } else {
+        pool->schedule = nb_cpus ? POOL_STATIC : POOL_DYNAMIC;
+    }
+
+    // Attente active seulement si chaque thread a son cœur : sinon, un thread qui
+    // tourne retarde celui dont il attend la fin
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned spin = ncpu > 0 && nb_threads > (size_t)ncpu ? 0 : SPIN_DEFAULT;
+    atomic_init(&pool->spin, spin_budget_env("POOL_SPIN", spin));
+    atomic_init(&pool->stop, false);
+    spin_event_init(&pool->work, 0);
+    spin_barrier_init(&pool->done, (unsigned)nb_threads);
+    spin_mutex_init(&pool->submit);
+    pthread_mutex_init(&pool->async_lock, NULL);
+    pthread_cond_init(&pool->async_cv, NULL);
+    pthread_cond_init(&pool->async_done_cv, NULL);
+    atomic_init(&pool->next, 0);
+
+    for (size_t i = 0; i < pool->nb_workers; ++i) {
+        pool->workers[i].created = TRACE_NOW();
+        int errcode = pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]);
+        assert(!errcode);
+        (void)errcode;
+    }
+
+    return pool;
+}
+
+void pool_destroy(thread_pool_t *pool) {
+    if (!pool) {
+        return;
+    }
+
+    // Les réductions asynchrones encore en file sont terminées avant l'arrêt des workers
+    pthread_mutex_lock(&pool->async_lock);
+    pool->async_stop = true;
+    pthread_cond_signal(&pool->async_cv);
+    bool async_started = pool->async_started;
+    pthread_mutex_unlock(&pool->async_lock);
+    if (async_started) {
+        pthread_join(pool->async_thread, NULL);
+    }
+
+    atomic_store_explicit(&pool->stop, true, memory_order_relaxed);
+    spin_event_set(&pool->work, atomic_load_explicit(&pool->work.word, memory_order_relaxed) + 1);
+
+    for (size_t i = 0; i < pool->nb_workers; ++i) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (size_t i = 0; i <= pool->nb_workers; ++i) {
+        affinity_release(1, &pool->workers[i].cpu);
+    }
+
+    pthread_cond_destroy(&pool->async_done_cv);
+    pthread_cond_destroy(&pool->async_cv);
+    pthread_mutex_destroy(&pool->async_lock);
+    free(pool->workers);
+    free(pool);
+}
+
+// ============================ POOL GLOBAL =======================================
+
+static thread_pool_t *global_pool = NULL;
+static pthread_once_t global_once = PTHREAD_ONCE_INIT;
+
+static void global_destroy(void) {
+    pool_destroy(global_pool);
+    global_pool = NULL;
+}
+
+static void global_init(void) {
+    size_t nb_threads = 0;
+    const char *env = getenv("POOL_THREADS");
+    if (env) {
+        nb_threads = strtoul(env, NULL, 10);
+    }
+    global_pool = pool_create(nb_threads);
+    atexit(global_destroy);
+}
+
+thread_pool_t *pool_global(void) {
+    pthread_once(&global_once, global_init);
+    return global_pool;
+}
+
+// Pool attaché au thread courant par `pool_bind` (NULL : pool global)
+static _Thread_local thread_pool_t *bound_pool = NULL;
+
+thread_pool_t *pool_current(void) {
+    return bound_pool ? bound_pool : pool_global();
+}
+
+thread_pool_t *pool_bind(thread_pool_t *pool) {
+    thread_pool_t *previous = bound_pool;
+    bound_pool = pool;
+    return previous;
+}
+
+void pool_global_resize(size_t nb_threads) {
+    pthread_once(&global_once, global_init);
+    pool_destroy(global_pool);
+    global_pool = pool_create(nb_threads);
+}
+
+void pool_pin_caller(const thread_pool_t *pool) {
+    affinity_pin_self(pool->workers[pool->nb_workers].cpu);
+}
+
+size_t pool_size(const thread_pool_t *pool) {
+    return pool->nb_workers + 1;
+}
+
+unsigned pool_spin(const thread_pool_t *pool) {
+    return atomic_load_explicit(&pool->spin, memory_order_relaxed);
+}
+
+void pool_set_spin(thread_pool_t *pool, unsigned spins) {
+    atomic_store_explicit(&pool->spin, spins, memory_order_relaxed);
+}
+
+pool_schedule_t pool_schedule(const thread_pool_t *pool) {
+    return pool->schedule;
+}
+
+const char *pool_schedule_name(pool_schedule_t schedule) {
+    switch (schedule) {
+    case POOL_DYNAMIC: return "dynamic";
+    case POOL_STATIC:  return "static";
+    case POOL_STEAL:   return "steal";
+    }
+    return "?";
+}
+
+size_t pool_worker_index(void) {
+    return current_worker ? current_worker->index : 0;
+}
+
+// ============================ SOUMISSION ========================================
+
+void pool_run(thread_pool_t *pool, size_t nb_tasks, pool_task_fn fn, void *args, size_t stride) {
+    if (nb_tasks == 0) {
+        return;
+    }
+
+    // Le thread appelant exécute ses tâches avec le dernier contexte du pool
+    pool_worker_t *caller = current_worker;
+    current_worker = &pool->workers[pool->nb_workers];
+
+    // Pas de worker ou une seule tâche : inutile de réveiller qui que ce soit
+    if (pool->nb_workers == 0 || nb_tasks == 1) {
+        TRACE_START(t0);
+        for (size_t i = 0; i < nb_tasks; ++i) {
+            fn((char *)args + i * stride);
+        }
+        TRACE_STOP(TRACE_COMPUTE, t0, 0);
+        current_worker = caller;
+        return;
+    }
+
+    unsigned spins = atomic_load_explicit(&pool->spin, memory_order_relaxed);
+    spin_mutex_lock(&pool->submit, spins);
+
+    // Publication du travail (visible des workers au changement de génération) et réveil
+    pool->fn = fn;
+    pool->args = (char *)args;
+    pool->stride = stride;
+    pool->nb_tasks = nb_tasks;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    if (pool->schedule == POOL_STEAL) {
+        // Chaque file reçoit la tranche statique de son thread
+        for (size_t w = 0; w <= pool->nb_workers; ++w) {
+            size_t start, end;
+            partition_bounds(nb_tasks, pool->nb_workers + 1, w, &start, &end);
+            atomic_store_explicit(&pool->workers[w].top, (long long)start, memory_order_relaxed);
+            atomic_store_explicit(&pool->workers[w].bottom, (long long)end, memory_order_relaxed);
+        }
+    }
+    unsigned generation = atomic_load_explicit(&pool->work.word, memory_order_relaxed) + 1;
+    pool->published = TRACE_NOW();
+    spin_event_set(&pool->work, generation);
+
+    // Le thread appelant participe au calcul
+    TRACE_START(t0);
+    run_tasks(pool, current_worker);
+    TRACE_STOP(TRACE_COMPUTE, t0, generation);
+
+    // Attente de la fin de tous les workers (barrière à inversion de sens)
+    TRACE_START(t1);
+    spin_barrier_wait(&pool->done, spins);
+    TRACE_STOP(TRACE_BARRIER, t1, generation);
+
+    spin_mutex_unlock(&pool->submit);
+    current_worker = caller;
+}
+
+// ========================= SOUMISSION ASYNCHRONE ================================
+
+/**
+ * Boucle du thread asynchrone : retirer le premier futur de la file, exécuter sa
+ * réduction (le thread est l'appelant de `pool_run`, attaché au pool pour que les noyaux
+ * l'utilisent), appeler la fonction de rappel puis publier le résultat. À l'arrêt, la
+ * file est vidée avant de sortir.
+ */
+static void *async_main(void *arg) {
+    thread_pool_t *pool = (thread_pool_t *)arg;
+    pool_bind(pool);
+    trace_thread_name("asynchrone");
+
+    pthread_mutex_lock(&pool->async_lock);
+    for (;;) {
+        while (!pool->async_head && !pool->async_stop) {
+            pthread_cond_wait(&pool->async_cv, &pool->async_lock);
+        }
+        pool_future_t *future = pool->async_head;
+        if (!future) {
+            break;
+        }
+        pool->async_head = future->next;
+        if (!pool->async_head) {
+            pool->async_tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->async_lock);
+
+        future->result = future->fn(future->args);
+        if (future->callback) {
+            future->callback(future, future->result, future->user);
+        }
+
+        pthread_mutex_lock(&pool->async_lock);
+        if (future->detached) {
+            free(future);
+        } else {
+            atomic_store_explicit(&future->done, true, memory_order_release);
+            pthread_cond_broadcast(&pool->async_done_cv);
+        }
+    }
+    pthread_mutex_unlock(&pool->async_lock);
+
+    return NULL;
+}
+
+pool_future_t *pool_async(thread_pool_t *pool, pool_async_fn fn, const void *args, size_t size,
+                          pool_callback_fn callback, void *user) {
+    pool_future_t *future = malloc(sizeof(*future) + size);
+    assert(future);
+    future->next = NULL;
+    future->pool = pool;
+    future->fn = fn;
+    future->callback = callback;
+    future->user = user;
+    future->result = 0.0;
+    future->detached = false;
+    atomic_init(&future->done, false);
+    if (size) {
+        memcpy(future->args, args, size);
+    }
+
+    pthread_mutex_lock(&pool->async_lock);
+    if (!pool->async_started) {
+        int errcode = pthread_create(&pool->async_thread, NULL, async_main, pool);
+        assert(!errcode);
+        (void)errcode;
+        pool->async_started = true;
+    }
+    if (pool->async_tail) {
+        pool->async_tail->next = future;
+    } else {
+        pool->async_head = future;
+    }
+    pool->async_tail = future;
+    pthread_cond_signal(&pool->async_cv);
+    pthread_mutex_unlock(&pool->async_lock);
+
+    return future;
+}
+
+bool pool_future_poll(const pool_future_t *future) {
+    return atomic_load_explicit(&future->done, memory_order_acquire);
+}
+
+double pool_future_wait(pool_future_t *future) {
+    if (!pool_future_poll(future)) {
+        thread_pool_t *pool = future->pool;
+        pthread_mutex_lock(&pool->async_lock);
+        while (!atomic_load_explicit(&future->done, memory_order_relaxed)) {
+            pthread_cond_wait(&pool->async_done_cv, &pool->async_lock);
+        }
+        pthread_mutex_unlock(&pool->async_lock);
+    }
+    return future->result;
+}
+
+void pool_future_free(pool_future_t *future) {
+    if (!future) {
+        return;
+    }
+    thread_pool_t *pool = future->pool;
+    pthread_mutex_lock(&pool->async_lock);
+    bool done = atomic_load_explicit(&future->done, memory_order_relaxed);
+    future->detached = !done;
+    pthread_mutex_unlock(&pool->async_lock);
+    if (done) {
+        free(future);
+    }
+}
@@ -0,0 +1,185 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ========================= POOL DE THREADS PERSISTANT ===========================
+
+/**
+ * Pool de threads réutilisable partagé par tous les noyaux de réduction.
+ * Les workers sont créés une seule fois puis attendent le travail suivant sur un
+ * événement (`spin_event_t`), et l'appelant la fin du travail sur une barrière
+ * (`spin_barrier_t`) : quelques tours d'attente active, puis un futex (voir
+ * `spin_wait.h`). Un appel ne coûte plus qu'un réveil au lieu d'une série de
+ * `pthread_create` / `pthread_join`.
+ */
+typedef struct thread_pool thread_pool_t;
+
+/**
+ * Répartition des tâches d'un travail entre les threads :
+ *  - POOL_DYNAMIC : chaque thread prend la prochaine tâche libre (équilibrage automatique) ;
+ *  - POOL_STATIC  : le thread de rang r traite toujours la même tranche contiguë de tâches
+ *    (voir `partition_bounds`), d'un appel à l'autre. Avec un placement des threads
+ *    (`POOL_AFFINITY`), chaque bloc est alors lu par le thread qui l'a initialisé,
+ *    sur son nœud NUMA ;
+ *  - POOL_STEAL   : chaque thread commence par sa tranche statique, rangée dans sa propre
+ *    file (deque de Chase-Lev) qu'il vide par un bout ; un thread qui a fini vole des
+ *    tâches par l'autre bout des files des autres. La localité du mode statique est
+ *    conservée tant que les tâches ont le même coût, et les retardataires sont soulagés
+ *    sinon (données creuses, voisins bruyants, accès NUMA distants).
+ */
+typedef enum {
+    POOL_DYNAMIC,
+    POOL_STATIC,
+    POOL_STEAL
+} pool_schedule_t;
+
+/**
+ * Signature d'une tâche : identique à celle attendue par `pthread_create`,
+ * afin que les fonctions `compute_*` existantes puissent être soumises telles quelles.
+ */
+typedef void *(*pool_task_fn)(void *arg);
+
+/**
+ * Créer un pool de `nb_threads` threads au total (le thread appelant compris).
+ * Si `nb_threads` vaut 0, on utilise le nombre de cœurs en ligne.
+ * Les workers sont placés selon `POOL_AFFINITY`, sur des cœurs réservés pour ce pool
+ * (voir `affinity_reserve`) : deux pools qui existent en même temps n'empilent pas leurs
+ * threads sur les mêmes cœurs tant qu'il en reste de libres. Le thread appelant, de rang
+ * le plus élevé, a lui aussi un cœur réservé mais n'est pas placé : il appartient au
+ * programme, qui le place par `pool_pin_caller`. La répartition vaut
+ * `POOL_SCHEDULE` (`dynamic`, `static` ou `steal`), par défaut statique si les threads
+ * sont placés et dynamique sinon. Les threads en attente d'un travail, et le thread
+ * appelant en attente de sa fin, tournent `POOL_SPIN` tours avant de s'endormir (voir
+ * `spin_wait.h`) ; par défaut SPIN_DEFAULT, ou 0 si les threads sont plus nombreux
+ * que les cœurs.
+ */
+thread_pool_t *pool_create(size_t nb_threads);
+
+/**
+ * Arrêter les workers et libérer le pool, après avoir terminé les réductions
+ * asynchrones encore en file (voir `pool_async`).
+ */
+void pool_destroy(thread_pool_t *pool);
+
+/**
+ * Pool global, créé au premier appel (une seule fois) et détruit à la sortie du programme.
+ * Sa taille vaut le nombre de cœurs en ligne, ou la variable d'environnement `POOL_THREADS`.
+ */
+thread_pool_t *pool_global(void);
+
+/**
+ * Remplacer le pool global par un pool de `nb_threads` threads (0 : nombre de cœurs).
+ * Réservé aux programmes de mesure : aucun calcul ne doit être en cours.
+ */
+void pool_global_resize(size_t nb_threads);
+
+/**
+ * Pool utilisé par les noyaux appelés depuis le thread courant : celui attaché par
+ * `pool_bind`, ou à défaut le pool global.
+ */
+thread_pool_t *pool_current(void);
+
+/**
+ * Attacher `pool` au thread courant (NULL : revenir au pool global) et retourner le pool
+ * attaché auparavant (NULL si aucun), pour le rétablir une fois les calculs terminés.
+ * Permet à une bibliothèque de faire tourner les noyaux existants sur son propre pool
+ * (voir `lib/parred.h`) ; chaque thread appelant a son propre attachement.
+ */
+thread_pool_t *pool_bind(thread_pool_t *pool);
+
+/**
+ * Placer le thread courant sur le cœur réservé au thread appelant de `pool` (sans effet
+ * sans `POOL_AFFINITY`). À appeler par les programmes dont le thread principal soumet
+ * les calculs, pour que sa part d'un travail statique soit toujours lue sur le même cœur.
+ */
+void pool_pin_caller(const thread_pool_t *pool);
+
+/**
+ * Nombre de threads du pool (thread appelant compris).
+ */
+size_t pool_size(const thread_pool_t *pool);
+
+/**
+ * Budget d'attente active du pool, en tours de boucle, et sa modification : un budget
+ * plus grand réduit la latence des petites réductions qui se suivent, au prix de cœurs
+ * occupés à attendre entre deux travaux (0 : s'endormir aussitôt).
+ */
+unsigned pool_spin(const thread_pool_t *pool);
+void pool_set_spin(thread_pool_t *pool, unsigned spins);
+
+/**
+ * Répartition des tâches utilisée par le pool.
+ */
+pool_schedule_t pool_schedule(const thread_pool_t *pool);
+
+/**
+ * Nom lisible d'une répartition (pour l'affichage).
+ */
+const char *pool_schedule_name(pool_schedule_t schedule);
+
+/**
+ * Rang du thread courant dans le pool dont il exécute une tâche, entre 0 et
+ * `pool_size(pool) - 1` (le thread appelant de `pool_run` a le rang le plus élevé).
+ * Permet d'indexer des accumulateurs par thread plutôt que par tâche. Vaut 0 hors d'une tâche.
+ */
+size_t pool_worker_index(void);
+
+/**
+ * Exécuter `fn(args + i * stride)` pour chaque tâche `i` de 0 à `nb_tasks - 1`,
+ * puis attendre la fin de toutes les tâches. Le thread appelant participe au calcul.
+ * `args` pointe typiquement vers un tableau de `ThreadData` et `stride` vaut sa taille.
+ */
+void pool_run(thread_pool_t *pool, size_t nb_tasks, pool_task_fn fn, void *args, size_t stride);
+
+// ========================= SOUMISSION ASYNCHRONE ================================
+
+/**
+ * Réduction soumise sans attendre son résultat (voir `pool_async`).
+ */
+typedef struct pool_future pool_future_t;
+
+/**
+ * Réduction complète exécutée en arrière-plan : typiquement un appel à un noyau
+ * (`dotprod_blocks`, `frobenius_view`, ...) qui utilise lui-même le pool.
+ */
+typedef double (*pool_async_fn)(void *arg);
+
+/**
+ * Fonction appelée dès que le résultat d'un futur est disponible, sur le thread
+ * asynchrone du pool, avant que `pool_future_wait` ne retourne. Elle doit être brève
+ * et ne doit ni attendre ni libérer un futur ; elle peut en soumettre d'autres.
+ */
+typedef void (*pool_callback_fn)(pool_future_t *future, double value, void *user);
+
+/**
+ * Soumettre `fn(args)` au pool et retourner immédiatement un futur. Les `size` octets de
+ * `args` sont copiés : la structure d'arguments peut être sur la pile de l'appelant, mais
+ * les données qu'elle désigne doivent rester valides jusqu'à la fin du calcul.
+ * Un thread asynchrone propre au pool, créé à la première soumission, exécute les
+ * réductions soumises une à une dans leur ordre de soumission ; tous les threads du pool
+ * y participent pendant que l'appelant poursuit son propre travail. `callback` (qui peut
+ * être NULL) reçoit le résultat avec `user`.
+ * Une réduction asynchrone ne doit pas attendre un autre futur du même pool.
+ */
+pool_future_t *pool_async(thread_pool_t *pool, pool_async_fn fn, const void *args, size_t size,
+                          pool_callback_fn callback, void *user);
+
+/**
+ * Vrai si le résultat du futur est disponible (sans attendre).
+ */
+bool pool_future_poll(const pool_future_t *future);
+
+/**
+ * Attendre le résultat du futur et le retourner. Peut être appelé plusieurs fois.
+ */
+double pool_future_wait(pool_future_t *future);
+
+/**
+ * Libérer le futur sans attendre : si le calcul n'est pas terminé, le futur est détaché
+ * et libéré à la fin du calcul (seule la fonction de rappel reçoit alors le résultat).
+ */
+void pool_future_free(pool_future_t *future);
+
+#endif // THREAD_POOL_H
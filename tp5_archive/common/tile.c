@@ -0,0 +1,75 @@
+#include <stddef.h>
+
+#include "tile.h"
+#include "partition.h"
+#include "reduce.h"
+
+static size_t ceil_div(size_t a, size_t b) {
+    return (a + b - 1) / b;
+}
+
+tile_plan_t tile_plan(size_t m, size_t n, size_t nb_threads, size_t elem_size) {
+    tile_plan_t plan = { m, n, m, n, 1, 1 };
+    if (m == 0 || n == 0) {
+        return plan;
+    }
+    if (nb_threads == 0) {
+        nb_threads = 1;
+    }
+    if (elem_size == 0) {
+        elem_size = sizeof(double);
+    }
+
+    // Nombre d'éléments par tuile visé : la moitié de L2, sans descendre sous PARTITION_MIN_CHUNK
+    size_t budget = cache_l2_size() / 2 / elem_size;
+    if (budget < PARTITION_MIN_CHUNK) {
+        budget = PARTITION_MIN_CHUNK;
+    }
+
+    // Nombre de tuiles voulu : assez pour respecter le budget, et au moins une par thread
+    // tant que les tuiles gardent une taille raisonnable
+    size_t total = m * n;
+    size_t wanted = ceil_div(total, budget);
+    size_t by_min = ceil_div(total, PARTITION_MIN_CHUNK);
+    size_t per_thread = by_min < nb_threads ? by_min : nb_threads;
+    if (wanted < per_thread) {
+        wanted = per_thread;
+    }
+
+    // D'abord découper la hauteur (tuiles de lignes entières, contiguës)...
+    plan.nb_row_tiles = wanted < m ? wanted : m;
+    plan.tile_rows = ceil_div(m, plan.nb_row_tiles);
+    plan.nb_row_tiles = ceil_div(m, plan.tile_rows);
+
+    // ... puis la largeur si les lignes ne suffisent pas (matrices larges)
+    size_t col_tiles = ceil_div(wanted, plan.nb_row_tiles);
+    if (col_tiles > 1) {
+        size_t elems_per_line = CACHE_LINE / elem_size;
+        size_t cols = ceil_div(n, col_tiles);
+        cols = ceil_div(cols, elems_per_line) * elems_per_line;  // Segments alignés sur des lignes de cache
+        plan.tile_cols = cols < n ? cols : n;
+    }
+    plan.nb_col_tiles = ceil_div(n, plan.tile_cols);
+
+    return plan;
+}
+
+size_t tile_count(const tile_plan_t *plan) {
+    if (plan->m == 0 || plan->n == 0) {
+        return 0;
+    }
+    return plan->nb_row_tiles * plan->nb_col_tiles;
+}
+
+tile_t tile_get(const tile_plan_t *plan, size_t t) {
+    size_t ti = t / plan->nb_col_tiles;
+    size_t tj = t % plan->nb_col_tiles;
+    tile_t tile;
+
+    tile.i0 = ti * plan->tile_rows;
+    tile.j0 = tj * plan->tile_cols;
+    tile.rows = plan->m - tile.i0 < plan->tile_rows ? plan->m - tile.i0 : plan->tile_rows;
+    tile.cols = plan->n - tile.j0 < plan->tile_cols ? plan->n - tile.j0 : plan->tile_cols;
+
+    return tile;
+}
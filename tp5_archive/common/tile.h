@@ -0,0 +1,49 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include <stddef.h>
+
+// ====================== DÉCOUPAGE D'UNE MATRICE EN TUILES =======================
+
+/**
+ * Tuile rectangulaire d'une matrice : lignes [i0, i0 + rows), colonnes [j0, j0 + cols).
+ */
+typedef struct {
+    size_t i0;     // Première ligne
+    size_t j0;     // Première colonne
+    size_t rows;   // Nombre de lignes
+    size_t cols;   // Nombre de colonnes
+} tile_t;
+
+/**
+ * Plan de découpage d'une matrice m x n en tuiles de même taille
+ * (les tuiles du bord droit et du bord bas peuvent être plus petites).
+ */
+typedef struct {
+    size_t m, n;            // Dimensions de la matrice
+    size_t tile_rows;       // Lignes par tuile
+    size_t tile_cols;       // Colonnes par tuile
+    size_t nb_row_tiles;    // Nombre de tuiles dans la hauteur
+    size_t nb_col_tiles;    // Nombre de tuiles dans la largeur
+} tile_plan_t;
+
+/**
+ * Choisir un découpage en tuiles d'au plus la moitié du cache L2 chacune, avec au
+ * moins `nb_threads` tuiles dès que la matrice est assez grande. Les tuiles
+ * couvrent des lignes entières tant que c'est possible (lectures contiguës) ;
+ * sinon les lignes sont aussi coupées en segments multiples d'une ligne de cache.
+ * Convient aux matrices larges (peu de lignes), hautes (beaucoup de lignes) et carrées.
+ */
+tile_plan_t tile_plan(size_t m, size_t n, size_t nb_threads, size_t elem_size);
+
+/**
+ * Nombre total de tuiles du plan.
+ */
+size_t tile_count(const tile_plan_t *plan);
+
+/**
+ * Tuile numéro `t` (parcours des tuiles ligne par ligne).
+ */
+tile_t tile_get(const tile_plan_t *plan, size_t t);
+
+#endif // TILE_H
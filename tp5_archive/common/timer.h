@@ -0,0 +1,18 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <time.h>
+
+// ============================ MESURE DU TEMPS ===================================
+
+/**
+ * Temps écoulé en secondes depuis une origine arbitraire (horloge monotone,
+ * résolution de l'ordre de la nanoseconde).
+ */
+static inline double timer_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+#endif // TIMER_H
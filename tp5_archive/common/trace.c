@@ -0,0 +1,231 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "trace.h"
+
+#ifdef TRACE_ENABLED
+
+// ========================= TAMPONS PAR THREAD ===================================
+
+/**
+ * Un événement mesuré.
+ */
+typedef struct {
+    double start;          // Début (secondes)
+    double end;            // Fin (secondes)
+    unsigned long job;     // Travail du pool concerné (0 : sans objet)
+    trace_kind_t kind;     // Nature de l'événement
+} trace_event_t;
+
+/**
+ * Tampon d'un thread : écrit par ce seul thread, lu à la sortie du programme.
+ * Les totaux couvrent tous les événements, même ceux qui n'ont pas pu être conservés.
+ */
+typedef struct trace_buffer {
+    struct trace_buffer *next;             // Tampon suivant (liste de tous les threads)
+    size_t tid;                            // Numéro d'enregistrement du thread
+    char name[32];                         // Nom affiché
+    double total[TRACE_NB_KINDS];          // Durée cumulée par nature
+    double max[TRACE_NB_KINDS];            // Durée maximale par nature
+    size_t nb[TRACE_NB_KINDS];             // Nombre d'événements par nature
+    size_t count;                          // Événements conservés
+    trace_event_t events[TRACE_MAX_EVENTS];
+} trace_buffer_t;
+
+static const char *const kind_names[TRACE_NB_KINDS] = { "spawn", "wake", "compute", "barrier", "lock_wait" };
+
+static _Thread_local trace_buffer_t *local_buffer = NULL;
+static trace_buffer_t *buffers = NULL;     // Tous les tampons, du plus récent au plus ancien
+static size_t nb_buffers = 0;
+static pthread_mutex_t buffers_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void trace_dump(void);
+
+/**
+ * Tampon du thread courant, créé et enregistré au premier événement.
+ */
+static trace_buffer_t *get_buffer(void) {
+    if (local_buffer) {
+        return local_buffer;
+    }
+    trace_buffer_t *buf = calloc(1, sizeof(*buf));
+    if (!buf) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&buffers_lock);
+    if (nb_buffers == 0) {
+        atexit(trace_dump);
+    }
+    buf->tid = nb_buffers++;
+    buf->next = buffers;
+    buffers = buf;
+    pthread_mutex_unlock(&buffers_lock);
+
+    snprintf(buf->name, sizeof(buf->name), "thread %zu", buf->tid);
+    local_buffer = buf;
+    return buf;
+}
+
+void trace_record(trace_kind_t kind, double start, double end, unsigned long job) {
+    trace_buffer_t *buf = get_buffer();
+    if (!buf) {
+        return;
+    }
+    double d = end - start;
+    buf->total[kind] += d;
+    buf->max[kind] = d > buf->max[kind] ? d : buf->max[kind];
+    buf->nb[kind]++;
+    if (buf->count < TRACE_MAX_EVENTS) {
+        buf->events[buf->count++] = (trace_event_t){ start, end, job, kind };
+    }
+}
+
+void trace_thread_name(const char *format, ...) {
+    trace_buffer_t *buf = get_buffer();
+    if (!buf) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf->name, sizeof(buf->name), format, args);
+    va_end(args);
+}
+
+// ============================== SORTIES =========================================
+
+/**
+ * Événement de calcul d'un travail, pour la mesure du déséquilibre.
+ */
+typedef struct {
+    unsigned long job;
+    double duration;
+} job_compute_t;
+
+static int compare_jobs(const void *a, const void *b) {
+    unsigned long x = ((const job_compute_t *)a)->job, y = ((const job_compute_t *)b)->job;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Déséquilibre de charge : pour chaque travail, écart entre le thread le plus lent et
+ * la moyenne des threads, rapporté au plus lent (0 : charge parfaitement répartie).
+ * Retourne la moyenne pondérée par la durée des travaux, `*nb_jobs` le nombre de travaux.
+ */
+static double imbalance(size_t *nb_jobs) {
+    size_t n = 0;
+    for (trace_buffer_t *b = buffers; b; b = b->next) {
+        n += b->count;
+    }
+    job_compute_t *jobs = malloc((n ? n : 1) * sizeof(*jobs));
+    size_t count = 0;
+    for (trace_buffer_t *b = buffers; b; b = b->next) {
+        for (size_t e = 0; e < b->count; ++e) {
+            if (b->events[e].kind == TRACE_COMPUTE && b->events[e].job != 0) {
+                jobs[count++] = (job_compute_t){ b->events[e].job, b->events[e].end - b->events[e].start };
+            }
+        }
+    }
+    qsort(jobs, count, sizeof(*jobs), compare_jobs);
+
+    double lost = 0.0, slowest = 0.0;
+    *nb_jobs = 0;
+    for (size_t i = 0; i < count; ) {
+        size_t j = i;
+        double sum = 0.0, max = 0.0;
+        for (; j < count && jobs[j].job == jobs[i].job; ++j) {
+            sum += jobs[j].duration;
+            max = jobs[j].duration > max ? jobs[j].duration : max;
+        }
+        lost += max - sum / (double)(j - i);
+        slowest += max;
+        ++*nb_jobs;
+        i = j;
+    }
+    free(jobs);
+
+    return slowest > 0.0 ? lost / slowest : 0.0;
+}
+
+/**
+ * Trace au format Chrome (événements complets « X », temps en microsecondes).
+ */
+static void write_chrome_trace(const char *path) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return;
+    }
+
+    double origin = 0.0;
+    int first = 1;
+    for (trace_buffer_t *b = buffers; b; b = b->next) {
+        for (size_t e = 0; e < b->count; ++e) {
+            if (first || b->events[e].start < origin) {
+                origin = b->events[e].start;
+                first = 0;
+            }
+        }
+    }
+
+    fprintf(out, "{\"traceEvents\": [");
+    const char *sep = "\n";
+    for (trace_buffer_t *b = buffers; b; b = b->next) {
+        fprintf(out, "%s  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %zu, "
+                     "\"args\": {\"name\": \"%s\"}}", sep, b->tid, b->name);
+        sep = ",\n";
+        for (size_t e = 0; e < b->count; ++e) {
+            const trace_event_t *ev = &b->events[e];
+            fprintf(out, ",\n  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %zu, \"ts\": %.3f, "
+                         "\"dur\": %.3f, \"args\": {\"job\": %lu}}", kind_names[ev->kind], b->tid,
+                    1e6 * (ev->start - origin), 1e6 * (ev->end - ev->start), ev->job);
+        }
+    }
+    fprintf(out, "\n], \"displayTimeUnit\": \"ns\"}\n");
+    fclose(out);
+}
+
+/**
+ * Résumé par thread sur la sortie d'erreur, puis trace détaillée si `TRACE_FILE` est définie.
+ * Appelée à la sortie du programme, lorsque plus aucun travail n'est en cours.
+ */
+static void trace_dump(void) {
+    pthread_mutex_lock(&buffers_lock);
+
+    size_t nb_jobs;
+    double lost = imbalance(&nb_jobs);
+    fprintf(stderr, "\n===== TRACE : %zu threads, %zu travaux parallèles =====\n", nb_buffers, nb_jobs);
+    fprintf(stderr, "%-12s %10s %12s %12s %12s %12s %12s %8s\n", "thread", "spawn_us", "wake_moy_us",
+            "wake_max_us", "compute_ms", "barrier_ms", "lock_ms", "locks");
+    for (size_t tid = 0; tid < nb_buffers; ++tid) {
+        for (trace_buffer_t *b = buffers; b; b = b->next) {
+            if (b->tid != tid) {
+                continue;
+            }
+            size_t nw = b->nb[TRACE_WAKE];
+            fprintf(stderr, "%-12s %10.1f %12.1f %12.1f %12.3f %12.3f %12.3f %8zu\n", b->name,
+                    1e6 * b->total[TRACE_SPAWN], nw ? 1e6 * b->total[TRACE_WAKE] / nw : 0.0,
+                    1e6 * b->max[TRACE_WAKE], 1e3 * b->total[TRACE_COMPUTE], 1e3 * b->total[TRACE_BARRIER],
+                    1e3 * b->total[TRACE_LOCK_WAIT], b->nb[TRACE_LOCK_WAIT]);
+        }
+    }
+    fprintf(stderr, "Déséquilibre moyen : %.1f %% du temps du thread le plus lent\n", 100.0 * lost);
+
+    const char *path = getenv("TRACE_FILE");
+    if (path && *path) {
+        write_chrome_trace(path);
+        fprintf(stderr, "Trace Chrome écrite dans %s\n", path);
+    }
+
+    pthread_mutex_unlock(&buffers_lock);
+}
+
+#else
+
+// Instrumentation désactivée : unité de compilation vide
+typedef int trace_disabled_t;
+
+#endif // TRACE_ENABLED
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+
+#include "timer.h"
+
+// ====================== INSTRUMENTATION DU CHEMIN CRITIQUE ======================
+
+/**
+ * Événements mesurés par thread :
+ *  - TRACE_SPAWN     : de `pthread_create` au démarrage du worker (une fois par worker) ;
+ *  - TRACE_WAKE      : de la publication d'un travail au réveil du worker ;
+ *  - TRACE_COMPUTE   : exécution des tâches d'un travail par un thread ;
+ *  - TRACE_BARRIER   : attente par l'appelant de la fin des autres threads ;
+ *  - TRACE_LOCK_WAIT : attente d'un verrou de réduction (mode `mutex`).
+ * La dispersion des TRACE_COMPUTE d'un même travail mesure le déséquilibre de charge.
+ */
+typedef enum {
+    TRACE_SPAWN,
+    TRACE_WAKE,
+    TRACE_COMPUTE,
+    TRACE_BARRIER,
+    TRACE_LOCK_WAIT,
+    TRACE_NB_KINDS
+} trace_kind_t;
+
+// Événements conservés par thread pour la trace détaillée (les totaux restent exacts au-delà)
+#define TRACE_MAX_EVENTS 65536
+
+#ifdef TRACE_ENABLED
+
+/**
+ * Enregistrer un événement [start, end] (secondes, `timer_now`) du thread courant.
+ * `job` identifie le travail du pool concerné (0 si sans objet). Au premier appel, une
+ * fonction de sortie est enregistrée : un résumé par thread est écrit sur la sortie
+ * d'erreur, et la trace complète au format Chrome (`chrome://tracing`, Perfetto)
+ * dans le fichier désigné par la variable d'environnement `TRACE_FILE`.
+ */
+void trace_record(trace_kind_t kind, double start, double end, unsigned long job);
+
+/**
+ * Nommer le thread courant dans la trace (format de `printf`, par exemple `worker %zu`).
+ */
+void trace_thread_name(const char *format, ...);
+
+#define TRACE_START(var) double var = timer_now()
+#define TRACE_STOP(kind, var, job) trace_record((kind), (var), timer_now(), (job))
+#define TRACE_NOW() timer_now()
+
+#else
+
+// Instrumentation absente à la compilation : aucun coût (construire avec `make TRACE=1`)
+#define trace_record(kind, start, end, job) ((void)0)
+#define trace_thread_name(...) ((void)0)
+#define TRACE_START(var) ((void)0)
+#define TRACE_STOP(kind, var, job) ((void)0)
+#define TRACE_NOW() 0.0
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_H
@@ -0,0 +1,108 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "thread_pool.h"
+#include "alloc.h"
+#include "args.h"
+#include "matrix.h"
+#include "cutover.h"
+#include "dotprod.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+
+// Valeurs par défaut (modifiables par `--max`/`--profile` ou `CUTOVER_MAX`/`CUTOVER_PROFILE`)
+#define N_MAX (1 << 22)      // Plus grande taille mesurée (éléments)
+#define ROW_MAX 256          // Largeur des matrices mesurées (au plus)
+
+// =========================== FONCTIONS MESURÉES ================================
+
+/**
+ * Données partagées par les mesures : deux tableaux de `N_MAX` éléments.
+ */
+typedef struct {
+    double *a;
+    double *b;
+    volatile double sink;    // Empêche le compilateur de supprimer les appels
+} TuneData;
+
+/**
+ * Matrice par lignes d'environ `n` éléments, d'au plus ROW_MAX colonnes.
+ */
+static matrix_view_t tuneMatrix(size_t n, double *base) {
+    size_t cols = n < ROW_MAX ? n : ROW_MAX;
+    return matrix_row_major(n / cols, cols, cols, base);
+}
+
+static void runDot(size_t n, void *arg) {
+    TuneData *data = (TuneData *)arg;
+    data->sink = dotprod_blocks(n, 0, data->a, data->b);
+}
+
+static void runFrobenius(size_t n, void *arg) {
+    TuneData *data = (TuneData *)arg;
+    data->sink = frobenius_view(tuneMatrix(n, data->a));
+}
+
+static void runMax(size_t n, void *arg) {
+    TuneData *data = (TuneData *)arg;
+    data->sink = max_view(tuneMatrix(n, data->a));
+}
+
+static void printSize(size_t n) {
+    if (n == SIZE_MAX) {
+        printf(" %12s", "jamais");
+    } else {
+        printf(" %12zu", n);
+    }
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Mesurer sur cette machine, pour le pool courant (`POOL_THREADS`), les tailles à
+ * partir desquelles la version vectorielle puis le pool sont plus rapides que la
+ * version précédente, pour chaque noyau de `cutover.h`, et les écrire dans le profil
+ * lu au démarrage des programmes (`CUTOVER_PROFILE`, par défaut `cutover.profile`).
+ */
+int main(int argc, char **argv) {
+    size_t n_max = arg_size(argc, argv, "max", "CUTOVER_MAX", N_MAX);
+    const char *profile = arg_string(argc, argv, "profile", "CUTOVER_PROFILE", CUTOVER_PROFILE_DEFAULT);
+    n_max = n_max < 16 ? 16 : n_max;
+    pool_pin_caller(pool_global());  // Thread principal sur le cœur réservé à l'appelant (`POOL_AFFINITY`)
+
+    TuneData data;
+    data.a = alloc_array(n_max, sizeof(double));
+    data.b = alloc_array(n_max, sizeof(double));
+    for (size_t i = 0; i < n_max; ++i) {
+        data.a[i] = (double)(i % 17) - 8.0;
+        data.b[i] = (double)(i % 13) - 6.0;
+    }
+
+    static const cutover_run_fn runs[CUTOVER_NB_KERNELS] = {
+        [CUTOVER_DOT] = runDot, [CUTOVER_FROBENIUS] = runFrobenius, [CUTOVER_MAX] = runMax,
+    };
+
+    printf("Étalonnage jusqu'à %zu éléments, %zu threads\n\n", n_max, pool_size(pool_current()));
+    printf("%-10s %12s %12s\n", "noyau", "simd dès", "pool dès");
+    for (cutover_kernel_t k = 0; k < CUTOVER_NB_KERNELS; ++k) {
+        cutover_t t = cutover_calibrate(runs[k], &data, n_max);
+        cutover_set(k, t);
+        printf("%-10s", cutover_kernel_name(k));
+        printSize(t.simd_min);
+        printSize(t.pool_min);
+        printf("\n");
+    }
+
+    int status = cutover_save(profile);
+    if (status == 0) {
+        printf("\nProfil écrit dans %s\n", profile);
+    } else {
+        fprintf(stderr, "Erreur : impossible d'écrire %s\n", profile);
+    }
+
+    alloc_free(data.b);
+    alloc_free(data.a);
+
+    return status == 0 ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "thread_pool.h"
+#include "matrix.h"
+#include "sparse.h"
+#include "dotprod.h"
+#include "frobnorm.h"
+#include "maxnorm.h"
+#include "norms.h"
+#include "parred.h"
+
+// ============================== CONTEXTE ========================================
+
+/**
+ * Contexte de calcul : le pool de threads sur lequel tournent les noyaux.
+ */
+struct parred_ctx {
+    thread_pool_t *pool;   // Pool propre au contexte
+};
+
+/**
+ * Attacher le pool du contexte au thread appelant le temps d'un appel : les noyaux
+ * utilisent `pool_current()`. Retourne l'attachement précédent, rétabli par `leave`.
+ */
+static thread_pool_t *enter(parred_ctx_t *ctx) {
+    return pool_bind(ctx ? ctx->pool : NULL);
+}
+
+static void leave(thread_pool_t *previous) {
+    pool_bind(previous);
+}
+
+/**
+ * Vue sur une matrice décrite par l'interface publique (`ld == 0` : matrice contiguë).
+ * Les noyaux ne modifient jamais la matrice : la conversion en `double *` est sûre.
+ */
+static matrix_view_t make_view(parred_layout_t layout, size_t m, size_t n, size_t ld, const double *A) {
+    if (layout == PARRED_COL_MAJOR) {
+        return matrix_col_major(m, n, ld ? ld : m, (double *)A);
+    }
+    return matrix_row_major(m, n, ld ? ld : n, (double *)A);
+}
+
+unsigned parred_version(void) {
+    return (PARRED_VERSION_MAJOR << 16) | PARRED_VERSION_MINOR;
+}
+
+parred_ctx_t *parred_create(size_t nb_threads) {
+    parred_ctx_t *ctx = malloc(sizeof(*ctx));
+    if (!ctx) {
+        return NULL;
+    }
+    ctx->pool = pool_create(nb_threads);
+    return ctx;
+}
+
+void parred_destroy(parred_ctx_t *ctx) {
+    if (!ctx) {
+        return;
+    }
+    pool_destroy(ctx->pool);
+    free(ctx);
+}
+
+size_t parred_threads(const parred_ctx_t *ctx) {
+    return pool_size(ctx ? ctx->pool : pool_global());
+}
+
+unsigned parred_spin(const parred_ctx_t *ctx) {
+    return pool_spin(ctx ? ctx->pool : pool_global());
+}
+
+void parred_set_spin(parred_ctx_t *ctx, unsigned spins) {
+    pool_set_spin(ctx ? ctx->pool : pool_global(), spins);
+}
+
+// =========================== PRODUITS SCALAIRES =================================
+
+double parred_dot(parred_ctx_t *ctx, size_t n, const double *a, const double *b) {
+    thread_pool_t *previous = enter(ctx);
+    double res = dotprod_blocks(n, 0, (double *)a, (double *)b);
+    leave(previous);
+    return res;
+}
+
+void parred_dot_batch(parred_ctx_t *ctx, size_t count, const double *const a[], const double *const b[],
+                      const size_t n[], double out[]) {
+    thread_pool_t *previous = enter(ctx);
+    dotprod_batch(count, (double *const *)a, (double *const *)b, n, out);
+    leave(previous);
+}
+
+/**
+ * Variantes typées : même enveloppe autour de `dotprod_blocks_<suffixe>`.
+ */
+#define DEFINE_PARRED_DOT(SUFFIX, ELEM_T, TOTAL_T)                                       \
+    TOTAL_T parred_dot_##SUFFIX(parred_ctx_t *ctx, size_t n, const ELEM_T *a, const ELEM_T *b) { \
+        thread_pool_t *previous = enter(ctx);                                            \
+        TOTAL_T res = dotprod_blocks_##SUFFIX(n, 0, a, b);                               \
+        leave(previous);                                                                 \
+        return res;                                                                      \
+    }
+
+DEFINE_PARRED_DOT(f32, float, double)
+DEFINE_PARRED_DOT(bf16, parred_bf16_t, double)
+DEFINE_PARRED_DOT(f16, parred_f16_t, double)
+DEFINE_PARRED_DOT(i8, int8_t, int64_t)
+
+/**
+ * Vecteur creux décrit par l'interface publique (lu seulement par les noyaux).
+ */
+static sparse_vec_t make_sparse(size_t nnz, const size_t *index, const double *value) {
+    return (sparse_vec_t){ 0, nnz, (size_t *)index, (double *)value };
+}
+
+double parred_dot_sparse_dense(parred_ctx_t *ctx, size_t nnz, const size_t *index, const double *value,
+                               const double *b) {
+    thread_pool_t *previous = enter(ctx);
+    sparse_vec_t a = make_sparse(nnz, index, value);
+    double res = dotprod_sparse_dense(&a, b);
+    leave(previous);
+    return res;
+}
+
+double parred_dot_sparse(parred_ctx_t *ctx, size_t nnz_a, const size_t *index_a, const double *value_a,
+                         size_t nnz_b, const size_t *index_b, const double *value_b) {
+    thread_pool_t *previous = enter(ctx);
+    sparse_vec_t a = make_sparse(nnz_a, index_a, value_a);
+    sparse_vec_t b = make_sparse(nnz_b, index_b, value_b);
+    double res = dotprod_sparse(&a, &b);
+    leave(previous);
+    return res;
+}
+
+// ===================== PRODUITS MATRICE-VECTEUR ET MATRICE-MATRICE ==============
+
+void parred_gemv(parred_ctx_t *ctx, size_t m, size_t n, const double *A, size_t lda, const double *x, double *y) {
+    thread_pool_t *previous = enter(ctx);
+    dotprod_gemv(m, n, A, lda ? lda : n, x, y);
+    leave(previous);
+}
+
+void parred_gemm(parred_ctx_t *ctx, size_t m, size_t n, size_t k, const double *A, size_t lda, const double *B,
+                 size_t ldb, double *C, size_t ldc) {
+    thread_pool_t *previous = enter(ctx);
+    dotprod_gemm(m, n, k, A, lda ? lda : k, B, ldb ? ldb : n, C, ldc ? ldc : n);
+    leave(previous);
+}
+
+// ================================ NORMES ========================================
+
+double parred_frobenius(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                        const double *A) {
+    thread_pool_t *previous = enter(ctx);
+    double res = frobenius_view(make_view(layout, m, n, ld, A));
+    leave(previous);
+    return res;
+}
+
+double parred_max(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld, const double *A,
+                  parred_max_loc_t *loc) {
+    thread_pool_t *previous = enter(ctx);
+    double res;
+    if (loc) {
+        max_loc_t found = max_view_loc(make_view(layout, m, n, ld, A));
+        *loc = (parred_max_loc_t){ found.value, found.i, found.j };
+        res = found.value;
+    } else {
+        res = max_view(make_view(layout, m, n, ld, A));
+    }
+    leave(previous);
+    return res;
+}
+
+parred_norms_t parred_norms(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                            const double *A) {
+    thread_pool_t *previous = enter(ctx);
+    norms_t res = norms_view(make_view(layout, m, n, ld, A));
+    leave(previous);
+    return (parred_norms_t){ res.frobenius, res.max, res.one, res.inf };
+}
+
+parred_csr_norms_t parred_norms_csr(parred_ctx_t *ctx, size_t m, size_t n, const size_t *row_ptr,
+                                    const size_t *col, const double *value) {
+    thread_pool_t *previous = enter(ctx);
+    csr_t A = { m, n, row_ptr[m], (size_t *)row_ptr, (size_t *)col, (double *)value };
+    csr_norms_t res = norms_csr(&A);
+    leave(previous);
+    return (parred_csr_norms_t){ res.frobenius, res.max, res.inf };
+}
+
+#define DEFINE_PARRED_NORMS(SUFFIX, ELEM_T)                                              \
+    parred_elem_norms_t parred_norms_##SUFFIX(parred_ctx_t *ctx, size_t count, const ELEM_T *A) { \
+        thread_pool_t *previous = enter(ctx);                                            \
+        elem_norms_t res = norms_##SUFFIX(count, A);                                     \
+        leave(previous);                                                                 \
+        return (parred_elem_norms_t){ res.frobenius, res.max };                          \
+    }
+
+DEFINE_PARRED_NORMS(f32, float)
+DEFINE_PARRED_NORMS(bf16, parred_bf16_t)
+DEFINE_PARRED_NORMS(f16, parred_f16_t)
+DEFINE_PARRED_NORMS(i8, int8_t)
+
+// ========================= SOUMISSION ASYNCHRONE ================================
+
+parred_future_t *parred_dot_async(parred_ctx_t *ctx, size_t n, const double *a, const double *b,
+                                  parred_callback_t callback, void *user) {
+    thread_pool_t *previous = enter(ctx);
+    pool_future_t *future = dotprod_blocks_async(n, 0, (double *)a, (double *)b, callback, user);
+    leave(previous);
+    return future;
+}
+
+parred_future_t *parred_frobenius_async(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                                        const double *A, parred_callback_t callback, void *user) {
+    thread_pool_t *previous = enter(ctx);
+    pool_future_t *future = frobenius_view_async(make_view(layout, m, n, ld, A), callback, user);
+    leave(previous);
+    return future;
+}
+
+parred_future_t *parred_max_async(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                                  const double *A, parred_callback_t callback, void *user) {
+    thread_pool_t *previous = enter(ctx);
+    pool_future_t *future = max_view_async(make_view(layout, m, n, ld, A), callback, user);
+    leave(previous);
+    return future;
+}
+
+int parred_future_poll(const parred_future_t *future) {
+    return pool_future_poll(future);
+}
+
+double parred_future_wait(parred_future_t *future) {
+    return pool_future_wait(future);
+}
+
+void parred_future_free(parred_future_t *future) {
+    pool_future_free(future);
+}
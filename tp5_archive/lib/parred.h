@@ -0,0 +1,272 @@
+#ifndef PARRED_H
+#define PARRED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =================== LIBPARRED : RÉDUCTIONS PARALLÈLES ==========================
+
+/**
+ * Interface publique de la bibliothèque `libparred` (statique `libparred.a` ou partagée
+ * `libparred.so`) : produits scalaires (denses ou creux), produits matrice-vecteur et
+ * matrice-matrice, et normes matricielles (denses ou CSR) calculés par les noyaux de
+ * `1_dotprod` et `2_norms`. Cet en-tête se suffit à lui-même : il n'expose que des
+ * types C standard et un contexte opaque, seuls symboles exportés par la bibliothèque.
+ *
+ * Le contexte possède son pool de threads : on le crée une fois, puis chaque appel ne
+ * coûte qu'un réveil des threads déjà créés. Un même contexte peut être partagé par
+ * plusieurs threads appelants, leurs calculs sont alors exécutés l'un après l'autre ;
+ * pour des calculs simultanés, on crée un contexte par thread appelant.
+ *
+ * Les modes des noyaux restent réglés par l'environnement, lu au premier appel :
+ * `REDUCE_MODE`, `SUM_MODE` (`compensated` : résultat indépendant du nombre de threads),
+ * `DOT_KERNEL`, `POOL_SCHEDULE` et `POOL_AFFINITY`. Avec `POOL_AFFINITY`, les workers
+ * de contextes qui existent en même temps sont placés sur des cœurs distincts tant
+ * qu'il en reste de libres ; les threads du programme client ne sont jamais placés.
+ */
+
+// Version de l'interface : la majeure change à toute rupture de compatibilité
+#define PARRED_VERSION_MAJOR 1
+#define PARRED_VERSION_MINOR 4
+
+#if defined(__GNUC__)
+#define PARRED_API __attribute__((visibility("default")))
+#else
+#define PARRED_API
+#endif
+
+/**
+ * Contexte de calcul : pool de threads et état associé.
+ */
+typedef struct parred_ctx parred_ctx_t;
+
+/**
+ * Stockage d'une matrice m x n de dimension principale `ld` :
+ *  - PARRED_ROW_MAJOR : élément (i, j) à `A[i * ld + j]`, `ld` >= n (ordre C) ;
+ *  - PARRED_COL_MAJOR : élément (i, j) à `A[i + j * ld]`, `ld` >= m (ordre Fortran).
+ * `ld == 0` désigne une matrice contiguë (n, respectivement m).
+ */
+typedef enum {
+    PARRED_ROW_MAJOR,
+    PARRED_COL_MAJOR
+} parred_layout_t;
+
+// Demi-précisions, stockées comme leurs 16 bits (bfloat16 et IEEE binary16)
+typedef uint16_t parred_bf16_t;
+typedef uint16_t parred_f16_t;
+
+/**
+ * Normes d'une matrice, calculées en une seule lecture de celle-ci.
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+    double one;         // Plus grande somme des |a_ij| d'une colonne
+    double inf;         // Plus grande somme des |a_ij| d'une ligne
+} parred_norms_t;
+
+/**
+ * Norme de Frobenius et norme max d'un tableau d'éléments (forme sans importance).
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+} parred_elem_norms_t;
+
+/**
+ * Plus grande valeur absolue et position de sa première occurrence, dans l'ordre des lignes.
+ */
+typedef struct {
+    double value;       // max |a_ij|
+    size_t i;           // Ligne
+    size_t j;           // Colonne
+} parred_max_loc_t;
+
+/**
+ * Normes d'une matrice creuse au format CSR.
+ */
+typedef struct {
+    double frobenius;   // Racine de la somme des carrés
+    double max;         // Plus grande valeur absolue
+    double inf;         // Plus grande somme des |a_ij| d'une ligne
+} parred_csr_norms_t;
+
+/**
+ * Calcul soumis sans attendre son résultat (voir `parred_dot_async`).
+ */
+typedef struct pool_future parred_future_t;
+
+/**
+ * Fonction appelée dès que le résultat d'un futur est disponible, sur un thread de la
+ * bibliothèque. Elle doit être brève et ne doit ni attendre ni libérer un futur.
+ */
+typedef void (*parred_callback_t)(parred_future_t *future, double value, void *user);
+
+// ============================== CONTEXTE ========================================
+
+/**
+ * Version de la bibliothèque chargée : `(majeure << 16) | mineure`. Un programme peut
+ * vérifier que sa majeure `PARRED_VERSION_MAJOR` est celle de la bibliothèque.
+ */
+PARRED_API unsigned parred_version(void);
+
+/**
+ * Créer un contexte de `nb_threads` threads au total, le thread appelant compris
+ * (0 : nombre de cœurs en ligne). Retourne NULL si la mémoire manque.
+ */
+PARRED_API parred_ctx_t *parred_create(size_t nb_threads);
+
+/**
+ * Arrêter les threads du contexte et le libérer (sans effet sur NULL).
+ * Aucun calcul ne doit être en cours sur ce contexte.
+ */
+PARRED_API void parred_destroy(parred_ctx_t *ctx);
+
+/**
+ * Nombre de threads du contexte.
+ */
+PARRED_API size_t parred_threads(const parred_ctx_t *ctx);
+
+/**
+ * Budget d'attente active des threads du contexte (`ctx == NULL` : pool global), en tours
+ * de boucle avant de s'endormir : plus grand, il réduit la latence des appels courts qui
+ * se suivent au prix de cœurs occupés entre deux appels ; 0 endort les threads aussitôt.
+ * Par défaut `POOL_SPIN`, ou une valeur de quelques microsecondes (0 si le contexte a
+ * plus de threads que la machine n'a de cœurs).
+ */
+PARRED_API unsigned parred_spin(const parred_ctx_t *ctx);
+PARRED_API void parred_set_spin(parred_ctx_t *ctx, unsigned spins);
+
+// =========================== PRODUITS SCALAIRES =================================
+
+// Dans toutes les fonctions qui suivent, `ctx == NULL` désigne le pool global du
+// processus (taille : `POOL_THREADS` ou nombre de cœurs), créé au premier appel.
+
+/**
+ * Produit scalaire de `a` et `b` (n éléments).
+ */
+PARRED_API double parred_dot(parred_ctx_t *ctx, size_t n, const double *a, const double *b);
+
+/**
+ * Produits scalaires d'un lot de paires, en un seul passage du pool :
+ * out[p] = a[p] . b[p] sur `n[p]` éléments, pour p de 0 à `count - 1`.
+ */
+PARRED_API void parred_dot_batch(parred_ctx_t *ctx, size_t count, const double *const a[], const double *const b[],
+                                 const size_t n[], double out[]);
+
+/**
+ * Produits scalaires en précision réduite, lus dans leur format d'origine. Les blocs
+ * sont accumulés en double (f32), en float (bf16, f16) ou en entier exact (i8).
+ */
+PARRED_API double parred_dot_f32(parred_ctx_t *ctx, size_t n, const float *a, const float *b);
+PARRED_API double parred_dot_bf16(parred_ctx_t *ctx, size_t n, const parred_bf16_t *a, const parred_bf16_t *b);
+PARRED_API double parred_dot_f16(parred_ctx_t *ctx, size_t n, const parred_f16_t *a, const parred_f16_t *b);
+PARRED_API int64_t parred_dot_i8(parred_ctx_t *ctx, size_t n, const int8_t *a, const int8_t *b);
+
+/**
+ * Produit scalaire d'un vecteur creux (`nnz` éléments `value[k]` aux indices `index[k]`,
+ * strictement croissants) et d'un vecteur dense `b`.
+ */
+PARRED_API double parred_dot_sparse_dense(parred_ctx_t *ctx, size_t nnz, const size_t *index, const double *value,
+                                          const double *b);
+
+/**
+ * Produit scalaire de deux vecteurs creux (indices strictement croissants).
+ */
+PARRED_API double parred_dot_sparse(parred_ctx_t *ctx, size_t nnz_a, const size_t *index_a, const double *value_a,
+                                    size_t nnz_b, const size_t *index_b, const double *value_b);
+
+// ===================== PRODUITS MATRICE-VECTEUR ET MATRICE-MATRICE ==============
+
+/**
+ * y = A x, pour `A` de m x n stockée par lignes (lignes distantes de `lda` >= n, 0 : n).
+ */
+PARRED_API void parred_gemv(parred_ctx_t *ctx, size_t m, size_t n, const double *A, size_t lda, const double *x,
+                            double *y);
+
+/**
+ * C = A B, pour `A` de m x k, `B` de k x n et `C` de m x n stockées par lignes
+ * (dimensions principales `lda`, `ldb`, `ldc` ; 0 : matrice contiguë).
+ */
+PARRED_API void parred_gemm(parred_ctx_t *ctx, size_t m, size_t n, size_t k, const double *A, size_t lda,
+                            const double *B, size_t ldb, double *C, size_t ldc);
+
+// ================================ NORMES ========================================
+
+/**
+ * Norme de Frobenius d'une matrice m x n.
+ */
+PARRED_API double parred_frobenius(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                                   const double *A);
+
+/**
+ * Norme max d'une matrice m x n. Si `loc` n'est pas NULL, on y écrit aussi la position
+ * de la première occurrence du maximum (même résultat quel que soit le nombre de threads).
+ */
+PARRED_API double parred_max(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                             const double *A, parred_max_loc_t *loc);
+
+/**
+ * Normes de Frobenius, max, 1 et infinie d'une matrice m x n, en une seule lecture.
+ */
+PARRED_API parred_norms_t parred_norms(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n, size_t ld,
+                                       const double *A);
+
+/**
+ * Normes d'une matrice creuse m x n au format CSR : les éléments de la ligne i sont
+ * `value[k]`, en colonne `col[k]`, pour k de `row_ptr[i]` à `row_ptr[i + 1] - 1`.
+ * Le travail est réparti par nombre d'éléments stockés, pas par ligne.
+ */
+PARRED_API parred_csr_norms_t parred_norms_csr(parred_ctx_t *ctx, size_t m, size_t n, const size_t *row_ptr,
+                                               const size_t *col, const double *value);
+
+/**
+ * Norme de Frobenius et norme max de `count` éléments en précision réduite.
+ */
+PARRED_API parred_elem_norms_t parred_norms_f32(parred_ctx_t *ctx, size_t count, const float *A);
+PARRED_API parred_elem_norms_t parred_norms_bf16(parred_ctx_t *ctx, size_t count, const parred_bf16_t *A);
+PARRED_API parred_elem_norms_t parred_norms_f16(parred_ctx_t *ctx, size_t count, const parred_f16_t *A);
+PARRED_API parred_elem_norms_t parred_norms_i8(parred_ctx_t *ctx, size_t count, const int8_t *A);
+
+// ========================= SOUMISSION ASYNCHRONE ================================
+
+/**
+ * Versions non bloquantes de `parred_dot`, `parred_frobenius` et `parred_max` : le calcul
+ * est mis en file sur le contexte et un futur est retourné aussitôt. Les calculs d'un
+ * même contexte sont exécutés un à un, dans leur ordre de soumission, par tous ses
+ * threads ; l'appelant poursuit son travail. Les données doivent rester valides jusqu'au
+ * résultat. `callback` (qui peut être NULL) reçoit le résultat avec `user`.
+ */
+PARRED_API parred_future_t *parred_dot_async(parred_ctx_t *ctx, size_t n, const double *a, const double *b,
+                                             parred_callback_t callback, void *user);
+PARRED_API parred_future_t *parred_frobenius_async(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n,
+                                                   size_t ld, const double *A, parred_callback_t callback,
+                                                   void *user);
+PARRED_API parred_future_t *parred_max_async(parred_ctx_t *ctx, parred_layout_t layout, size_t m, size_t n,
+                                             size_t ld, const double *A, parred_callback_t callback, void *user);
+
+/**
+ * Vrai (non nul) si le résultat du futur est disponible, sans attendre.
+ */
+PARRED_API int parred_future_poll(const parred_future_t *future);
+
+/**
+ * Attendre le résultat du futur et le retourner (plusieurs appels possibles).
+ */
+PARRED_API double parred_future_wait(parred_future_t *future);
+
+/**
+ * Libérer le futur : s'il n'est pas terminé, il est libéré à la fin du calcul et seule
+ * la fonction de rappel reçoit le résultat. `parred_destroy` attend les calculs en file.
+ */
+PARRED_API void parred_future_free(parred_future_t *future);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARRED_H
@@ -0,0 +1,252 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+
+#include "parred.h"
+
+// Valeurs par défaut (modifiables par `--n`/`--m`/`--calls`/`--threads`/`--spin`/`--seed`)
+#define N 1000     // Taille des vecteurs, et nombre de colonnes de la matrice
+#define M 125      // Nombre de lignes de la matrice
+#define CALLS 1000 // Nombre d'appels successifs sur le même contexte
+#define THREADS_MAX 8 // Plus grand nombre de threads tiré avec `--seed`
+
+// =========================== FONCTIONS UTILES ==================================
+
+/**
+ * Programme client de la bibliothèque : il n'utilise que `parred.h`, comme un service
+ * lié à `libparred.a` ou `libparred.so`. Lire `--name valeur` (ou `--name=valeur`).
+ */
+static size_t option(int argc, char **argv, const char *name, size_t fallback) {
+    size_t len = strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--", 2) != 0 || strncmp(argv[i] + 2, name, len) != 0) {
+            continue;
+        }
+        const char *value = argv[i] + 2 + len;
+        if (*value == '=') {
+            return strtoul(value + 1, NULL, 10);
+        }
+        if (*value == '\0' && i + 1 < argc) {
+            return strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    return fallback;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool close_to(double ref, double res, double scale, size_t count) {
+    return fabs(ref - res) <= count * DBL_EPSILON * fmax(1., scale);
+}
+
+/**
+ * Valeur tirée au hasard (`--seed`) : multiple de 1/16 dans [-8, 8], exact en simple
+ * précision comme en double.
+ */
+static double draw(void) {
+    return (double)(lrand48() % 257) / 16.0 - 8.0;
+}
+
+// =============================== MAIN ===========================================
+
+/**
+ * Créer un contexte une seule fois, puis enchaîner `calls` appels de chaque fonction
+ * sur ses threads déjà prêts ; les résultats sont comparés à des boucles séquentielles.
+ * Avec `--seed` non nul, les tailles, la forme de la matrice et le nombre de threads
+ * non imposés sont tirés au hasard, ainsi que les valeurs (signes mêlés) : une boucle
+ * sur les graines parcourt tous les noyaux de la bibliothèque sur des cas variés.
+ * Le programme se termine en échec si un résultat dépasse sa tolérance.
+ */
+int main(int argc, char **argv) {
+    size_t seed = option(argc, argv, "seed", 0);
+    bool randomized = seed != 0;
+    srand48((long)seed);
+    size_t n = option(argc, argv, "n", randomized ? 1 + (size_t)lrand48() % (2 * N) : N);
+    size_t calls = option(argc, argv, "calls", CALLS);
+    size_t threads = option(argc, argv, "threads", randomized ? 1 + (size_t)lrand48() % THREADS_MAX : 0);
+    size_t rows = option(argc, argv, "m", randomized ? 1 + (size_t)lrand48() % (2 * M) : M), cols = n;
+    size_t spin = option(argc, argv, "spin", SIZE_MAX);  // Budget d'attente active (absent : celui du contexte)
+
+    if (parred_version() >> 16 != PARRED_VERSION_MAJOR) {
+        fprintf(stderr, "Version de libparred incompatible : %u.%u\n", parred_version() >> 16,
+                parred_version() & 0xffff);
+        return EXIT_FAILURE;
+    }
+    parred_ctx_t *ctx = parred_create(threads);
+    if (!ctx) {
+        fprintf(stderr, "parred_create : mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    if (spin != SIZE_MAX) {
+        parred_set_spin(ctx, (unsigned)spin);
+    }
+
+    double *a = malloc(n * sizeof(double)), *b = malloc(n * sizeof(double));
+    double *A = malloc(rows * cols * sizeof(double));
+    float *F = malloc(rows * cols * sizeof(float));
+    if (!a || !b || !A || !F) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+
+    // Références séquentielles
+    double dot_ref = 0.0, abs_dot = 0.0, sum_sq = 0.0, max_ref = 0.0;
+    size_t max_i = 0, max_j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = randomized ? draw() : (double)(i % 17) - 8.0;
+        b[i] = randomized ? draw() : 0.5 * (double)(i % 13);
+        dot_ref += a[i] * b[i];
+        abs_dot += fabs(a[i] * b[i]);
+    }
+    for (size_t i = 0; i < rows * cols; ++i) {
+        A[i] = randomized ? draw() : (double)((i * 7919) % 255) / 16.0 - 8.0;
+        F[i] = (float)A[i];
+        sum_sq += A[i] * A[i];
+        if (fabs(A[i]) > max_ref) {
+            max_ref = fabs(A[i]);
+            max_i = i / cols;
+            max_j = i % cols;
+        }
+    }
+    double frob_ref = sqrt(sum_sq);
+
+    printf("libparred %u.%u, %zu threads (attente active %u tours), %zu appels, n = %zu, matrice %zu x %zu\n",
+           parred_version() >> 16, parred_version() & 0xffff, parred_threads(ctx), parred_spin(ctx), calls, n, rows,
+           cols);
+
+    // Appels répétés sur le même contexte : aucun thread n'est créé dans la boucle
+    bool ok = true;
+    double t0 = now();
+    for (size_t c = 0; c < calls; ++c) {
+        double dot = parred_dot(ctx, n, a, b);
+        ok = ok && close_to(dot_ref, dot, abs_dot, n);
+    }
+    double t_dot = (now() - t0) / (calls ? calls : 1);
+
+    t0 = now();
+    for (size_t c = 0; c < calls; ++c) {
+        double frob = parred_frobenius(ctx, PARRED_ROW_MAJOR, rows, cols, 0, A);
+        ok = ok && close_to(frob_ref, frob, frob_ref, rows * cols);
+    }
+    double t_frob = (now() - t0) / (calls ? calls : 1);
+
+    // Autres points d'entrée, une fois chacun
+    parred_max_loc_t loc;
+    double max = parred_max(ctx, PARRED_ROW_MAJOR, rows, cols, 0, A, &loc);
+    ok = ok && max == max_ref && loc.i == max_i && loc.j == max_j;
+
+    double max_t = parred_max(ctx, PARRED_COL_MAJOR, cols, rows, cols, A, NULL);  // Transposée
+    ok = ok && max_t == max_ref;
+
+    parred_norms_t norms = parred_norms(ctx, PARRED_ROW_MAJOR, rows, cols, 0, A);
+    ok = ok && close_to(frob_ref, norms.frobenius, frob_ref, rows * cols) && norms.max == max_ref;
+
+    parred_elem_norms_t norms_f = parred_norms_f32(ctx, rows * cols, F);
+    ok = ok && close_to(frob_ref, norms_f.frobenius, frob_ref, rows * cols) && norms_f.max == max_ref;
+
+    const double *pa[2] = { a, b }, *pb[2] = { b, b };
+    size_t lens[2] = { n, n / 2 };
+    double out[2];
+    parred_dot_batch(ctx, 2, pa, pb, lens, out);
+    ok = ok && close_to(dot_ref, out[0], abs_dot, n);
+
+    // y = A b, et le même produit vu comme C = A B pour B d'une seule colonne
+    double *y = malloc(rows * sizeof(double)), *Cy = malloc(rows * sizeof(double));
+    if (!y || !Cy) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    parred_gemv(ctx, rows, cols, A, 0, b, y);
+    parred_gemm(ctx, rows, 1, cols, A, 0, b, 1, Cy, 1);
+    for (size_t i = 0; i < rows; ++i) {
+        double ref = 0.0, abs_ref = 0.0;
+        for (size_t j = 0; j < cols; ++j) {
+            ref += A[i * cols + j] * b[j];
+            abs_ref += fabs(A[i * cols + j] * b[j]);
+        }
+        ok = ok && close_to(ref, y[i], abs_ref, cols) && close_to(ref, Cy[i], abs_ref, cols);
+    }
+    free(y);
+    free(Cy);
+
+    // Vecteurs creux : éléments d'indice multiple de 3 de `a`, de 2 de `b` ; CSR de `A`
+    size_t nnz_a = (n + 2) / 3, nnz_b = (n + 1) / 2;
+    size_t *ia = malloc(nnz_a * sizeof(size_t)), *ib = malloc(nnz_b * sizeof(size_t));
+    double *va = malloc(nnz_a * sizeof(double)), *vb = malloc(nnz_b * sizeof(double));
+    size_t *row_ptr = malloc((rows + 1) * sizeof(size_t)), *col = malloc(rows * cols * sizeof(size_t));
+    if (!ia || !ib || !va || !vb || !row_ptr || !col) {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    double sd_ref = 0.0, ss_ref = 0.0, sd_abs = 0.0;
+    for (size_t k = 0; k < nnz_a; ++k) {
+        ia[k] = 3 * k;
+        va[k] = a[3 * k];
+        sd_ref += a[3 * k] * b[3 * k];
+        sd_abs += fabs(a[3 * k] * b[3 * k]);
+        ss_ref += 3 * k % 2 == 0 ? a[3 * k] * b[3 * k] : 0.0;
+    }
+    for (size_t k = 0; k < nnz_b; ++k) {
+        ib[k] = 2 * k;
+        vb[k] = b[2 * k];
+    }
+    ok = ok && close_to(sd_ref, parred_dot_sparse_dense(ctx, nnz_a, ia, va, b), sd_abs, nnz_a);
+    ok = ok && close_to(ss_ref, parred_dot_sparse(ctx, nnz_a, ia, va, nnz_b, ib, vb), sd_abs, nnz_a);
+    for (size_t i = 0; i <= rows; ++i) {
+        row_ptr[i] = i * cols;
+    }
+    for (size_t k = 0; k < rows * cols; ++k) {
+        col[k] = k % cols;
+    }
+    parred_csr_norms_t csr = parred_norms_csr(ctx, rows, cols, row_ptr, col, A);
+    ok = ok && close_to(frob_ref, csr.frobenius, frob_ref, rows * cols) && csr.max == max_ref &&
+         close_to(norms.inf, csr.inf, norms.inf, cols);
+    free(ia);
+    free(ib);
+    free(va);
+    free(vb);
+    free(row_ptr);
+    free(col);
+
+    // Soumission sans attente : trois calculs en file, le thread appelant continue
+    parred_future_t *f_dot = parred_dot_async(ctx, n, a, b, NULL, NULL);
+    parred_future_t *f_frob = parred_frobenius_async(ctx, PARRED_ROW_MAJOR, rows, cols, 0, A, NULL, NULL);
+    parred_future_t *f_max = parred_max_async(ctx, PARRED_ROW_MAJOR, rows, cols, 0, A, NULL, NULL);
+    ok = ok && close_to(dot_ref, parred_future_wait(f_dot), abs_dot, n);
+    ok = ok && close_to(frob_ref, parred_future_wait(f_frob), frob_ref, rows * cols);
+    ok = ok && parred_future_wait(f_max) == max_ref && parred_future_poll(f_max);
+    parred_future_free(f_dot);
+    parred_future_free(f_frob);
+    parred_future_free(f_max);
+
+    // Sans contexte : pool global du processus
+    ok = ok && close_to(dot_ref, parred_dot(NULL, n, a, b), abs_dot, n);
+
+    printf("parred_dot       : %10.3f us/appel\n", 1e6 * t_dot);
+    printf("parred_frobenius : %10.3f us/appel\n", 1e6 * t_frob);
+    printf("max %g en (%zu, %zu), frobenius %.10g, norme 1 %g, norme infinie %g\n", max, loc.i, loc.j,
+           norms.frobenius, norms.one, norms.inf);
+    if (ok) {
+        printf("Résultat correct : OK\n");
+    } else {
+        printf("Erreur : différence entre les résultats supérieure au seuil\n");
+    }
+
+    free(a);
+    free(b);
+    free(A);
+    free(F);
+    parred_destroy(ctx);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}